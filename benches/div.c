@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <time.h>
+
+#include <fix64.h>
+#include <fix64/impl.h>
+
+#define COUNT 4096
+#define REPS  500
+#define RUNS  5
+
+// A loop which divides each dividend by its divisor, returning the sum so that it isn't optimised
+// away
+typedef uint64_t (*bench_loop_t)(const uint64_t *u_his, const uint64_t *u_los, const uint64_t *vs,
+    size_t count);
+
+#define BENCH_DIV_LOOP(name, func)                                                           \
+    static uint64_t bench_##name(const uint64_t *u_his, const uint64_t *u_los,              \
+        const uint64_t *vs, size_t count) {                                                  \
+        uint64_t sum = 0;                                                                    \
+        for (size_t i = 0; i < count; i++) {                                                 \
+            sum += func(u_his[i], u_los[i], vs[i]);                                          \
+        }                                                                                    \
+        return sum;                                                                          \
+    }
+
+#if FIX64_IMPL_USE_NATIVE_DIVQ
+BENCH_DIV_LOOP(divq, fix64_impl_div_u128_u64_divq)
+#endif
+BENCH_DIV_LOOP(soft, fix64_impl_div_u128_u64_soft)
+BENCH_DIV_LOOP(recip, fix64_impl_div_u128_u64_recip)
+
+// The engine selected with FIX64_DIV_ENGINE
+BENCH_DIV_LOOP(selected, fix64_impl_div_u128_u64)
+
+// The default runtime engine, i.e. divq or soft, called through the function pointer used by
+// FIX64_DIV_ENGINE_RUNTIME. The difference from the engine itself is the cost of the indirect call
+BENCH_DIV_LOOP(runtime, fix64_impl_div_u128_u64_runtime)
+
+static const struct {
+    const char *name;
+    bench_loop_t loop;
+} loops[] = {
+#if FIX64_IMPL_USE_NATIVE_DIVQ
+    { "divq", bench_divq },
+#endif
+    { "soft", bench_soft },
+    { "recip", bench_recip },
+    { "selected", bench_selected },
+    { "runtime", bench_runtime },
+};
+
+// The volatile sink stops the loops being optimised away
+static volatile uint64_t sink;
+
+// Nanoseconds per call, which is the best of a few runs to reduce noise
+static double bench(bench_loop_t loop, const uint64_t *u_his, const uint64_t *u_los,
+    const uint64_t *vs) {
+    double best = 0;
+    for (int run = 0; run < RUNS; run++) {
+        clock_t start = clock();
+        for (int rep = 0; rep < REPS; rep++) {
+            sink += loop(u_his, u_los, vs, COUNT);
+        }
+        double ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ((double)REPS * COUNT);
+        best = (run == 0 || ns < best) ? ns : best;
+    }
+    return best;
+}
+
+int main() {
+    // Divisors with random bit lengths, and dividends whose quotient fits in 64 bits
+    static uint64_t u_his[COUNT], u_los[COUNT], vs[COUNT];
+    uint64_t state = UINT64_C(0x9e3779b97f4a7c15);
+    for (size_t i = 0; i < 3 * COUNT; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        if (i % 3 == 0) {
+            vs[i / 3] = (state | (UINT64_C(1) << 63)) >> (state % 64);
+        } else if (i % 3 == 1) {
+            u_his[i / 3] = state % vs[i / 3];
+        } else {
+            u_los[i / 3] = state;
+        }
+    }
+
+    printf("selected engine: %s\n",
+        (FIX64_DIV_ENGINE == FIX64_DIV_ENGINE_DIVQ)    ? "divq"
+        : (FIX64_DIV_ENGINE == FIX64_DIV_ENGINE_SOFT)  ? "soft"
+        : (FIX64_DIV_ENGINE == FIX64_DIV_ENGINE_RECIP) ? "recip"
+                                                        : "runtime");
+    printf("%-8s %10s\n", "engine", "time (ns)");
+    for (size_t i = 0; i < sizeof(loops) / sizeof(loops[0]); i++) {
+        printf("%-8s %10.2f\n", loops[i].name, bench(loops[i].loop, u_his, u_los, vs));
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <time.h>
+
+// Calls the library's out of line functions, which can still be inlined with FIX64_ENABLE_IPO
+#undef FIX64_INLINE_MATH
+
+#include "math.h"
+
+#define COUNT 4096
+#define REPS  2000
+#define RUNS  5
+
+BENCH_MATH_FUNCS(BENCH_MATH_LOOP)
+
+const bench_loop_t bench_math_library[] = { BENCH_MATH_FUNCS(BENCH_MATH_ENTRY) };
+
+#define BENCH_MATH_NAME(func) #func,
+
+static const char *const names[] = { BENCH_MATH_FUNCS(BENCH_MATH_NAME) };
+
+// The volatile sink stops the loops being optimised away
+static volatile int64_t sink;
+
+// Nanoseconds per call, which is the best of a few runs to reduce noise
+static double bench(bench_loop_t loop, const fix64_t *xs) {
+    double best = 0;
+    for (int run = 0; run < RUNS; run++) {
+        clock_t start = clock();
+        for (int rep = 0; rep < REPS; rep++) {
+            sink += loop(xs, COUNT);
+        }
+        double ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ((double)REPS * COUNT);
+        best = (run == 0 || ns < best) ? ns : best;
+    }
+    return best;
+}
+
+int main() {
+    static fix64_t xs[COUNT];
+    uint64_t state = UINT64_C(0x9e3779b97f4a7c15);
+    for (size_t i = 0; i < COUNT; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        xs[i].repr = (int64_t)(state >> 28) + 1; // (0, 16]
+    }
+
+    printf("%-8s %12s %12s %8s\n", "function", "library (ns)", "inline (ns)", "speedup");
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        double library = bench(bench_math_library[i], xs);
+        double inl = bench(bench_math_inline[i], xs);
+        printf("%-8s %12.2f %12.2f %7.2fx\n", names[i], library, inl, library / inl);
+    }
+    return 0;
+}
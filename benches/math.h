@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <fix64.h>
+
+// The functions which are benchmarked, all with inputs in (0, 16]
+#define BENCH_MATH_FUNCS(X) X(exp) X(exp2) X(log2) X(sin) X(cos) X(tan) X(sqrt)
+
+// A loop which calls a function for each input, returning the sum so that it isn't optimised away
+typedef int64_t (*bench_loop_t)(const fix64_t *xs, size_t count);
+
+#define BENCH_MATH_LOOP(func)                                           \
+    static int64_t bench_##func(const fix64_t *xs, size_t count) {     \
+        int64_t sum = 0;                                                \
+        for (size_t i = 0; i < count; i++) {                            \
+            sum += fix64_##func(xs[i]).repr;                            \
+        }                                                               \
+        return sum;                                                     \
+    }
+
+#define BENCH_MATH_ENTRY(func) bench_##func,
+
+// The loops calling the library's out of line functions, in the order of BENCH_MATH_FUNCS
+extern const bench_loop_t bench_math_library[];
+
+// The loops calling the functions defined in the headers with FIX64_INLINE_MATH
+extern const bench_loop_t bench_math_inline[];
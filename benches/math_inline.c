@@ -0,0 +1,10 @@
+// Uses the definitions in the headers, whether or not the library was built with FIX64_INLINE_MATH
+#ifndef FIX64_INLINE_MATH
+    #define FIX64_INLINE_MATH 1
+#endif
+
+#include "math.h"
+
+BENCH_MATH_FUNCS(BENCH_MATH_LOOP)
+
+const bench_loop_t bench_math_inline[] = { BENCH_MATH_FUNCS(BENCH_MATH_ENTRY) };
@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <time.h>
+
+#include <fix64.h>
+
+#define COUNT 4096
+#define REPS  500
+#define RUNS  5
+
+// A loop which applies an operation to each pair of operands, returning the sum so that it isn't
+// optimised away
+typedef uint64_t (*bench_loop_t)(const fix64_t *lhs, const fix64_t *rhs, size_t count);
+
+#define BENCH_OP_LOOP(name, func)                                                         \
+    static uint64_t bench_##name(const fix64_t *lhs, const fix64_t *rhs, size_t count) { \
+        uint64_t sum = 0;                                                                 \
+        for (size_t i = 0; i < count; i++) {                                              \
+            sum += (uint64_t)func(lhs[i], rhs[i]).repr;                                   \
+        }                                                                                 \
+        return sum;                                                                       \
+    }
+
+BENCH_OP_LOOP(mul, fix64_mul)
+BENCH_OP_LOOP(mul_trunc, fix64_mul_trunc)
+BENCH_OP_LOOP(mul_floor, fix64_mul_floor)
+BENCH_OP_LOOP(mul_ceil, fix64_mul_ceil)
+BENCH_OP_LOOP(div, fix64_div)
+BENCH_OP_LOOP(div_trunc, fix64_div_trunc)
+BENCH_OP_LOOP(div_floor, fix64_div_floor)
+BENCH_OP_LOOP(div_ceil, fix64_div_ceil)
+
+static const struct {
+    const char *name;
+    bench_loop_t loop;
+} loops[] = {
+    { "mul", bench_mul },
+    { "mul_trunc", bench_mul_trunc },
+    { "mul_floor", bench_mul_floor },
+    { "mul_ceil", bench_mul_ceil },
+    { "div", bench_div },
+    { "div_trunc", bench_div_trunc },
+    { "div_floor", bench_div_floor },
+    { "div_ceil", bench_div_ceil },
+};
+
+// The volatile sink stops the loops being optimised away
+static volatile uint64_t sink;
+
+// Nanoseconds per call, which is the best of a few runs to reduce noise
+static double bench(bench_loop_t loop, const fix64_t *lhs, const fix64_t *rhs) {
+    double best = 0;
+    for (int run = 0; run < RUNS; run++) {
+        clock_t start = clock();
+        for (int rep = 0; rep < REPS; rep++) {
+            sink += loop(lhs, rhs, COUNT);
+        }
+        double ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ((double)REPS * COUNT);
+        best = (run == 0 || ns < best) ? ns : best;
+    }
+    return best;
+}
+
+int main() {
+    // Operands with random signs and bit lengths, so that both the rounding direction and the
+    // quotient's size vary. The divisors are odd so that they aren't 0
+    static fix64_t lhs[COUNT], rhs[COUNT];
+    uint64_t state = UINT64_C(0x9e3779b97f4a7c15);
+    for (size_t i = 0; i < 2 * COUNT; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int64_t value = (int64_t)state >> (state % 64);
+        if (i % 2 == 0) {
+            lhs[i / 2].repr = value;
+        } else {
+            rhs[i / 2].repr = value | 1;
+        }
+    }
+
+    printf("%-10s %10s\n", "function", "time (ns)");
+    for (size_t i = 0; i < sizeof(loops) / sizeof(loops[0]); i++) {
+        printf("%-10s %10.2f\n", loops[i].name, bench(loops[i].loop, lhs, rhs));
+    }
+    return 0;
+}
@@ -44,11 +44,19 @@ typedef struct {
 // clang-format on
 
 #include "fix64/arith.h"
+#include "fix64/codec.h"
 #include "fix64/cmp.h"
+#include "fix64/complex.h"
 #include "fix64/consts.h"
 #include "fix64/cvt.h"
+#include "fix64/fix128.h"
 #include "fix64/math.h"
+#include "fix64/poly.h"
+#include "fix64/qformat.h"
+#include "fix64/rand.h"
+#include "fix64/stats.h"
 #include "fix64/str.h"
+#include "fix64/vec.h"
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "fix64.h"
+
+/// C++ wrapper for fix64_t with operator overloads
+///
+/// Arithmetic operators build lightweight expression objects rather than evaluating immediately.
+/// Sums and differences of products (e.g. a * b + c * d - e) are evaluated with 128-bit
+/// intermediates, and rounded once when the expression is converted back to fixed. This is both
+/// more accurate and faster than fix64_add(fix64_mul(a, b), fix64_mul(c, d)), which rounds and
+/// shifts each product. Expressions store copies of their operands, so they can safely outlive
+/// them.
+///
+/// Arithmetic wraps on overflow like fix64_add and fix64_mul. A product of a product (e.g.
+/// a * b * c) doesn't fit in 128 bits, so the inner product is rounded first.
+namespace fix64 {
+
+class fixed;
+
+namespace detail {
+
+// Intermediate result with the same scale as a product of two fix64_t, i.e. Q63.64
+struct wide {
+    int64_t hi;
+    uint64_t lo;
+};
+
+inline wide wide_add(wide lhs, wide rhs) {
+    wide result;
+    result.lo = fix64_impl_add_i128(lhs.hi, lhs.lo, rhs.hi, rhs.lo, &result.hi);
+    return result;
+}
+
+inline wide wide_sub(wide lhs, wide rhs) {
+    wide result;
+    result.lo = fix64_impl_sub_i128(lhs.hi, lhs.lo, rhs.hi, rhs.lo, &result.hi);
+    return result;
+}
+
+// Rounds to the nearest fix64_t with halfway values rounded up, the same as fix64_mul
+inline fix64_t wide_round(wide arg) {
+    int64_t hi;
+    uint64_t lo =
+        fix64_impl_add_i128(arg.hi, arg.lo, 0, (UINT64_C(1) << (FIX64_FRAC_BITS - 1)), &hi);
+    uint64_t result = ((uint64_t)hi << (64 - FIX64_FRAC_BITS)) | (lo >> FIX64_FRAC_BITS);
+    fix64_t ret = { (int64_t)result };
+    return ret;
+}
+
+/// Base class for all expressions (CRTP), each of which provides `wide eval() const`
+template <class E>
+struct expr {
+    const E &self() const {
+        return static_cast<const E &>(*this);
+    }
+};
+
+} // namespace detail
+
+/// Signed fixed point Q31.32 value type
+class fixed : public detail::expr<fixed> {
+  public:
+    /// Zero
+    fixed() {
+        value.repr = 0;
+    }
+
+    /// Wraps a fix64_t
+    fixed(fix64_t arg) : value(arg) {}
+
+    /// Evaluates an expression with a single rounding
+    template <class E>
+    fixed(const detail::expr<E> &arg) : value(detail::wide_round(arg.self().eval())) {}
+
+    /// Creates a fixed from its underlying representation
+    static fixed from_repr(int64_t repr) {
+        fix64_t arg = { repr };
+        return fixed(arg);
+    }
+
+    /// Converts an int, saturating if it is outside of the representable range
+    static fixed from_int(int arg) {
+        return fixed(fix64_from_int(arg));
+    }
+
+    /// Converts a double, saturating if it is outside of the representable range
+    static fixed from_dbl(double arg) {
+        return fixed(fix64_from_dbl(arg));
+    }
+
+    /// Returns the underlying fix64_t
+    operator fix64_t() const {
+        return value;
+    }
+
+    /// Returns the underlying representation
+    int64_t repr() const {
+        return value.repr;
+    }
+
+    /// Converts to an int, rounding down
+    int to_int() const {
+        return fix64_to_int(value);
+    }
+
+    /// Converts to a double
+    double to_dbl() const {
+        return fix64_to_dbl(value);
+    }
+
+    detail::wide eval() const {
+        detail::wide result = { value.repr >> (64 - FIX64_FRAC_BITS),
+            (uint64_t)value.repr << FIX64_FRAC_BITS };
+        return result;
+    }
+
+    template <class E>
+    fixed &operator+=(const detail::expr<E> &rhs);
+    template <class E>
+    fixed &operator-=(const detail::expr<E> &rhs);
+    template <class E>
+    fixed &operator*=(const detail::expr<E> &rhs);
+    template <class E>
+    fixed &operator/=(const detail::expr<E> &rhs);
+
+  private:
+    fix64_t value;
+};
+
+namespace detail {
+
+/// Product of two fixed values, exact in 128 bits
+struct product : expr<product> {
+    product(fixed lhs, fixed rhs) : lhs(lhs), rhs(rhs) {}
+
+    wide eval() const {
+        wide result;
+        result.lo = fix64_impl_mul_i64_i128(lhs.repr(), rhs.repr(), &result.hi);
+        return result;
+    }
+
+    fixed lhs;
+    fixed rhs;
+};
+
+template <class L, class R>
+struct sum : expr<sum<L, R> > {
+    sum(const L &lhs, const R &rhs) : lhs(lhs), rhs(rhs) {}
+
+    wide eval() const {
+        return wide_add(lhs.eval(), rhs.eval());
+    }
+
+    L lhs;
+    R rhs;
+};
+
+template <class L, class R>
+struct difference : expr<difference<L, R> > {
+    difference(const L &lhs, const R &rhs) : lhs(lhs), rhs(rhs) {}
+
+    wide eval() const {
+        return wide_sub(lhs.eval(), rhs.eval());
+    }
+
+    L lhs;
+    R rhs;
+};
+
+template <class E>
+struct negation : expr<negation<E> > {
+    negation(const E &arg) : arg(arg) {}
+
+    wide eval() const {
+        wide zero = { 0, 0 };
+        return wide_sub(zero, arg.eval());
+    }
+
+    E arg;
+};
+
+// The operators are in the detail namespace so that they're found by argument dependent lookup for
+// all expression types
+
+template <class L, class R>
+inline detail::sum<L, R> operator+(const detail::expr<L> &lhs, const detail::expr<R> &rhs) {
+    return detail::sum<L, R>(lhs.self(), rhs.self());
+}
+
+template <class L, class R>
+inline detail::difference<L, R> operator-(
+    const detail::expr<L> &lhs, const detail::expr<R> &rhs) {
+    return detail::difference<L, R>(lhs.self(), rhs.self());
+}
+
+template <class E>
+inline detail::negation<E> operator-(const detail::expr<E> &arg) {
+    return detail::negation<E>(arg.self());
+}
+
+template <class L, class R>
+inline detail::product operator*(const detail::expr<L> &lhs, const detail::expr<R> &rhs) {
+    return detail::product(fixed(lhs.self()), fixed(rhs.self()));
+}
+
+/// Division is rounded to nearest like fix64_div
+template <class L, class R>
+inline fixed operator/(const detail::expr<L> &lhs, const detail::expr<R> &rhs) {
+    return fixed(fix64_div(fixed(lhs.self()), fixed(rhs.self())));
+}
+
+} // namespace detail
+
+/// Negates a fixed. Like the other operators this wraps, so -FIX64_MIN is FIX64_MIN rather than
+/// FIX64_MAX as with fix64_neg
+inline fixed operator-(const fixed &arg) {
+    return fixed::from_repr((int64_t)(0 - (uint64_t)arg.repr()));
+}
+
+template <class E>
+inline fixed &fixed::operator+=(const detail::expr<E> &rhs) {
+    return *this = *this + rhs;
+}
+
+template <class E>
+inline fixed &fixed::operator-=(const detail::expr<E> &rhs) {
+    return *this = *this - rhs;
+}
+
+template <class E>
+inline fixed &fixed::operator*=(const detail::expr<E> &rhs) {
+    return *this = *this * rhs;
+}
+
+template <class E>
+inline fixed &fixed::operator/=(const detail::expr<E> &rhs) {
+    return *this = *this / rhs;
+}
+
+inline bool operator==(const fixed &lhs, const fixed &rhs) {
+    return fix64_eq(lhs, rhs);
+}
+
+inline bool operator!=(const fixed &lhs, const fixed &rhs) {
+    return fix64_neq(lhs, rhs);
+}
+
+inline bool operator<(const fixed &lhs, const fixed &rhs) {
+    return fix64_lt(lhs, rhs);
+}
+
+inline bool operator>(const fixed &lhs, const fixed &rhs) {
+    return fix64_gt(lhs, rhs);
+}
+
+inline bool operator<=(const fixed &lhs, const fixed &rhs) {
+    return fix64_lte(lhs, rhs);
+}
+
+inline bool operator>=(const fixed &lhs, const fixed &rhs) {
+    return fix64_gte(lhs, rhs);
+}
+
+} // namespace fix64
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "fix64.h"
 #include "fix64/impl.h"
 
@@ -65,28 +68,25 @@ static inline fix64_t fix64_sub_sat(fix64_t lhs, fix64_t rhs) {
     return result;
 }
 
-/// Multiplication of two fix64_t numbers
-///
-/// @param lhs left hand side for the multiplication
-/// @param rhs right hand side for the multiplication
-/// @return the product of the two inputs
-static inline fix64_t fix64_mul(fix64_t lhs, fix64_t rhs) {
+// Shifts the 128-bit product of lhs and rhs right by FIX64_FRAC_BITS after adding round, so a
+// round of 0 rounds towards negative infinity and 2^FIX64_FRAC_BITS - 1 towards positive infinity
+static inline fix64_t fix64_impl_mul_shift(fix64_t lhs, fix64_t rhs, uint64_t round) {
     int64_t hi;
     uint64_t lo = fix64_impl_mul_i64_i128(lhs.repr, rhs.repr, &hi);
-    lo = fix64_impl_add_i128(hi, lo, 0, (1ull << (FIX64_FRAC_BITS - 1)), &hi); // For rounding
+    if (round) {
+        lo = fix64_impl_add_i128(hi, lo, 0, round, &hi);
+    }
     int64_t result = (hi << (64 - FIX64_FRAC_BITS)) | (lo >> FIX64_FRAC_BITS);
     return (fix64_t){ result };
 }
 
-/// Saturating multiplication of two fix64_t numbers
-///
-/// @param lhs left hand side for the multiplication
-/// @param rhs right hand side for the multiplication
-/// @return the product of the two inputs
-static inline fix64_t fix64_mul_sat(fix64_t lhs, fix64_t rhs) {
+// Saturating version of fix64_impl_mul_shift
+static inline fix64_t fix64_impl_mul_shift_sat(fix64_t lhs, fix64_t rhs, uint64_t round) {
     int64_t hi;
     uint64_t lo = fix64_impl_mul_i64_i128(lhs.repr, rhs.repr, &hi);
-    lo = fix64_impl_add_i128(hi, lo, 0, (1ull << (FIX64_FRAC_BITS - 1)), &hi); // For rounding
+    if (round) {
+        lo = fix64_impl_add_i128(hi, lo, 0, round, &hi);
+    }
     int64_t result = (hi << (64 - FIX64_FRAC_BITS)) | (lo >> FIX64_FRAC_BITS);
     if (FIX64_UNLIKELY(hi > (FIX64_MAX.repr >> FIX64_FRAC_BITS))) {
         result = FIX64_MAX.repr;
@@ -96,28 +96,128 @@ static inline fix64_t fix64_mul_sat(fix64_t lhs, fix64_t rhs) {
     return (fix64_t){ result };
 }
 
-/// Division of two fix64_t numbers. Result is rounded to the nearest representable value
+// Rounding constant for fix64_impl_mul_shift which rounds towards zero, i.e. rounds up if the
+// product is negative. A zero product is unaffected, since the constant is less than 1
+static inline uint64_t fix64_impl_mul_trunc_round(fix64_t lhs, fix64_t rhs) {
+    return (uint64_t)((lhs.repr ^ rhs.repr) >> 63) >> (64 - FIX64_FRAC_BITS);
+}
+
+/// Multiplication of two fix64_t numbers. Result is rounded to the nearest representable value,
+/// with halfway values rounded up
 ///
-/// @param lhs dividend side for the division
-/// @param rhs divisor side for the division
-/// @return the quotient of the two inputs
-static inline fix64_t fix64_div(fix64_t lhs, fix64_t rhs) {
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @return the product of the two inputs
+static inline fix64_t fix64_mul(fix64_t lhs, fix64_t rhs) {
+    return fix64_impl_mul_shift(lhs, rhs, 1ull << (FIX64_FRAC_BITS - 1));
+}
+
+/// Saturating multiplication of two fix64_t numbers. Result is rounded to the nearest
+/// representable value, with halfway values rounded up
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @return the product of the two inputs
+static inline fix64_t fix64_mul_sat(fix64_t lhs, fix64_t rhs) {
+    return fix64_impl_mul_shift_sat(lhs, rhs, 1ull << (FIX64_FRAC_BITS - 1));
+}
+
+/// Multiplication of two fix64_t numbers. Result is rounded towards zero
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @return the product of the two inputs
+static inline fix64_t fix64_mul_trunc(fix64_t lhs, fix64_t rhs) {
+    return fix64_impl_mul_shift(lhs, rhs, fix64_impl_mul_trunc_round(lhs, rhs));
+}
+
+/// Saturating multiplication of two fix64_t numbers. Result is rounded towards zero
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @return the product of the two inputs
+static inline fix64_t fix64_mul_trunc_sat(fix64_t lhs, fix64_t rhs) {
+    return fix64_impl_mul_shift_sat(lhs, rhs, fix64_impl_mul_trunc_round(lhs, rhs));
+}
+
+/// Multiplication of two fix64_t numbers. Result is rounded towards negative infinity. This is
+/// the cheapest multiplication, since the product only needs to be shifted
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @return the product of the two inputs
+static inline fix64_t fix64_mul_floor(fix64_t lhs, fix64_t rhs) {
+    return fix64_impl_mul_shift(lhs, rhs, 0);
+}
+
+/// Saturating multiplication of two fix64_t numbers. Result is rounded towards negative infinity
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @return the product of the two inputs
+static inline fix64_t fix64_mul_floor_sat(fix64_t lhs, fix64_t rhs) {
+    return fix64_impl_mul_shift_sat(lhs, rhs, 0);
+}
+
+/// Multiplication of two fix64_t numbers. Result is rounded towards positive infinity
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @return the product of the two inputs
+static inline fix64_t fix64_mul_ceil(fix64_t lhs, fix64_t rhs) {
+    return fix64_impl_mul_shift(lhs, rhs, (1ull << FIX64_FRAC_BITS) - 1);
+}
+
+/// Saturating multiplication of two fix64_t numbers. Result is rounded towards positive infinity
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @return the product of the two inputs
+static inline fix64_t fix64_mul_ceil_sat(fix64_t lhs, fix64_t rhs) {
+    return fix64_impl_mul_shift_sat(lhs, rhs, (1ull << FIX64_FRAC_BITS) - 1);
+}
+
+// Divides lhs * 2^FIX64_FRAC_BITS + adjust by rhs. The division truncates, so adjust sets the
+// rounding: moving the dividend away from zero by |rhs| / 2 rounds to nearest, and by |rhs| - 1
+// rounds away from zero
+static inline fix64_t fix64_impl_div_adjust(fix64_t lhs, fix64_t rhs, int64_t adjust) {
     int64_t hi = lhs.repr >> (64 - FIX64_FRAC_BITS);
     uint64_t lo = (uint64_t)lhs.repr << FIX64_FRAC_BITS;
+    if (adjust) {
+        lo = fix64_impl_add_i128(hi, lo, adjust >> 63, (uint64_t)adjust, &hi);
+    }
+    return (fix64_t){ fix64_impl_div_i128_i64(hi, lo, rhs.repr) };
+}
 
-    uint64_t round_lo = rhs.repr / 2;
-    int64_t round_hi = rhs.repr >> 63; // sign extend
-    if ((rhs.repr < 0) == (lhs.repr < 0)) {
-        // if signs are same -> result is positive -> add for rounding
-        lo = fix64_impl_add_i128(hi, lo, round_hi, round_lo, &hi);
-    } else {
-        // else subtract for rounding
-        lo = fix64_impl_sub_i128(hi, lo, round_hi, round_lo, &hi);
+// Saturating version of fix64_impl_div_adjust
+static inline fix64_t fix64_impl_div_adjust_sat(fix64_t lhs, fix64_t rhs, int64_t adjust) {
+    int64_t hi = lhs.repr >> (64 - FIX64_FRAC_BITS);
+    uint64_t lo = (uint64_t)lhs.repr << FIX64_FRAC_BITS;
+    if (adjust) {
+        lo = fix64_impl_add_i128(hi, lo, adjust >> 63, (uint64_t)adjust, &hi);
     }
+    return (fix64_t){ fix64_impl_div_i128_i64_sat(hi, lo, rhs.repr) };
+}
 
-    int64_t result = fix64_impl_div_i128_i64(hi, lo, rhs.repr);
+// Adjustment for fix64_impl_div_adjust which rounds to nearest, with halfway values rounded away
+// from zero. rhs / 2 has the same sign as rhs, so it's added if the quotient is positive
+static inline int64_t fix64_impl_div_round_adjust(fix64_t lhs, fix64_t rhs) {
+    return ((rhs.repr < 0) == (lhs.repr < 0)) ? rhs.repr / 2 : -(rhs.repr / 2);
+}
 
-    return (fix64_t){ (int64_t)result };
+// Adjustment for fix64_impl_div_adjust which rounds away from zero, i.e. |rhs| - 1 with the sign
+// of rhs. This is 0 for division by zero, so the saturated result only depends on lhs
+static inline int64_t fix64_impl_div_away_adjust(fix64_t rhs) {
+    return rhs.repr - (rhs.repr > 0) + (rhs.repr < 0);
+}
+
+/// Division of two fix64_t numbers. Result is rounded to the nearest representable value
+///
+/// @param lhs dividend side for the division
+/// @param rhs divisor side for the division
+/// @return the quotient of the two inputs
+static inline fix64_t fix64_div(fix64_t lhs, fix64_t rhs) {
+    return fix64_impl_div_adjust(lhs, rhs, fix64_impl_div_round_adjust(lhs, rhs));
 }
 
 /// Saturating division of two fix64_t numbers. Result is rounded to the nearest representable
@@ -127,18 +227,254 @@ static inline fix64_t fix64_div(fix64_t lhs, fix64_t rhs) {
 /// @param rhs divisor side for the division
 /// @return the quotient of the two inputs
 static inline fix64_t fix64_div_sat(fix64_t lhs, fix64_t rhs) {
-    int64_t hi = lhs.repr >> (64 - FIX64_FRAC_BITS);
-    uint64_t lo = (uint64_t)lhs.repr << FIX64_FRAC_BITS;
+    return fix64_impl_div_adjust_sat(lhs, rhs, fix64_impl_div_round_adjust(lhs, rhs));
+}
 
-    if ((rhs.repr < 0) == (lhs.repr < 0)) {
-        // if signs are same -> result is positive -> add for rounding
-        lo = fix64_impl_add_i128(hi, lo, 0, rhs.repr / 2, &hi);
-    } else {
-        // else subtract for rounding
-        lo = fix64_impl_sub_i128(hi, lo, 0, rhs.repr / 2, &hi);
+/// Division of two fix64_t numbers. Result is rounded towards zero, which is the cheapest
+/// division since the dividend doesn't need adjusting
+///
+/// @param lhs dividend side for the division
+/// @param rhs divisor side for the division
+/// @return the quotient of the two inputs
+static inline fix64_t fix64_div_trunc(fix64_t lhs, fix64_t rhs) {
+    return fix64_impl_div_adjust(lhs, rhs, 0);
+}
+
+/// Saturating division of two fix64_t numbers. Result is rounded towards zero. Division by zero
+/// is saturated depending on the sign of the dividend
+///
+/// @param lhs dividend side for the division
+/// @param rhs divisor side for the division
+/// @return the quotient of the two inputs
+static inline fix64_t fix64_div_trunc_sat(fix64_t lhs, fix64_t rhs) {
+    return fix64_impl_div_adjust_sat(lhs, rhs, 0);
+}
+
+/// Division of two fix64_t numbers. Result is rounded towards negative infinity
+///
+/// @param lhs dividend side for the division
+/// @param rhs divisor side for the division
+/// @return the quotient of the two inputs
+static inline fix64_t fix64_div_floor(fix64_t lhs, fix64_t rhs) {
+    // Negative quotients are rounded away from zero
+    int64_t adjust = ((rhs.repr < 0) != (lhs.repr < 0)) ? -fix64_impl_div_away_adjust(rhs) : 0;
+    return fix64_impl_div_adjust(lhs, rhs, adjust);
+}
+
+/// Saturating division of two fix64_t numbers. Result is rounded towards negative infinity.
+/// Division by zero is saturated depending on the sign of the dividend
+///
+/// @param lhs dividend side for the division
+/// @param rhs divisor side for the division
+/// @return the quotient of the two inputs
+static inline fix64_t fix64_div_floor_sat(fix64_t lhs, fix64_t rhs) {
+    int64_t adjust = ((rhs.repr < 0) != (lhs.repr < 0)) ? -fix64_impl_div_away_adjust(rhs) : 0;
+    return fix64_impl_div_adjust_sat(lhs, rhs, adjust);
+}
+
+/// Division of two fix64_t numbers. Result is rounded towards positive infinity
+///
+/// @param lhs dividend side for the division
+/// @param rhs divisor side for the division
+/// @return the quotient of the two inputs
+static inline fix64_t fix64_div_ceil(fix64_t lhs, fix64_t rhs) {
+    // Positive quotients are rounded away from zero
+    int64_t adjust = ((rhs.repr < 0) == (lhs.repr < 0)) ? fix64_impl_div_away_adjust(rhs) : 0;
+    return fix64_impl_div_adjust(lhs, rhs, adjust);
+}
+
+/// Saturating division of two fix64_t numbers. Result is rounded towards positive infinity.
+/// Division by zero is saturated depending on the sign of the dividend
+///
+/// @param lhs dividend side for the division
+/// @param rhs divisor side for the division
+/// @return the quotient of the two inputs
+static inline fix64_t fix64_div_ceil_sat(fix64_t lhs, fix64_t rhs) {
+    int64_t adjust = ((rhs.repr < 0) == (lhs.repr < 0)) ? fix64_impl_div_away_adjust(rhs) : 0;
+    return fix64_impl_div_adjust_sat(lhs, rhs, adjust);
+}
+
+/// Selects the engine for the 128/64-bit division used by fix64_div, fix64_recip, fix64_tan, etc.
+/// when the library is built with the runtime division engine, i.e. FIX64_DIV_ENGINE set to
+/// FIX64_DIV_ENGINE_RUNTIME. Until this is called, divq is used where it's available and soft
+/// otherwise. With any other FIX64_DIV_ENGINE the engine is fixed and this has no effect.
+///
+/// This isn't thread safe, so it should be called once before any divisions, e.g. after checking
+/// the CPU model since older x86-64 cores have a much slower divq than recent ones
+///
+/// @param engine FIX64_DIV_ENGINE_DIVQ, FIX64_DIV_ENGINE_SOFT or FIX64_DIV_ENGINE_RECIP
+/// @return 1 on success, or 0 if the engine is unknown or isn't available on this target, in which
+///         case the engine is unchanged
+int fix64_select_div_engine(int engine);
+
+/// Reciprocal of a fix64_t number, giving identical results to fix64_div_sat(FIX64_ONE, arg), i.e.
+/// rounded to the nearest representable value and saturated if it overflows.
+///
+/// With the divq division engine, including when it's chosen with fix64_select_div_engine, this
+/// is just fix64_div_sat, since divq is much faster: on an Ice Lake Xeon fix64_div_sat takes about
+/// 5 ns, and the table path below about 14 ns (27 ns without lzcnt). With the soft and recip
+/// engines, it uses a reciprocal from a small table and Newton iterations instead of a 128-bit
+/// division
+///
+/// @param arg number to take the reciprocal of
+/// @return 1 / arg
+static inline fix64_t fix64_recip(fix64_t arg) {
+    if (fix64_impl_div_engine() == FIX64_DIV_ENGINE_DIVQ) {
+        fix64_t one = { INT64_C(1) << FIX64_FRAC_BITS };
+        return fix64_div_sat(one, arg);
+    }
+
+    uint64_t sign = (uint64_t)(arg.repr >> 63);
+    uint64_t d = ((uint64_t)arg.repr ^ sign) - sign; // = |arg|
+    if (FIX64_UNLIKELY(d <= 2)) {
+        // Overflows, except 1 / -2 * FIX64_EPSILON which is exactly FIX64_MIN anyway
+        return sign ? FIX64_MIN : FIX64_MAX;
+    }
+
+    // floor((2^128 - 1) / norm) = 2^64 + v where norm = d << shift, so (2^64 + v) >> (64 - shift)
+    // is floor((2^64 - 2^-64) / d), i.e. floor(2^64 / d) or one less if d is a power of 2
+    unsigned shift = fix64_impl_clz64(d);
+    uint64_t v = fix64_impl_recip_u64(d << shift);
+    uint64_t result = (UINT64_C(1) << shift) | ((v >> 1) >> (63 - shift));
+    uint64_t rem = 0 - result * d; // = 2^64 - result * d, which is less than 2 * d
+    uint64_t mask = 0 - (uint64_t)(rem >= d);
+    result -= mask;
+    rem -= mask & d;
+
+    // Round to nearest, with halfway values rounded away from zero like fix64_div
+    result += (rem >= d - rem);
+    return (fix64_t){ (int64_t)((result ^ sign) - sign) };
+}
+
+/// Reciprocal of each element of an array of fix64_t numbers, giving identical results to
+/// fix64_recip
+///
+/// @param xs array of count numbers to take the reciprocal of
+/// @param ys array of count results, which may be the same as xs
+/// @param count the number of values
+void fix64_recip_batch(const fix64_t *xs, fix64_t *ys, size_t count);
+
+//==========================================================
+// Overflow status
+//==========================================================
+
+/// Sticky status word for the *_ovf functions. Flags are only ever set, so a loop can run with
+/// wrapping arithmetic and check the status once at the end, e.g. to recompute the rare inputs
+/// that overflowed with saturating arithmetic. Clear it by assigning 0
+typedef unsigned fix64_status_t;
+
+/// Set in a fix64_status_t when a result has wrapped
+#define FIX64_STATUS_OVERFLOW 1u
+
+/// Addition of two fix64_t numbers which wraps like fix64_add, setting FIX64_STATUS_OVERFLOW in
+/// status if the result overflowed. This doesn't branch
+///
+/// @param lhs left hand side for the addition
+/// @param rhs right hand side for the addition
+/// @param status status word which the overflow flag is ORed into
+/// @return the sum of the two inputs
+static inline fix64_t fix64_add_ovf(fix64_t lhs, fix64_t rhs, fix64_status_t *status) {
+    fix64_t result;
+    int overflow = fix64_impl_add_i64_overflow(lhs.repr, rhs.repr, &result.repr);
+    *status |= (fix64_status_t)overflow * FIX64_STATUS_OVERFLOW;
+    return result;
+}
+
+/// Subtraction of two fix64_t numbers which wraps like fix64_sub, setting FIX64_STATUS_OVERFLOW
+/// in status if the result overflowed. This doesn't branch
+///
+/// @param lhs left hand side for the subtraction
+/// @param rhs right hand side for the subtraction
+/// @param status status word which the overflow flag is ORed into
+/// @return the difference of the two inputs
+static inline fix64_t fix64_sub_ovf(fix64_t lhs, fix64_t rhs, fix64_status_t *status) {
+    fix64_t result;
+    int overflow = fix64_impl_sub_i64_underflow(lhs.repr, rhs.repr, &result.repr);
+    *status |= (fix64_status_t)overflow * FIX64_STATUS_OVERFLOW;
+    return result;
+}
+
+// Nonzero if the rounded 128-bit product of fix64_impl_mul_shift doesn't fit in a fix64_t, i.e.
+// if the bits above the result aren't all copies of its sign bit
+static inline uint64_t fix64_impl_mul_overflow(int64_t hi) {
+    return (uint64_t)(hi >> (FIX64_FRAC_BITS - 1)) ^ (uint64_t)(hi >> 63);
+}
+
+/// Multiplication of two fix64_t numbers which wraps like fix64_mul (and is rounded the same
+/// way), setting FIX64_STATUS_OVERFLOW in status if the result overflowed. This doesn't branch
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @param status status word which the overflow flag is ORed into
+/// @return the product of the two inputs
+static inline fix64_t fix64_mul_ovf(fix64_t lhs, fix64_t rhs, fix64_status_t *status) {
+    int64_t hi;
+    uint64_t lo = fix64_impl_mul_i64_i128(lhs.repr, rhs.repr, &hi);
+    lo = fix64_impl_add_i128(hi, lo, 0, (1ull << (FIX64_FRAC_BITS - 1)), &hi); // For rounding
+    int64_t result = (hi << (64 - FIX64_FRAC_BITS)) | (lo >> FIX64_FRAC_BITS);
+    *status |= (fix64_status_t)(fix64_impl_mul_overflow(hi) != 0) * FIX64_STATUS_OVERFLOW;
+    return (fix64_t){ result };
+}
+
+/// Adds two arrays of fix64_t numbers element by element with fix64_add_ovf. The overflow checks
+/// are combined and the status is only updated once, so the loop can be vectorised
+///
+/// @param lhs array of count left hand sides
+/// @param rhs array of count right hand sides
+/// @param out array of count results, which may be the same as lhs or rhs
+/// @param count the number of elements
+/// @param status status word which the overflow flag is ORed into
+static inline void fix64_add_ovf_batch(const fix64_t *lhs, const fix64_t *rhs, fix64_t *out,
+    size_t count, fix64_status_t *status) {
+    uint64_t overflow = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t x = lhs[i].repr, y = rhs[i].repr;
+        uint64_t sum = x + y;
+        // If neither of the signs match the result there was an overflow
+        overflow |= (x ^ sum) & (y ^ sum);
+        out[i].repr = (int64_t)sum;
     }
+    *status |= (fix64_status_t)(overflow >> 63) * FIX64_STATUS_OVERFLOW;
+}
 
-    int64_t result = fix64_impl_div_i128_i64_sat(hi, lo, rhs.repr);
+/// Subtracts two arrays of fix64_t numbers element by element with fix64_sub_ovf. The overflow
+/// checks are combined and the status is only updated once, so the loop can be vectorised
+///
+/// @param lhs array of count left hand sides
+/// @param rhs array of count right hand sides
+/// @param out array of count results, which may be the same as lhs or rhs
+/// @param count the number of elements
+/// @param status status word which the overflow flag is ORed into
+static inline void fix64_sub_ovf_batch(const fix64_t *lhs, const fix64_t *rhs, fix64_t *out,
+    size_t count, fix64_status_t *status) {
+    uint64_t overflow = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t x = lhs[i].repr, y = rhs[i].repr;
+        uint64_t diff = x - y;
+        // If neither result nor y have the same sign as x there was overflow
+        overflow |= (x ^ diff) & (x ^ y);
+        out[i].repr = (int64_t)diff;
+    }
+    *status |= (fix64_status_t)(overflow >> 63) * FIX64_STATUS_OVERFLOW;
+}
 
-    return (fix64_t){ (int64_t)result };
+/// Multiplies two arrays of fix64_t numbers element by element with fix64_mul_ovf. The overflow
+/// checks are combined and the status is only updated once
+///
+/// @param lhs array of count left hand sides
+/// @param rhs array of count right hand sides
+/// @param out array of count results, which may be the same as lhs or rhs
+/// @param count the number of elements
+/// @param status status word which the overflow flag is ORed into
+static inline void fix64_mul_ovf_batch(const fix64_t *lhs, const fix64_t *rhs, fix64_t *out,
+    size_t count, fix64_status_t *status) {
+    uint64_t overflow = 0;
+    for (size_t i = 0; i < count; i++) {
+        int64_t hi;
+        uint64_t lo = fix64_impl_mul_i64_i128(lhs[i].repr, rhs[i].repr, &hi);
+        lo = fix64_impl_add_i128(hi, lo, 0, (1ull << (FIX64_FRAC_BITS - 1)), &hi); // For rounding
+        overflow |= fix64_impl_mul_overflow(hi);
+        out[i].repr = (int64_t)(((uint64_t)hi << (64 - FIX64_FRAC_BITS)) | (lo >> FIX64_FRAC_BITS));
+    }
+    *status |= (fix64_status_t)(overflow != 0) * FIX64_STATUS_OVERFLOW;
 }
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fix64.h"
+
+//==========================================================
+// Binary encoding
+//==========================================================
+
+/// Maximum number of values in each encoded block
+#define FIX64_CODEC_BLOCK_SIZE 128
+/// Size of each encoded block's header in bytes
+#define FIX64_CODEC_HEADER_SIZE 27
+
+/// Struct containing the information from an encoded block's header
+typedef struct {
+    /// The number of values in the block
+    size_t count;
+    /// The total size of the block in bytes, including the header
+    size_t size;
+    /// The smallest value in the block
+    fix64_t min;
+    /// The largest value in the block
+    fix64_t max;
+} fix64_block_info_t;
+
+/// Returns the maximum number of bytes fix64_encode can write when encoding a given number of
+/// values, which is slightly more than storing the values uncompressed.
+///
+/// @param count the number of values to encode
+/// @return the maximum encoded size in bytes
+static inline size_t fix64_encode_bound(size_t count) {
+    size_t blocks = (count + FIX64_CODEC_BLOCK_SIZE - 1) / FIX64_CODEC_BLOCK_SIZE;
+    return blocks * FIX64_CODEC_HEADER_SIZE + count * sizeof(int64_t);
+}
+
+/// Encodes an array of fix64_t values into a compact binary format. This is intended for sequences
+/// where consecutive values are similar, such as time series. The values are split into blocks of
+/// up to FIX64_CODEC_BLOCK_SIZE values, and each block stores either the differences between
+/// consecutive values or the differences between consecutive differences (whichever is smaller),
+/// zigzag encoded and bit-packed with the minimum width for that block. Trailing zero bits common
+/// to all of a block's residuals (e.g. from values with reduced precision) aren't stored. Each
+/// block also has a header with the min and max values so blocks can be skipped without decoding
+/// them. The encoding is lossless and doesn't depend on the platform's endianness.
+///
+/// @param buf the buffer to write the encoded data to
+/// @param size the size of the buffer. fix64_encode_bound(count) bytes is always enough
+/// @param values the values to encode
+/// @param count the number of values to encode
+/// @return the number of bytes written, or 0 if the buffer is too small
+size_t fix64_encode(uint8_t *buf, size_t size, const fix64_t *values, size_t count);
+
+/// Decodes values previously encoded with fix64_encode. Decoding stops at the end of the buffer, if
+/// the next block doesn't fit in the remaining space in `values`, or if the next block is invalid
+/// or truncated.
+///
+/// @param values the array to write the decoded values to
+/// @param count the maximum number of values to write
+/// @param buf the encoded data
+/// @param size the size of the encoded data
+/// @param consumed the number of bytes decoded is written here, unless it is NULL
+/// @return the number of values decoded
+size_t fix64_decode(
+    fix64_t *values, size_t count, const uint8_t *buf, size_t size, size_t *consumed);
+
+/// Reads the header of an encoded block without decoding the values, so that blocks can be
+/// skipped based on their range of values. The next block starts at `buf + info->size`.
+///
+/// @param info the block's information is written here
+/// @param buf the encoded data, starting at the beginning of a block
+/// @param size the size of the encoded data
+/// @return 1 if the header is valid and the whole block is in the buffer, 0 otherwise
+int fix64_decode_block_info(fix64_block_info_t *info, const uint8_t *buf, size_t size);
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fix64.h"
+#include "fix64/impl.h"
+
+//==========================================================
+// Complex numbers
+//==========================================================
+
+/// Complex number with fix64_t real and imaginary parts
+typedef struct {
+    fix64_t re; ///< Real part
+    fix64_t im; ///< Imaginary part
+} fix64c_t;
+
+/// Creates a fix64c_t from its real and imaginary parts
+///
+/// @param re the real part
+/// @param im the imaginary part
+/// @return the complex number re + im * i
+static inline fix64c_t fix64c_make(fix64_t re, fix64_t im) {
+    fix64c_t result;
+    result.re = re;
+    result.im = im;
+    return result;
+}
+
+/// Addition of two fix64c_t numbers
+///
+/// @param lhs left hand side for the addition
+/// @param rhs right hand side for the addition
+/// @return the sum of the two inputs
+static inline fix64c_t fix64c_add(fix64c_t lhs, fix64c_t rhs) {
+    return fix64c_make(fix64_add(lhs.re, rhs.re), fix64_add(lhs.im, rhs.im));
+}
+
+/// Subtraction of two fix64c_t numbers
+///
+/// @param lhs left hand side for the subtraction
+/// @param rhs right hand side for the subtraction
+/// @return the difference of the two inputs
+static inline fix64c_t fix64c_sub(fix64c_t lhs, fix64c_t rhs) {
+    return fix64c_make(fix64_sub(lhs.re, rhs.re), fix64_sub(lhs.im, rhs.im));
+}
+
+/// Complex conjugate of a fix64c_t number
+///
+/// @param arg the complex number
+/// @return the complex conjugate of arg
+static inline fix64c_t fix64c_conj(fix64c_t arg) {
+    return fix64c_make(arg.re, fix64_neg(arg.im));
+}
+
+// Rounds a Q62.64 number to Q31.32, with halfway values rounded up like fix64_mul
+static inline fix64_t fix64c_impl_round(int64_t hi, uint64_t lo) {
+    lo = fix64_impl_add_i128(hi, lo, 0, (1ull << (FIX64_FRAC_BITS - 1)), &hi); // For rounding
+    int64_t result = (hi << (64 - FIX64_FRAC_BITS)) | (lo >> FIX64_FRAC_BITS);
+    return (fix64_t){ result };
+}
+
+/// Multiplication of two fix64c_t numbers. Each part of the result is calculated with 128-bit
+/// intermediates and rounded once, so it is more accurate than using fix64_mul for each of the
+/// products. Overflow wraps like fix64_mul
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @return the product of the two inputs
+static inline fix64c_t fix64c_mul(fix64c_t lhs, fix64c_t rhs) {
+    // Each product is in [-2^126 + 2^63, 2^126], so neither the sum nor difference can overflow
+    int64_t rr_hi, ii_hi, ri_hi, ir_hi, re_hi, im_hi;
+    uint64_t rr_lo = fix64_impl_mul_i64_i128(lhs.re.repr, rhs.re.repr, &rr_hi);
+    uint64_t ii_lo = fix64_impl_mul_i64_i128(lhs.im.repr, rhs.im.repr, &ii_hi);
+    uint64_t ri_lo = fix64_impl_mul_i64_i128(lhs.re.repr, rhs.im.repr, &ri_hi);
+    uint64_t ir_lo = fix64_impl_mul_i64_i128(lhs.im.repr, rhs.re.repr, &ir_hi);
+    uint64_t re_lo = fix64_impl_sub_i128(rr_hi, rr_lo, ii_hi, ii_lo, &re_hi);
+    uint64_t im_lo = fix64_impl_add_i128(ri_hi, ri_lo, ir_hi, ir_lo, &im_hi);
+    return fix64c_make(fix64c_impl_round(re_hi, re_lo), fix64c_impl_round(im_hi, im_lo));
+}
+
+/// Multiplication of a fix64c_t number by the complex conjugate of another, i.e.
+/// fix64c_mul(lhs, fix64c_conj(rhs)) without saturating when negating rhs.im
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication, which is conjugated
+/// @return the product of lhs and the conjugate of rhs
+static inline fix64c_t fix64c_mul_conj(fix64c_t lhs, fix64c_t rhs) {
+    // (a + bi)(c - di) = (ac + bd) + (bc - ad)i
+    int64_t rr_hi, ii_hi, ri_hi, ir_hi, re_hi, im_hi;
+    uint64_t rr_lo = fix64_impl_mul_i64_i128(lhs.re.repr, rhs.re.repr, &rr_hi);
+    uint64_t ii_lo = fix64_impl_mul_i64_i128(lhs.im.repr, rhs.im.repr, &ii_hi);
+    uint64_t ri_lo = fix64_impl_mul_i64_i128(lhs.re.repr, rhs.im.repr, &ri_hi);
+    uint64_t ir_lo = fix64_impl_mul_i64_i128(lhs.im.repr, rhs.re.repr, &ir_hi);
+    uint64_t re_lo = fix64_impl_add_i128(rr_hi, rr_lo, ii_hi, ii_lo, &re_hi);
+    uint64_t im_lo = fix64_impl_sub_i128(ir_hi, ir_lo, ri_hi, ri_lo, &im_hi);
+    return fix64c_make(fix64c_impl_round(re_hi, re_lo), fix64c_impl_round(im_hi, im_lo));
+}
+
+/// Squared magnitude (norm) of a fix64c_t number, saturating at FIX64_MAX
+///
+/// @param arg the complex number
+/// @return re^2 + im^2
+static inline fix64_t fix64c_norm(fix64c_t arg) {
+    int64_t rr_hi, ii_hi, hi;
+    uint64_t rr_lo = fix64_impl_mul_i64_i128(arg.re.repr, arg.re.repr, &rr_hi);
+    uint64_t ii_lo = fix64_impl_mul_i64_i128(arg.im.repr, arg.im.repr, &ii_hi);
+    // Both squares are at most 2^126, so the sum can't overflow
+    uint64_t lo = fix64_impl_add_i128(rr_hi, rr_lo, ii_hi, ii_lo, &hi);
+    lo = fix64_impl_add_i128(hi, lo, 0, (1ull << (FIX64_FRAC_BITS - 1)), &hi); // For rounding
+    if (FIX64_UNLIKELY(hi > (INT64_MAX >> (64 - FIX64_FRAC_BITS)))) {
+        return FIX64_MAX;
+    }
+    int64_t result = (hi << (64 - FIX64_FRAC_BITS)) | (lo >> FIX64_FRAC_BITS);
+    return (fix64_t){ result };
+}
+
+/// Magnitude (absolute value) of a fix64c_t number, saturating at FIX64_MAX. The result is
+/// correctly rounded since it is calculated with an integer square root of the exact 128-bit
+/// squared magnitude
+///
+/// @param arg the complex number
+/// @return sqrt(re^2 + im^2)
+fix64_t fix64c_abs(fix64c_t arg);
+
+/// Compares two fix64c_t values for equality
+///
+/// @param lhs left hand side for comparison
+/// @param rhs right hand side for comparison
+/// @return 1 if the values are equal, 0 otherwise
+static inline int fix64c_eq(fix64c_t lhs, fix64c_t rhs) {
+    return (lhs.re.repr == rhs.re.repr) && (lhs.im.repr == rhs.im.repr);
+}
+
+//==========================================================
+// Fast Fourier transform
+//==========================================================
+
+/// Number of twiddle factors required by a fix64_fft_plan_t for a transform of the given size
+#define FIX64_FFT_TWIDDLES(size) ((size) / 2)
+
+/// Precomputed state for FFTs of a given size. The plan can be reused for any number of
+/// transforms, and can be shared between threads
+typedef struct {
+    size_t size; ///< The number of points in the transform
+    unsigned log2_size; ///< log2(size)
+    const fix64c_t *twiddles; ///< The twiddle factors exp(-2 pi i k / size) for k < size / 2
+} fix64_fft_plan_t;
+
+/// Creates a plan for FFTs of a given size. The twiddle factors are stored in a caller provided
+/// buffer, which must outlive the plan.
+///
+/// @param plan the plan to initialise
+/// @param twiddles buffer of at least FIX64_FFT_TWIDDLES(size) elements
+/// @param size the number of points in the transform, which must be a power of 2
+/// @return 0 on success, or -1 if size isn't a power of 2
+int fix64_fft_plan_init(fix64_fft_plan_t *plan, fix64c_t *twiddles, size_t size);
+
+/// Calculates the in-place forward FFT of plan->size points using a radix-2 decimation in time
+/// algorithm, i.e. X[k] = sum(x[n] * exp(-2 pi i k n / size)).
+///
+/// To avoid overflow the transform uses block floating point: before each stage, if any part of
+/// any element is too large for the stage's growth then the whole block is scaled down by a power
+/// of 2. The true result is data * 2^exponent where exponent is the (non-negative) returned value.
+/// Inputs which are small enough aren't scaled at all, so they keep full precision.
+///
+/// @param plan a plan created by fix64_fft_plan_init
+/// @param data array of plan->size points, which is overwritten with the transform
+/// @return the block exponent of the result
+int fix64_fft(const fix64_fft_plan_t *plan, fix64c_t *data);
+
+/// Calculates the in-place inverse FFT of plan->size points, i.e.
+/// x[n] = sum(X[k] * exp(2 pi i k n / size)). The result isn't divided by size, which can be done
+/// by subtracting plan->log2_size from the returned block exponent. Otherwise the behaviour is
+/// the same as fix64_fft.
+///
+/// @param plan a plan created by fix64_fft_plan_init
+/// @param data array of plan->size points, which is overwritten with the transform
+/// @return the block exponent of the result
+int fix64_ifft(const fix64_fft_plan_t *plan, fix64c_t *data);
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fix64.h"
+#include "fix64/impl.h"
+#include "fix64/str.h"
+
+//==========================================================
+// Extended precision Q63.64 type
+//==========================================================
+
+/// Signed fixed point Q63.64 type, for intermediate results which need more range or precision than
+/// fix64_t. The value is hi + lo * 2^-64, i.e. hi is the integral part rounded down and lo is the
+/// fractional part
+typedef struct {
+    int64_t hi;
+    uint64_t lo;
+} fix128_t;
+
+/// Number of fractional bits for fix128_t
+#define FIX128_FRAC_BITS 64
+/// Number of integral bits for fix128_t (excluding sign bit)
+#define FIX128_INT_BITS  63
+/// Maximum value for a fix128_t
+#define FIX128_MAX       ((fix128_t){ INT64_MAX, UINT64_MAX })
+/// Minimum value for a fix128_t
+#define FIX128_MIN       ((fix128_t){ INT64_MIN, 0 })
+/// Smallest positive non-zero value for fix128_t
+#define FIX128_EPSILON   ((fix128_t){ 0, 1 })
+/// Zero as a fix128_t
+#define FIX128_ZERO      ((fix128_t){ 0, 0 })
+/// One as a fix128_t
+#define FIX128_ONE       ((fix128_t){ 1, 0 })
+/// One half as a fix128_t
+#define FIX128_HALF      ((fix128_t){ 0, UINT64_C(1) << 63 })
+
+//==========================================================
+// Arithmetic functions
+//==========================================================
+
+/// Negates a fix128_t number. Note: fix128_neg(FIX128_MIN) returns FIX128_MAX.
+///
+/// @param arg number to negate
+/// @return the negative of arg
+static inline fix128_t fix128_neg(fix128_t arg) {
+    if (FIX64_UNLIKELY(arg.hi == INT64_MIN && arg.lo == 0)) {
+        return FIX128_MAX;
+    }
+    fix128_t result;
+    result.lo = fix64_impl_sub_i128(0, 0, arg.hi, arg.lo, &result.hi);
+    return result;
+}
+
+/// Absolute value of a fix128_t number. Note: fix128_abs(FIX128_MIN) returns FIX128_MAX.
+///
+/// @param arg number to find the absolute value of
+/// @return the absolute value of arg
+static inline fix128_t fix128_abs(fix128_t arg) {
+    return (arg.hi < 0) ? fix128_neg(arg) : arg;
+}
+
+/// Addition of two fix128_t numbers
+///
+/// @param lhs left hand side for the addition
+/// @param rhs right hand side for the addition
+/// @return the sum of the two inputs
+static inline fix128_t fix128_add(fix128_t lhs, fix128_t rhs) {
+    fix128_t result;
+    result.lo = fix64_impl_add_i128(lhs.hi, lhs.lo, rhs.hi, rhs.lo, &result.hi);
+    return result;
+}
+
+/// Saturating addition of two fix128_t numbers
+///
+/// @param lhs left hand side for the addition
+/// @param rhs right hand side for the addition
+/// @return the sum of the two inputs
+static inline fix128_t fix128_add_sat(fix128_t lhs, fix128_t rhs) {
+    fix128_t result = fix128_add(lhs, rhs);
+    // Overflow if both inputs have the same sign, and the sign of the result is different
+    if (FIX64_UNLIKELY(((lhs.hi ^ result.hi) & (rhs.hi ^ result.hi)) < 0)) {
+        result = (rhs.hi < 0) ? FIX128_MIN : FIX128_MAX;
+    }
+    return result;
+}
+
+/// Subtraction of two fix128_t numbers
+///
+/// @param lhs left hand side for the subtraction
+/// @param rhs right hand side for the subtraction
+/// @return the difference of the two inputs
+static inline fix128_t fix128_sub(fix128_t lhs, fix128_t rhs) {
+    fix128_t result;
+    result.lo = fix64_impl_sub_i128(lhs.hi, lhs.lo, rhs.hi, rhs.lo, &result.hi);
+    return result;
+}
+
+/// Saturating subtraction of two fix128_t numbers
+///
+/// @param lhs left hand side for the subtraction
+/// @param rhs right hand side for the subtraction
+/// @return the difference of the two inputs
+static inline fix128_t fix128_sub_sat(fix128_t lhs, fix128_t rhs) {
+    fix128_t result = fix128_sub(lhs, rhs);
+    // Overflow if the inputs have different signs, and the sign of the result differs from lhs
+    if (FIX64_UNLIKELY(((lhs.hi ^ rhs.hi) & (lhs.hi ^ result.hi)) < 0)) {
+        result = (rhs.hi >= 0) ? FIX128_MIN : FIX128_MAX;
+    }
+    return result;
+}
+
+// Calculates the rounded product lhs * rhs * 2^-64 as a 192 bit number, returning the low 128 bits
+// in result and the high 64 bits. The product of two 128 bit numbers is built from four 64 bit
+// multiplications, of which the lowest only contributes its high half (and the rounding bit)
+static inline int64_t fix128_impl_mul(fix128_t lhs, fix128_t rhs, fix128_t *result) {
+    uint64_t t_hi, t_lo;
+    int64_t x_hi, y_hi, z_hi;
+    t_lo = fix64_impl_mul_u64_u128(lhs.lo, rhs.lo, &t_hi);
+    uint64_t x_lo = fix64_impl_mul_i64_u64_i128(rhs.hi, lhs.lo, &x_hi);
+    uint64_t y_lo = fix64_impl_mul_i64_u64_i128(lhs.hi, rhs.lo, &y_hi);
+    uint64_t z_lo = fix64_impl_mul_i64_i128(lhs.hi, rhs.hi, &z_hi);
+
+    // For rounding, can't overflow since lhs.lo * rhs.lo <= 2^128 - 2^65 + 1
+    t_lo = fix64_impl_add_u128(t_hi, t_lo, 0, UINT64_C(1) << 63, &t_hi);
+    (void)t_lo;
+
+    // Sum the lowest limb, then add its carries along with the sign extended x and y to z
+    uint64_t w0;
+    unsigned carry = fix64_impl_add_u64_overflow(t_hi, x_lo, &w0);
+    carry += fix64_impl_add_u64_overflow(w0, y_lo, &w0);
+    int64_t w2;
+    uint64_t w1 = fix64_impl_add_i128(z_hi, z_lo, x_hi >> 63, (uint64_t)x_hi, &w2);
+    w1 = fix64_impl_add_i128(w2, w1, y_hi >> 63, (uint64_t)y_hi, &w2);
+    w1 = fix64_impl_add_i128(w2, w1, 0, carry, &w2);
+
+    result->hi = (int64_t)w1;
+    result->lo = w0;
+    return w2;
+}
+
+/// Multiplication of two fix128_t numbers. Result is rounded to the nearest representable value,
+/// with halfway values rounded up
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @return the product of the two inputs
+static inline fix128_t fix128_mul(fix128_t lhs, fix128_t rhs) {
+    fix128_t result;
+    fix128_impl_mul(lhs, rhs, &result);
+    return result;
+}
+
+/// Saturating multiplication of two fix128_t numbers. Result is rounded to the nearest
+/// representable value, with halfway values rounded up
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @return the product of the two inputs
+static inline fix128_t fix128_mul_sat(fix128_t lhs, fix128_t rhs) {
+    fix128_t result;
+    int64_t top = fix128_impl_mul(lhs, rhs, &result);
+    // The top 64 bits must be the sign extension of the result
+    if (FIX64_UNLIKELY(top != (result.hi >> 63))) {
+        result = (top < 0) ? FIX128_MIN : FIX128_MAX;
+    }
+    return result;
+}
+
+/// Division of two fix128_t numbers. Result is rounded to the nearest representable value, with
+/// halfway values rounded away from zero. Division by zero is undefined
+///
+/// @param lhs dividend side for the division
+/// @param rhs divisor side for the division
+/// @return the quotient of the two inputs
+fix128_t fix128_div(fix128_t lhs, fix128_t rhs);
+
+/// Saturating division of two fix128_t numbers. Result is rounded to the nearest representable
+/// value, with halfway values rounded away from zero. Division by zero is saturated depending on
+/// the sign of the dividend
+///
+/// @param lhs dividend side for the division
+/// @param rhs divisor side for the division
+/// @return the quotient of the two inputs
+fix128_t fix128_div_sat(fix128_t lhs, fix128_t rhs);
+
+//==========================================================
+// Comparison functions
+//==========================================================
+
+/// Compares two fix128_t values for equality
+///
+/// @param lhs left hand side for comparison
+/// @param rhs right hand side for comparison
+/// @return 1 if the values are equal, 0 otherwise
+static inline int fix128_eq(fix128_t lhs, fix128_t rhs) {
+    return (lhs.hi == rhs.hi) && (lhs.lo == rhs.lo);
+}
+
+/// Compares two fix128_t values for inequality
+///
+/// @param lhs left hand side for comparison
+/// @param rhs right hand side for comparison
+/// @return 1 if the values are not equal, 0 otherwise
+static inline int fix128_neq(fix128_t lhs, fix128_t rhs) {
+    return (lhs.hi != rhs.hi) || (lhs.lo != rhs.lo);
+}
+
+/// Check if a fix128_t is less than another
+///
+/// @param lhs left hand side for comparison
+/// @param rhs right hand side for comparison
+/// @return 1 if lhs is less than rhs, 0 otherwise
+static inline int fix128_lt(fix128_t lhs, fix128_t rhs) {
+    return (lhs.hi < rhs.hi) || (lhs.hi == rhs.hi && lhs.lo < rhs.lo);
+}
+
+/// Check if a fix128_t is greater than another
+///
+/// @param lhs left hand side for comparison
+/// @param rhs right hand side for comparison
+/// @return 1 if lhs is greater than rhs, 0 otherwise
+static inline int fix128_gt(fix128_t lhs, fix128_t rhs) {
+    return fix128_lt(rhs, lhs);
+}
+
+/// Check if a fix128_t is less than or equal to another
+///
+/// @param lhs left hand side for comparison
+/// @param rhs right hand side for comparison
+/// @return 1 if lhs is less than or equal to rhs, 0 otherwise
+static inline int fix128_lte(fix128_t lhs, fix128_t rhs) {
+    return !fix128_lt(rhs, lhs);
+}
+
+/// Check if a fix128_t is greater than or equal to another
+///
+/// @param lhs left hand side for comparison
+/// @param rhs right hand side for comparison
+/// @return 1 if lhs is greater than or equal to rhs, 0 otherwise
+static inline int fix128_gte(fix128_t lhs, fix128_t rhs) {
+    return !fix128_lt(lhs, rhs);
+}
+
+//==========================================================
+// Conversion functions
+//==========================================================
+
+/// Converts a fix64_t to a fix128_t. The conversion is exact
+///
+/// @param arg the fix64_t value to convert
+/// @return converted fix128_t value
+static inline fix128_t fix128_from_fix64(fix64_t arg) {
+    fix128_t result;
+    result.hi = arg.repr >> FIX64_FRAC_BITS;
+    result.lo = (uint64_t)arg.repr << (64 - FIX64_FRAC_BITS);
+    return result;
+}
+
+/// Converts a fix128_t to a fix64_t. The result is rounded to the nearest representable value,
+/// with halfway values rounded up, and saturates if it is outside of fix64_t's range
+///
+/// @param arg the fix128_t value to convert
+/// @return converted fix64_t value
+static inline fix64_t fix128_to_fix64(fix128_t arg) {
+    if (FIX64_UNLIKELY(arg.hi < (INT64_MIN >> FIX64_FRAC_BITS))) {
+        return FIX64_MIN;
+    }
+    // Check before rounding too, so that the addition can't overflow
+    if (FIX64_UNLIKELY(arg.hi > (INT64_MAX >> FIX64_FRAC_BITS))) {
+        return FIX64_MAX;
+    }
+    int64_t hi;
+    uint64_t lo = fix64_impl_add_i128(
+        arg.hi, arg.lo, 0, UINT64_C(1) << (64 - FIX64_FRAC_BITS - 1), &hi); // For rounding
+    if (FIX64_UNLIKELY(hi > (INT64_MAX >> FIX64_FRAC_BITS))) {
+        return FIX64_MAX;
+    }
+    int64_t result = (hi << FIX64_FRAC_BITS) | (lo >> (64 - FIX64_FRAC_BITS));
+    return (fix64_t){ result };
+}
+
+/// Converts an int64_t to a fix128_t. The conversion is exact
+///
+/// @param arg the int64_t value to convert
+/// @return converted fix128_t value
+static inline fix128_t fix128_from_i64(int64_t arg) {
+    fix128_t result = { arg, 0 };
+    return result;
+}
+
+/// Converts a fix128_t to an int64_t, rounding down
+///
+/// @param arg the fix128_t value to convert
+/// @return converted int64_t value
+static inline int64_t fix128_to_i64(fix128_t arg) {
+    return arg.hi;
+}
+
+/// Converts a double to a fix128_t. The result is rounded to the nearest representable value and
+/// saturates if it is outside of fix128_t's range. Undefined behaviour if input is NaN
+///
+/// @param arg the double value to convert
+/// @return converted fix128_t value
+fix128_t fix128_from_dbl(double arg);
+
+/// Converts a fix128_t to a double. The integral and fractional parts are converted separately so
+/// the result may differ from the correctly rounded value in the last bit
+///
+/// @param arg the fix128_t value to convert
+/// @return converted double value
+static inline double fix128_to_dbl(fix128_t arg) {
+    // 2^-64 is exactly representable, but the hex literal 0x1p-64 isn't valid C++ before C++17
+    return (double)arg.hi + (double)arg.lo * (1.0 / 18446744073709551616.0);
+}
+
+//==========================================================
+// String conversions
+//==========================================================
+
+/// Converts a fix128_t value to its string representation in the given format. The behaviour is
+/// the same as fix64_to_str_fmt, except that decimal formatting allows up to 20 decimals rather
+/// than 19, which is enough for the string to parse back to the same value
+///
+/// @param buf a string buffer to write the string to
+/// @param value the fix128_t value to convert
+/// @param size the total size of the string buffer used for bounds checking
+/// @param fmt the format for the string
+/// @return the number of characters that would have been written without truncation
+size_t fix128_to_str_fmt(char *buf, fix128_t val, size_t size, fix64_fmt_param_t fmt);
+
+/// Converts a fix128_t value to its string representation with 5 decimals, the same as
+/// fix64_to_str
+///
+/// @param buf a string buffer to write the string to
+/// @param value the fix128_t value to convert
+/// @param size the total size of the string buffer used for bounds checking
+/// @return the number of characters that would have been written without truncation
+static inline size_t fix128_to_str(char *buf, fix128_t val, size_t size) {
+    fix64_fmt_param_t fmt = { .decimals = 5 };
+    return fix128_to_str_fmt(buf, val, size, fmt);
+}
+
+/// Converts a fix128_t value to its hexadecimal string representation with all 16 fractional
+/// digits
+///
+/// @param buf a string buffer to write the string to
+/// @param value the fix128_t value to convert
+/// @param size the total size of the string buffer used for bounds checking
+/// @return the number of characters that would have been written without truncation
+static inline size_t fix128_to_hex(char *buf, fix128_t val, size_t size) {
+    fix64_fmt_param_t fmt = { .decimals = 16, .base = FIX64_BASE_HEXADECIMAL };
+    return fix128_to_str_fmt(buf, val, size, fmt);
+}
+
+/// Converts a string to a fix128_t value, with the same syntax as fix64_from_str. The result is
+/// rounded to the nearest representable value with halfway values rounded away from zero, and
+/// values outside of fix128_t's range are saturated
+///
+/// @param str the string to parse
+/// @param size the maximum number of characters to read
+/// @param value the parsed value is written here. Not written if no number could be parsed
+/// @return the number of characters parsed, or 0 if the string doesn't start with a number
+size_t fix128_from_str(const char *str, size_t size, fix128_t *value);
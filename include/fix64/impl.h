@@ -34,6 +34,30 @@
     #define FIX64_IMPL_USE_NATIVE_DIVQ 1
 #endif
 
+// Engines for the 128/64-bit division used by fix64_div, fix64_div_sat, fix64_tan, etc. Define
+// FIX64_DIV_ENGINE as one of these to override the default, e.g. with the FIX64_DIV_ENGINE CMake
+// option. Which is fastest depends on the hardware divider, since recent x86-64 cores have much
+// faster divq than older ones, so compare them with benches/div.c before changing the default
+#define FIX64_DIV_ENGINE_DIVQ  1 // The x86-64 divq instruction
+#define FIX64_DIV_ENGINE_SOFT  2 // Two 128/64-bit divisions of 32-bit digits, based on libdivide
+// A reciprocal from a table and Newton iterations, see below. On an Ice Lake Xeon it was slower
+// than soft with lzcnt (14.6 vs 13.7 ns with -march=native) and with the fallback helpers (54.5 vs
+// 42.3 ns), and about the same without lzcnt (both about 10 ns)
+#define FIX64_DIV_ENGINE_RECIP 3
+// Calls whichever engine was chosen at runtime with fix64_select_div_engine, through a
+// function pointer. The call can't be inlined, but it costs little since it's well predicted
+#define FIX64_DIV_ENGINE_RUNTIME 4
+
+#if !defined(FIX64_DIV_ENGINE)
+    #if FIX64_IMPL_USE_NATIVE_DIVQ
+        #define FIX64_DIV_ENGINE FIX64_DIV_ENGINE_DIVQ
+    #else
+        #define FIX64_DIV_ENGINE FIX64_DIV_ENGINE_SOFT
+    #endif
+#elif FIX64_DIV_ENGINE == FIX64_DIV_ENGINE_DIVQ && !FIX64_IMPL_USE_NATIVE_DIVQ
+    #error "FIX64_DIV_ENGINE_DIVQ needs x86-64 and a GNU compatible compiler"
+#endif
+
 #if FIX64_IMPL_HAS_BUILTIN(__builtin_clz, 4) && !defined(FIX64_IMPL_OVERRIDE_USE_FALLBACK)
     #define FIX64_IMPL_USE_BUILTIN_CLZ 1
 #endif
@@ -196,10 +220,98 @@ static inline uint64_t fix64_impl_mul_i64_u64_i128(int64_t x, uint64_t y, int64_
 }
 #endif // if FIX64_IMPL_USE_INT128
 
+#if FIX64_IMPL_USE_BUILTIN_CLZ
+static inline unsigned fix64_impl_clz32(uint32_t arg) {
+    // clz has UB when arg == 0, but this branch is optimised away pretty nicely on e.g. ARM where
+    // the underlying clz instruction is defined
+    return arg ? __builtin_clz(arg) : (CHAR_BIT * sizeof(arg));
+}
+#if FIX64_IMPL_USE_NATIVE_DIVQ && !defined(__LZCNT__)
+// Without lzcnt __builtin_clzll compiles to bsr, which leaves its destination unchanged when
+// arg == 0 and so has to wait for the destination's previous value. Inlined into a loop this chains
+// each call to the previous one (inlined log2 was 70% slower than calling it), so the destination
+// is zeroed first
+static inline unsigned fix64_impl_clz64(uint64_t arg) {
+    uint64_t index = 0;
+    // clang-format off
+    __asm__ (
+        "bsrq\t%[arg], %[index]"
+        : [index]"+r"(index)
+        : [arg]"rm"(arg)
+        : "flags"
+    );
+    // clang-format on
+    return arg ? (unsigned)(index ^ 63) : (CHAR_BIT * sizeof(arg));
+}
+#else
+static inline unsigned fix64_impl_clz64(uint64_t arg) {
+    // clz has UB when arg == 0, but this branch is optimised away pretty nicely on e.g. ARM where
+    // the underlying clz instruction is defined
+    return arg ? __builtin_clzll(arg) : (CHAR_BIT * sizeof(arg));
+}
+#endif
+#else
+static inline unsigned fix64_impl_clz32(uint32_t arg) {
+    unsigned result = 0;
+    if (arg == 0) {
+        return (CHAR_BIT * sizeof(arg));
+    }
+    for (unsigned sh = (CHAR_BIT * sizeof(arg)) >> 1; sh; sh >>= 1) {
+        uint32_t tmp = arg >> sh;
+        if (tmp) {
+            arg = tmp;
+        } else {
+            result |= sh;
+        }
+    }
+    return result;
+}
+static inline unsigned fix64_impl_clz64(uint64_t arg) {
+    unsigned result = 0;
+    if (arg == 0) {
+        return (CHAR_BIT * sizeof(arg));
+    }
+    for (unsigned sh = (CHAR_BIT * sizeof(arg)) >> 1; sh; sh >>= 1) {
+        uint32_t tmp = arg >> sh;
+        if (tmp) {
+            arg = tmp;
+        } else {
+            result |= sh;
+        }
+    }
+    return result;
+}
+#endif
+
+// Initial approximations of 2^19 / d for d in [256, 512), indexed by d - 256. Implemented in
+// src/recip.c
+extern const uint16_t fix64_impl_recip_table[256];
+
+// Reciprocal of a normalised d (i.e. d >= 2^63) as floor((2^128 - 1) / d) - 2^64, which is exact.
+// The 11-bit table seed is refined by Newton iterations with 64-bit multiplications, from
+// Möller and Granlund's "Improved division by invariant integers" (algorithm 2)
+static inline uint64_t fix64_impl_recip_u64(uint64_t d) {
+    uint64_t d0 = d & 1;
+    uint64_t d9 = d >> 55;
+    uint64_t d40 = (d >> 24) + 1;
+    uint64_t d63 = (d >> 1) + d0;
+    uint64_t v0 = fix64_impl_recip_table[d9 - 256];
+    uint64_t v1 = (v0 << 11) - ((v0 * v0 * d40) >> 40) - 1;
+    uint64_t v2 = (v1 << 13) + ((v1 * ((UINT64_C(1) << 60) - v1 * d40)) >> 47);
+    uint64_t e = ((v2 >> 1) & (0 - d0)) - v2 * d63;
+    uint64_t hi, lo;
+    fix64_impl_mul_u64_u128(v2, e, &hi);
+    uint64_t v3 = (v2 << 31) + (hi >> 1);
+    // v3 may be slightly too small, the final step subtracts (v3 + 2^64 + 1) * d / 2^64
+    lo = fix64_impl_mul_u64_u128(v3, d, &hi);
+    fix64_impl_add_u128(hi, lo, 0, d, &hi);
+    return v3 - hi - d;
+}
+
 // Don't try to implement division with __int128, it is at best as fast as our C/ASM combo fallback
 // implementation, but can be slower
 #if FIX64_IMPL_USE_NATIVE_DIVQ
-static inline uint64_t fix64_impl_div_u128_u64(uint64_t u_hi, uint64_t u_lo, uint64_t v) {
+static inline uint64_t fix64_impl_div_u128_u64_divq(uint64_t u_hi, uint64_t u_lo, uint64_t v) {
     if (FIX64_UNLIKELY(u_hi >= v)) {
         u_hi %= v;
     }
@@ -215,6 +327,67 @@ static inline uint64_t fix64_impl_div_u128_u64(uint64_t u_hi, uint64_t u_lo, uin
     // clang-format on
     return q;
 }
+#endif
+
+// Implemented in src/fallback.c
+uint64_t fix64_impl_div_u128_u64_soft(uint64_t u_hi, uint64_t u_lo, uint64_t v);
+
+static inline uint64_t fix64_impl_div_u128_u64_recip(uint64_t u_hi, uint64_t u_lo, uint64_t v) {
+    // If the quotient doesn't fit in a uint64_t use u_hi % v, which is equivalent to it wrapping
+    if (FIX64_UNLIKELY(u_hi >= v)) {
+        u_hi %= v;
+    }
+
+    // Normalise the divisor and the dividend, which won't overflow since u_hi < v
+    unsigned shift = fix64_impl_clz64(v);
+    v <<= shift;
+    u_hi = (shift) ? ((u_hi << shift) | (u_lo >> (64 - shift))) : u_hi;
+    u_lo <<= shift;
+
+    // Möller and Granlund's "Improved division by invariant integers" (algorithm 4), where the
+    // candidate quotient is often one too large, or rarely one too small
+    uint64_t q_hi;
+    uint64_t q_lo = fix64_impl_mul_u64_u128(fix64_impl_recip_u64(v), u_hi, &q_hi);
+    q_lo = fix64_impl_add_u128(q_hi, q_lo, u_hi + 1, u_lo, &q_hi);
+    uint64_t rem = u_lo - q_hi * v;
+    uint64_t mask = 0 - (uint64_t)(rem > q_lo);
+    q_hi += mask;
+    rem += mask & v;
+    if (FIX64_UNLIKELY(rem >= v)) {
+        q_hi++;
+    }
+    return q_hi;
+}
+
+// The engine used with FIX64_DIV_ENGINE_RUNTIME, which is divq where it's available and soft
+// otherwise until fix64_select_div_engine is called. Implemented in src/fallback.c
+extern uint64_t (*fix64_impl_div_u128_u64_runtime)(uint64_t u_hi, uint64_t u_lo, uint64_t v);
+
+// The FIX64_DIV_ENGINE_* engine which fix64_impl_div_u128_u64_runtime points to
+extern int fix64_impl_div_engine_runtime;
+
+// The engine which fix64_impl_div_u128_u64 uses, which is a constant unless it's chosen at runtime
+static inline int fix64_impl_div_engine(void) {
+#if FIX64_DIV_ENGINE == FIX64_DIV_ENGINE_RUNTIME
+    return fix64_impl_div_engine_runtime;
+#else
+    return FIX64_DIV_ENGINE;
+#endif
+}
+
+// Divides u_hi:u_lo by v with the selected FIX64_DIV_ENGINE. If the quotient doesn't fit in a
+// uint64_t it wraps, and division by 0 is undefined
+static inline uint64_t fix64_impl_div_u128_u64(uint64_t u_hi, uint64_t u_lo, uint64_t v) {
+#if FIX64_DIV_ENGINE == FIX64_DIV_ENGINE_DIVQ
+    return fix64_impl_div_u128_u64_divq(u_hi, u_lo, v);
+#elif FIX64_DIV_ENGINE == FIX64_DIV_ENGINE_RECIP
+    return fix64_impl_div_u128_u64_recip(u_hi, u_lo, v);
+#elif FIX64_DIV_ENGINE == FIX64_DIV_ENGINE_RUNTIME
+    return fix64_impl_div_u128_u64_runtime(u_hi, u_lo, v);
+#else
+    return fix64_impl_div_u128_u64_soft(u_hi, u_lo, v);
+#endif
+}
 
 static inline int64_t fix64_impl_div_i128_i64(int64_t u_hi, uint64_t u_lo, int64_t v) {
     // unsigned variables
@@ -243,10 +416,6 @@ static inline int64_t fix64_impl_div_i128_i64(int64_t u_hi, uint64_t u_lo, int64
 
     return result;
 }
-#else
-uint64_t fix64_impl_div_u128_u64(uint64_t u_hi, uint64_t u_lo, uint64_t v);
-int64_t fix64_impl_div_i128_i64(int64_t u_hi, uint64_t u_lo, int64_t v);
-#endif
 
 static inline uint64_t fix64_impl_div_u128_u64_sat(uint64_t u_hi, uint64_t u_lo, uint64_t v) {
     if (FIX64_UNLIKELY(u_hi >= v)) {
@@ -305,46 +474,19 @@ static inline int64_t fix64_impl_div_i128_i64_sat(int64_t u_hi, uint64_t u_lo, i
     return fix64_impl_div_i128_i64(u_hi, u_lo, v);
 }
 
-#if FIX64_IMPL_USE_BUILTIN_CLZ
-static inline unsigned fix64_impl_clz32(uint32_t arg) {
-    // clz has UB when arg == 0, but this branch is optimised away pretty nicely on e.g. ARM where
-    // the underlying clz instruction is defined
-    return arg ? __builtin_clz(arg) : (CHAR_BIT * sizeof(arg));
-}
-static inline unsigned fix64_impl_clz64(uint64_t arg) {
-    // clz has UB when arg == 0, but this branch is optimised away pretty nicely on e.g. ARM where
-    // the underlying clz instruction is defined
-    return arg ? __builtin_clzll(arg) : (CHAR_BIT * sizeof(arg));
-}
+// The math functions are defined out of line in the library, or as static inline functions in the
+// headers in fix64/math if FIX64_INLINE_MATH is defined, so that the compiler can inline them into
+// tight loops. FIX64_INLINE_MATH can be defined for individual translation units, since the
+// library always has the out of line definitions too
+#ifdef FIX64_INLINE_MATH
+    #define FIX64_MATH_DEF static inline
 #else
-static inline unsigned fix64_impl_clz32(uint32_t arg) {
-    unsigned result = 0;
-    if (arg == 0) {
-        return (CHAR_BIT * sizeof(arg));
-    }
-    for (unsigned sh = (CHAR_BIT * sizeof(arg)) >> 1; sh; sh >>= 1) {
-        uint32_t tmp = arg >> sh;
-        if (tmp) {
-            arg = tmp;
-        } else {
-            result |= sh;
-        }
-    }
-    return result;
-}
-static inline unsigned fix64_impl_clz64(uint64_t arg) {
-    unsigned result = 0;
-    if (arg == 0) {
-        return (CHAR_BIT * sizeof(arg));
-    }
-    for (unsigned sh = (CHAR_BIT * sizeof(arg)) >> 1; sh; sh >>= 1) {
-        uint32_t tmp = arg >> sh;
-        if (tmp) {
-            arg = tmp;
-        } else {
-            result |= sh;
-        }
-    }
-    return result;
-}
+    #define FIX64_MATH_DEF
+#endif
+
+// Square root of u_hi:u_lo rounded down, defined in fix64/math/sqrt.h
+FIX64_MATH_DEF uint64_t fix64_impl_sqrt_u128(uint64_t u_hi, uint64_t u_lo);
+
+#ifdef FIX64_INLINE_MATH
+    #include "fix64/math/sqrt.h"
 #endif
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "fix64.h"
 
 //==========================================================
@@ -88,6 +91,134 @@ static inline fix64_t fix64_dim(fix64_t x, fix64_t y) {
     return fix64_max(fix64_sub_sat(x, y), FIX64_ZERO);
 }
 
+//==========================================================
+// Remainder and decomposition functions
+//==========================================================
+
+// Magnitude of a fix64_t's repr, which doesn't overflow for FIX64_MIN
+static inline uint64_t fix64_impl_abs_u64(int64_t arg) {
+    uint64_t sign = (uint64_t)(arg >> 63); // = -(arg < 0)
+    return ((uint64_t)arg ^ sign) - sign;
+}
+
+/// Computes the remainder of x / y, where the quotient is rounded towards zero like C's fmod. The
+/// result is exact and has the same sign as x. Note: fix64_fmod(x, FIX64_ZERO) returns zero.
+///
+/// @param x the dividend
+/// @param y the divisor
+/// @return x - trunc(x / y) * y
+static inline fix64_t fix64_fmod(fix64_t x, fix64_t y) {
+    uint64_t x_sign = (uint64_t)(x.repr >> 63);
+    uint64_t ux = fix64_impl_abs_u64(x.repr);
+    uint64_t uy = fix64_impl_abs_u64(y.repr);
+    uy += (uy == 0); // ux % 1 == 0
+
+    uint64_t rem = ux % uy;
+    return (fix64_t){ (int64_t)((rem ^ x_sign) - x_sign) };
+}
+
+/// Computes the remainder of x / y, where the quotient is rounded to the nearest integer with
+/// halfway values rounded to even like C's remainder. The result is exact and lies in
+/// [-|y|/2, |y|/2]. Note: fix64_remainder(x, FIX64_ZERO) returns zero.
+///
+/// @param x the dividend
+/// @param y the divisor
+/// @return x - round(x / y) * y
+static inline fix64_t fix64_remainder(fix64_t x, fix64_t y) {
+    uint64_t x_sign = (uint64_t)(x.repr >> 63);
+    uint64_t ux = fix64_impl_abs_u64(x.repr);
+    uint64_t uy = fix64_impl_abs_u64(y.repr);
+    uy += (uy == 0); // ux % 1 == 0
+
+    // Compilers use a single division for both of these
+    uint64_t quot = ux / uy;
+    uint64_t rem = ux % uy;
+
+    // If the quotient rounds up, the remainder is rem - uy, which is negative
+    uint64_t round_up = (rem > uy - rem) | ((rem == uy - rem) & quot & 1);
+    rem -= uy & (0 - round_up);
+    return (fix64_t){ (int64_t)((rem ^ x_sign) - x_sign) };
+}
+
+/// Splits a fixed point number into its integral and fractional parts, which both have the same
+/// sign as the argument, like C's modf
+///
+/// @param arg the fixed point number to split
+/// @param int_part set to the integral part, i.e. fix64_trunc(arg)
+/// @return the fractional part
+static inline fix64_t fix64_modf(fix64_t arg, fix64_t *int_part) {
+    int64_t frac = arg.repr & (FIX64_ONE.repr - 1); // = arg - floor(arg)
+
+    // Negative numbers with a fractional part are truncated up rather than down
+    int64_t adjust = (arg.repr >> 63) & -(int64_t)(frac != 0) & FIX64_ONE.repr;
+    int_part->repr = arg.repr - frac + adjust;
+    return (fix64_t){ frac - adjust };
+}
+
+/// Splits a fixed point number into a mantissa and a power of 2, like C's frexp. The mantissa's
+/// magnitude is in [0.5, 1) unless the argument is zero, in which case both are zero. The mantissa
+/// only has FIX64_FRAC_BITS significant bits, so the lowest bits of numbers >= 1 are truncated.
+///
+/// @param arg the fixed point number to split
+/// @param exp set to the power of 2
+/// @return the mantissa, so that arg = mantissa * 2^exp
+static inline fix64_t fix64_frexp(fix64_t arg, int *exp) {
+    uint64_t sign = (uint64_t)(arg.repr >> 63);
+    uint64_t mag = fix64_impl_abs_u64(arg.repr);
+
+    // Shift so the most significant bit has a value of 0.5
+    int shift = (int)(64 - fix64_impl_clz64(mag)) - FIX64_FRAC_BITS;
+    uint64_t mant = (shift > 0) ? (mag >> shift) : (mag << -shift);
+
+    *exp = shift & -(int)(mag != 0);
+    return (fix64_t){ (int64_t)((mant ^ sign) - sign) };
+}
+
+/// Multiplies a fixed point number by 2 raised to an integer power, like C's ldexp. The result is
+/// rounded to the nearest like fix64_mul, and wraps on overflow like fix64_mul.
+///
+/// @param arg the fixed point number
+/// @param exp the power of 2
+/// @return arg * 2^exp
+static inline fix64_t fix64_ldexp(fix64_t arg, int exp) {
+    if (exp >= 0) {
+        return (fix64_t){ (exp < 64) ? (int64_t)((uint64_t)arg.repr << exp) : 0 };
+    }
+
+    // Shift by one less first so that the rounding bit is the lowest bit, which can't overflow.
+    // Anything shifted by >= 64 rounds to zero
+    unsigned shift = (exp < -64) ? 63 : (unsigned)(-exp - 1);
+    int64_t result = arg.repr >> shift;
+    return (fix64_t){ (result >> 1) + (result & 1) };
+}
+
+/// Multiplies a fixed point number by 2 raised to an integer power, like C's ldexp. The result is
+/// rounded to the nearest like fix64_mul, and saturates at FIX64_MIN or FIX64_MAX on overflow.
+///
+/// @param arg the fixed point number
+/// @param exp the power of 2
+/// @return arg * 2^exp
+static inline fix64_t fix64_ldexp_sat(fix64_t arg, int exp) {
+    // Number of redundant sign bits, i.e. how far arg can be shifted left without overflowing
+    int headroom = (int)fix64_impl_clz64((uint64_t)(arg.repr ^ (arg.repr >> 63))) - 1;
+    if (FIX64_UNLIKELY(exp > headroom && arg.repr != 0)) {
+        return (fix64_t){ (arg.repr >> 63) ^ INT64_MAX };
+    }
+    return fix64_ldexp(arg, exp);
+}
+
+/// Computes fix64_fmod for an array of dividends and a common divisor
+///
+/// @param xs array of count dividends
+/// @param y the divisor
+/// @param ys array of count results, which may be the same array as xs
+/// @param count the number of elements
+static inline void fix64_fmod_batch(const fix64_t *xs, fix64_t y, fix64_t *ys, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        ys[i] = fix64_fmod(xs[i], y);
+    }
+}
+
 //==========================================================
 // Exponential functions
 //==========================================================
@@ -96,13 +227,13 @@ static inline fix64_t fix64_dim(fix64_t x, fix64_t y) {
 ///
 /// @param arg fixed point number
 /// @return e raised to the given power
-fix64_t fix64_exp(fix64_t arg);
+FIX64_MATH_DEF fix64_t fix64_exp(fix64_t arg);
 
 /// Returns 2 raised to the given power
 ///
 /// @param arg fixed point number
 /// @return 2 raised to the given power
-fix64_t fix64_exp2(fix64_t arg);
+FIX64_MATH_DEF fix64_t fix64_exp2(fix64_t arg);
 
 /// Returns e raised to the given power, minus one
 ///
@@ -116,19 +247,19 @@ static inline fix64_t fix64_expm1(fix64_t arg) {
 ///
 /// @param arg fixed point number
 /// @return the natural logarithm
-fix64_t fix64_log(fix64_t arg);
+FIX64_MATH_DEF fix64_t fix64_log(fix64_t arg);
 
 /// Returns base 10 logarithm of a number
 ///
 /// @param arg fixed point number
 /// @return the base 10 logarithm
-fix64_t fix64_log10(fix64_t arg);
+FIX64_MATH_DEF fix64_t fix64_log10(fix64_t arg);
 
 /// Returns base 2 logarithm of a number
 ///
 /// @param arg fixed point number
 /// @return the base 2 logarithm
-fix64_t fix64_log2(fix64_t arg);
+FIX64_MATH_DEF fix64_t fix64_log2(fix64_t arg);
 
 /// Returns natural (base e) logarithm of 1 plus the argument
 ///
@@ -189,14 +320,14 @@ static inline fix64_t fix64_hypot(fix64_t x, fix64_t y) {
 ///
 /// @param angle the angle
 /// @return the sine of the angle
-fix64_t fix64_sin(fix64_t angle);
+FIX64_MATH_DEF fix64_t fix64_sin(fix64_t angle);
 
 /// Computes the cosine of a given angle. The result is extremely accurate, with a maximum error of
 /// +/-FIX64_EPSILON for <0.01% of inputs.
 ///
 /// @param angle the angle
 /// @return the cosine of the angle
-fix64_t fix64_cos(fix64_t angle);
+FIX64_MATH_DEF fix64_t fix64_cos(fix64_t angle);
 
 /// Computes the tangent of a given angle. The result is extremely accurate, with a maximum error
 /// of +/-FIX64_EPSILON for <0.01% of angles >0.0001pi from a singularity. Near the singularities
@@ -205,7 +336,103 @@ fix64_t fix64_cos(fix64_t angle);
 ///
 /// @param angle the angle
 /// @return the tangent of the angle
-fix64_t fix64_tan(fix64_t angle);
+FIX64_MATH_DEF fix64_t fix64_tan(fix64_t angle);
+
+/// Computes the sine and cosine of a given angle, which is faster than calling fix64_sin and
+/// fix64_cos separately. The results are identical to theirs.
+///
+/// @param angle the angle
+/// @param sin_result set to the sine of the angle
+/// @param cos_result set to the cosine of the angle
+FIX64_MATH_DEF void fix64_sincos(fix64_t angle, fix64_t *sin_result, fix64_t *cos_result);
+
+/// Computes the sine of an angle in turns, where 1.0 is a full circle. Only the fractional part of
+/// the angle is used, so the result repeats exactly every turn and no reduction by pi is needed.
+/// The accuracy is the same as fix64_sin.
+///
+/// @param turns the angle in turns
+/// @return the sine of the angle
+FIX64_MATH_DEF fix64_t fix64_sin_turns(fix64_t turns);
+
+/// Computes the cosine of an angle in turns, where 1.0 is a full circle. Only the fractional part
+/// of the angle is used, so the result repeats exactly every turn and no reduction by pi is
+/// needed. The accuracy is the same as fix64_cos.
+///
+/// @param turns the angle in turns
+/// @return the cosine of the angle
+FIX64_MATH_DEF fix64_t fix64_cos_turns(fix64_t turns);
+
+/// Computes the sine and cosine of an angle in turns, where 1.0 is a full circle
+///
+/// @param turns the angle in turns
+/// @param sin_result set to fix64_sin_turns(turns)
+/// @param cos_result set to fix64_cos_turns(turns)
+FIX64_MATH_DEF void fix64_sincos_turns(fix64_t turns, fix64_t *sin_result, fix64_t *cos_result);
+
+/// Computes the tangent of an angle in turns, where 1.0 is a full circle. Only the fractional
+/// part of the angle is used, so the result repeats exactly every half turn. The accuracy is the
+/// same as fix64_tan, including saturation near the singularities.
+///
+/// @param turns the angle in turns
+/// @return the tangent of the angle
+FIX64_MATH_DEF fix64_t fix64_tan_turns(fix64_t turns);
+
+/// Computes the sine of an angle in degrees. The angle is reduced modulo 360 exactly, so the result
+/// repeats exactly every 360 degrees. The accuracy is the same as fix64_sin.
+///
+/// @param degrees the angle in degrees
+/// @return the sine of the angle
+FIX64_MATH_DEF fix64_t fix64_sin_deg(fix64_t degrees);
+
+/// Computes the cosine of an angle in degrees. The angle is reduced modulo 360 exactly, so the
+/// result repeats exactly every 360 degrees. The accuracy is the same as fix64_cos.
+///
+/// @param degrees the angle in degrees
+/// @return the cosine of the angle
+FIX64_MATH_DEF fix64_t fix64_cos_deg(fix64_t degrees);
+
+/// Computes the sine and cosine of an angle in degrees
+///
+/// @param degrees the angle in degrees
+/// @param sin_result set to fix64_sin_deg(degrees)
+/// @param cos_result set to fix64_cos_deg(degrees)
+FIX64_MATH_DEF void fix64_sincos_deg(fix64_t degrees, fix64_t *sin_result, fix64_t *cos_result);
+
+/// Computes the tangent of an angle in degrees. The angle is reduced modulo 360 exactly, so the
+/// result repeats exactly every 180 degrees. The accuracy is the same as fix64_tan.
+///
+/// @param degrees the angle in degrees
+/// @return the tangent of the angle
+FIX64_MATH_DEF fix64_t fix64_tan_deg(fix64_t degrees);
+
+/// Wraps an angle into the range [-FIX64_PI, FIX64_PI). The reduction modulo 2pi uses the same
+/// high precision constant as fix64_sin, so the result is within 2 FIX64_EPSILON of the exact
+/// value.
+///
+/// @param angle the angle
+/// @return the equivalent angle in [-FIX64_PI, FIX64_PI)
+FIX64_MATH_DEF fix64_t fix64_wrap_pi(fix64_t angle);
+
+/// Wraps an angle into the range [0, 2pi). The reduction modulo 2pi uses the same high precision
+/// constant as fix64_sin, so the result is within 2 FIX64_EPSILON of the exact value.
+///
+/// @param angle the angle
+/// @return the equivalent angle in [0, 2pi)
+FIX64_MATH_DEF fix64_t fix64_wrap_2pi(fix64_t angle);
+
+/// Computes fix64_wrap_pi for an array of angles
+///
+/// @param angles array of count angles
+/// @param results array of count results, which may be the same array as angles
+/// @param count the number of elements
+FIX64_MATH_DEF void fix64_wrap_pi_batch(const fix64_t *angles, fix64_t *results, size_t count);
+
+/// Computes fix64_wrap_2pi for an array of angles
+///
+/// @param angles array of count angles
+/// @param results array of count results, which may be the same array as angles
+/// @param count the number of elements
+FIX64_MATH_DEF void fix64_wrap_2pi_batch(const fix64_t *angles, fix64_t *results, size_t count);
 
 /// Computes arc sine of a given number
 ///
@@ -219,12 +446,29 @@ fix64_t fix64_asin(fix64_t arg);
 /// @return the arc cosine
 fix64_t fix64_acos(fix64_t arg);
 
-/// Computes 2 argument arc tangent of a given pair of numbers
+/// Computes 2 argument arc tangent of a given pair of numbers, like C's atan2. The result is in
+/// [-pi, pi] and has a maximum error of +/-FIX64_EPSILON. fix64_atan2(0, 0) returns 0.
 ///
-/// @param x the horizontal component
 /// @param y the vertical component
+/// @param x the horizontal component
 /// @return the arc tangent of y/x, taking their signs into account
-fix64_t fix64_atan2(fix64_t x, fix64_t y);
+FIX64_MATH_DEF fix64_t fix64_atan2(fix64_t y, fix64_t x);
+
+/// Computes 2 argument arc tangent of a given pair of numbers in turns, where 1.0 is a full
+/// circle, so the result is in [-0.5, 0.5]
+///
+/// @param y the vertical component
+/// @param x the horizontal component
+/// @return the arc tangent of y/x in turns, taking their signs into account
+FIX64_MATH_DEF fix64_t fix64_atan2_turns(fix64_t y, fix64_t x);
+
+/// Computes 2 argument arc tangent of a given pair of numbers in degrees, so the result is in
+/// [-180, 180]
+///
+/// @param y the vertical component
+/// @param x the horizontal component
+/// @return the arc tangent of y/x in degrees, taking their signs into account
+FIX64_MATH_DEF fix64_t fix64_atan2_deg(fix64_t y, fix64_t x);
 
 /// Computes arc tangent of a given number
 ///
@@ -261,3 +505,8 @@ fix64_t fix64_tgamma(fix64_t arg);
 /// @param arg a fixed point number
 /// @return the natural logarithm of the result of the gamma function
 fix64_t fix64_lgamma(fix64_t arg);
+
+#ifdef FIX64_INLINE_MATH
+    #include "fix64/math/exp.h"
+    #include "fix64/math/trig.h"
+#endif
@@ -0,0 +1,33 @@
+#pragma once
+
+// Integer square root. This is included by fix64/impl.h when FIX64_INLINE_MATH is defined, and
+// otherwise compiled once by src/math/sqrt.c, so it shouldn't be included directly
+
+#include <stdint.h>
+
+#include "fix64/impl.h"
+
+FIX64_MATH_DEF uint64_t fix64_impl_sqrt_u128(uint64_t u_hi, uint64_t u_lo) {
+    unsigned bits = u_hi ? 128 - fix64_impl_clz64(u_hi) : 64 - fix64_impl_clz64(u_lo);
+    if (bits <= 1) {
+        return u_lo;
+    }
+
+    // Newton's method converges monotonically from any initial value >= floor(sqrt(u)), so start
+    // with 2^ceil(bits / 2), or 2^64 - 1 if that doesn't fit
+    unsigned shift = (bits + 1) / 2;
+    uint64_t x = (shift < 64) ? (UINT64_C(1) << shift) : UINT64_MAX;
+    for (;;) {
+        // If u / x doesn't fit in 64 bits it's larger than x, so the next step wouldn't decrease x
+        if (FIX64_UNLIKELY(u_hi >= x)) {
+            return x;
+        }
+        uint64_t q = fix64_impl_div_u128_u64(u_hi, u_lo, x);
+        // floor((x + q) / 2) without overflowing
+        uint64_t y = (x >> 1) + (q >> 1) + (x & q & 1);
+        if (y >= x) {
+            return x;
+        }
+        x = y;
+    }
+}
@@ -0,0 +1,355 @@
+#pragma once
+
+// Trigonometric functions. This is included by fix64/math.h when FIX64_INLINE_MATH is defined, and
+// otherwise compiled once by src/math/trig.c, so it shouldn't be included directly
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fix64.h"
+#include "fix64/impl.h"
+
+#include "fix64/math/trig.inc"
+
+// Computes sin of an angle given as the octant it lies in (only the lowest 3 bits are used) and
+// the Q0.62 angle within that octant, where 1.0 = pi/4 = 45deg, and rounds it to Q31.32
+static inline fix64_t fix64_impl_trig_sin_octant(unsigned octant, int64_t norm_a) {
+    // Which eighth of the unit circle the angle lies in determines what calculation is used
+    // a = 0deg..45deg => sin(na)
+    // a = 45deg..90deg => cos(45deg-na)
+    // a = 90deg..135deg => cos(na)
+    // a = 135deg..180deg => sin(45deg-na)
+    // a = 180deg..225deg => -sin(na)
+    // a = 225deg..270deg => -cos(45deg-na)
+    // a = 270deg..315deg => -cos(na)
+    // a = 315deg..360deg => -sin(45deg-na)
+    octant &= 7; // 0-7
+    int neg_angle = (octant & 1) != 0; // flip input range for 1,3,5,7
+    int neg_result = (octant & 4) != 0; // negate result for 4,5,6,7
+    int use_cos = ((octant + 1) & 2) != 0; // use cos for 1,2,5,6
+
+    int64_t result = 0;
+    norm_a = neg_angle ? (FIX64_IMPL_TRIG_ONE - norm_a) : norm_a;
+    if (use_cos) {
+        result = fix64_impl_chebyshev_cos(norm_a); // Q0.62
+    } else {
+        result = fix64_impl_chebyshev_sin(norm_a); // Q0.62
+    }
+    result = neg_result ? -result : result;
+
+    // Round to Q31.32
+    result += (INT64_C(1) << (FIX64_IMPL_TRIG_FRAC_BITS - FIX64_FRAC_BITS - 1));
+    result >>= (FIX64_IMPL_TRIG_FRAC_BITS - FIX64_FRAC_BITS); // Q31.32
+
+    return (fix64_t){ result };
+}
+
+// Computes tan of an angle given as the 16th of the unit circle it lies in (only the lowest 3
+// bits are used since tan repeats every 180deg) and the Q0.62 angle within it, where 1.0 = pi/8 =
+// 22.5deg
+static inline fix64_t fix64_impl_trig_tan_hexadecant(unsigned hexadecant, int64_t norm_a) {
+    // Which 16th of the unit circle the angle lies in determines what calculation is used
+    // a = 0deg..22.5deg => tan(na)
+    // a = 22.5deg..45deg => (1 - tan(45deg-na)) / (1 + tan(45deg-na))
+    // a = 45deg..67.5deg => (1 + tan(na)) / (1 - tan(na))
+    // a = 67.5deg..90deg => 1 / tan(45deg-na)
+    // a = 90deg..112.5deg => -1 / tan(na)
+    // a = 112.5deg..135deg => -(1 + tan(45deg-na)) / (1 - tan(45deg-na))
+    // a = 135deg..157.5deg => -(1 - tan(na)) / (1 + tan(na))
+    // a = 157.5deg..180deg => -tan(45deg-na)
+    hexadecant &= 7; // 0-7
+    int neg_angle = (hexadecant & 1) != 0; // flip input range for 1,3,5,7
+    int neg_result = (hexadecant & 4) != 0; // negate result for 4,5,6,7
+    int recip_result = ((hexadecant + 2) & 4) != 0; // 1/result for 2,3,4,5
+    int angle_sum = ((hexadecant + 1) & 2) != 0; // Use angle sum formula for 1,2,5,6
+
+    int64_t result = 0;
+    norm_a = neg_angle ? (FIX64_IMPL_TRIG_ONE - norm_a) : norm_a;
+    result = fix64_impl_chebyshev_tan(norm_a); // Q1.62
+
+    int64_t num, denom;
+    if (angle_sum) {
+        num = FIX64_IMPL_TRIG_ONE - result; // Q1.62
+        denom = FIX64_IMPL_TRIG_ONE + result; // Q1.62
+    } else {
+        num = result; // Q1.62
+        denom = FIX64_IMPL_TRIG_ONE; // Q1.62
+    }
+
+    if (recip_result) {
+        int64_t tmp = denom;
+        denom = num;
+        num = tmp;
+    }
+
+    int64_t num_hi = num >> (64 - FIX64_FRAC_BITS);
+    uint64_t num_lo = num << FIX64_FRAC_BITS; // Q1.94
+    // fix(a/b + rounding) = fix((a+b*rounding)/b)
+    num_lo = fix64_impl_add_i128(num_hi, num_lo, 0, denom >> 1, &num_hi);
+    denom = neg_result ? -denom : denom;
+    // Saturates near the singularities, including when denom is 0 exactly on one
+    result = fix64_impl_div_i128_i64_sat(num_hi, num_lo, denom);
+
+    return (fix64_t){ result };
+}
+
+// Normalises an angle in radians so that 1.0 = pi/4 = 45deg, and splits it into the octant it
+// lies in and a Q0.62 angle within that octant
+static inline int64_t fix64_impl_trig_reduce(fix64_t angle, unsigned *octant) {
+    int64_t angle_hi;
+    uint64_t angle_lo =
+        fix64_impl_mul_i64_i128(angle.repr, FIX64_IMPL_TRIG_4_PI, &angle_hi); // Q31.94
+
+    // Modulo 8 (2pi, i.e. 360deg)
+    // Fractional bits in angle_hi
+    unsigned hi_frac_bits = FIX64_IMPL_TRIG_FRAC_BITS + FIX64_FRAC_BITS - 64;
+    angle_hi &= (1ll << (hi_frac_bits + 3)) - 1; // Q3.94
+    *octant = (angle_hi >> hi_frac_bits); // 0-7
+
+    // Normalise to Q0.62 in the range [0, pi/4)
+    int64_t norm_a =
+        ((uint64_t)angle_hi << (64 - FIX64_FRAC_BITS)) | (angle_lo >> FIX64_FRAC_BITS); // UQ2.62
+    return norm_a & (FIX64_IMPL_TRIG_ONE - 1); // Q0.62
+}
+
+FIX64_MATH_DEF fix64_t fix64_sin(fix64_t angle) {
+    unsigned octant;
+    int64_t norm_a = fix64_impl_trig_reduce(angle, &octant);
+    return fix64_impl_trig_sin_octant(octant, norm_a);
+}
+
+FIX64_MATH_DEF fix64_t fix64_cos(fix64_t angle) {
+    // cos(a) = sin(a + 90deg)
+    unsigned octant;
+    int64_t norm_a = fix64_impl_trig_reduce(angle, &octant);
+    return fix64_impl_trig_sin_octant(octant + 2, norm_a);
+}
+
+FIX64_MATH_DEF void fix64_sincos(fix64_t angle, fix64_t *sin_result, fix64_t *cos_result) {
+    unsigned octant;
+    int64_t norm_a = fix64_impl_trig_reduce(angle, &octant);
+    *sin_result = fix64_impl_trig_sin_octant(octant, norm_a);
+    *cos_result = fix64_impl_trig_sin_octant(octant + 2, norm_a);
+}
+
+FIX64_MATH_DEF fix64_t fix64_tan(fix64_t angle) {
+    // Normalise so that 1.0 = pi/8 = 22.5deg
+    int64_t angle_hi;
+    uint64_t angle_lo =
+        fix64_impl_mul_i64_u64_i128(angle.repr, FIX64_IMPL_TRIG_8_PI, &angle_hi); // Q33.94
+
+    // Modulo 8 (pi, i.e. 180deg) since tan repeats after that
+    // Fractional bits in angle_hi
+    unsigned hi_frac_bits = FIX64_IMPL_TRIG_FRAC_BITS + FIX64_FRAC_BITS - 64;
+    angle_hi &= (1ll << (hi_frac_bits + 3)) - 1; // Q3.94
+
+    // Normalise to Q0.62, so angle is in the range [0, pi/8)
+    int64_t norm_a =
+        ((uint64_t)angle_hi << (64 - FIX64_FRAC_BITS)) | (angle_lo >> FIX64_FRAC_BITS); // Q1.62
+    norm_a &= (FIX64_IMPL_TRIG_ONE - 1); // Q0.62
+
+    unsigned hexadecant = (angle_hi >> hi_frac_bits); // 0-7
+    return fix64_impl_trig_tan_hexadecant(hexadecant, norm_a);
+}
+
+// Reduces an angle modulo 2pi and returns it as a fraction of a turn, with the same normalisation
+// as fix64_sin
+static inline uint64_t fix64_impl_trig_turns_from_radians(fix64_t angle) {
+    // Normalise so that 1.0 = pi/4 = 45deg
+    int64_t angle_hi;
+    uint64_t angle_lo =
+        fix64_impl_mul_i64_i128(angle.repr, FIX64_IMPL_TRIG_4_PI, &angle_hi); // Q31.94
+
+    // Modulo 8 (2pi, i.e. 360deg) and divide by 8, which both happen by shifting the 3 integral
+    // bits that remain to the top of the result
+    // Fractional bits in angle_hi
+    unsigned hi_frac_bits = FIX64_IMPL_TRIG_FRAC_BITS + FIX64_FRAC_BITS - 64;
+    return ((uint64_t)angle_hi << (64 - hi_frac_bits - 3)) |
+        (angle_lo >> (hi_frac_bits + 3)); // UQ0.64
+}
+
+FIX64_MATH_DEF fix64_t fix64_wrap_pi(fix64_t angle) {
+    // Reinterpreting the turns as signed gives the range [-0.5, 0.5)
+    int64_t turns = (int64_t)fix64_impl_trig_turns_from_radians(angle); // Q0.64
+    int64_t result;
+    fix64_impl_mul_i64_u64_i128(turns, FIX64_IMPL_TRIG_2PI, &result); // Q3.61
+
+    // Round to Q31.32
+    result += (INT64_C(1) << (FIX64_IMPL_TRIG_2PI_FRAC_BITS - FIX64_FRAC_BITS - 1));
+    result >>= (FIX64_IMPL_TRIG_2PI_FRAC_BITS - FIX64_FRAC_BITS); // Q31.32
+
+    // Angles just below pi can be rounded up to it
+    result = (result == FIX64_PI.repr) ? -result : result;
+    return (fix64_t){ result };
+}
+
+FIX64_MATH_DEF fix64_t fix64_wrap_2pi(fix64_t angle) {
+    uint64_t result;
+    uint64_t turns = fix64_impl_trig_turns_from_radians(angle); // UQ0.64
+    fix64_impl_mul_u64_u128(turns, FIX64_IMPL_TRIG_2PI, &result); // UQ3.61
+
+    // Round to Q31.32
+    result += (UINT64_C(1) << (FIX64_IMPL_TRIG_2PI_FRAC_BITS - FIX64_FRAC_BITS - 1));
+    result >>= (FIX64_IMPL_TRIG_2PI_FRAC_BITS - FIX64_FRAC_BITS); // Q31.32
+
+    // Angles just below 2pi can be rounded up to it
+    result &= 0 - (uint64_t)(result != FIX64_IMPL_TRIG_2PI_FIX64);
+    return (fix64_t){ (int64_t)result };
+}
+
+FIX64_MATH_DEF void fix64_wrap_pi_batch(const fix64_t *angles, fix64_t *results, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        results[i] = fix64_wrap_pi(angles[i]);
+    }
+}
+
+FIX64_MATH_DEF void fix64_wrap_2pi_batch(const fix64_t *angles, fix64_t *results, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        results[i] = fix64_wrap_2pi(angles[i]);
+    }
+}
+
+// Converts an angle in turns to a UQ0.64 fraction of a turn, which is exact since only the
+// integral part is dropped
+static inline uint64_t fix64_impl_trig_turns_from_turns(fix64_t turns) {
+    return (uint64_t)turns.repr << (64 - FIX64_FRAC_BITS); // UQ0.64
+}
+
+// Converts an angle in degrees to a UQ0.64 fraction of a turn. The reduction modulo 360deg is
+// exact, so the result repeats exactly every 360deg
+static inline uint64_t fix64_impl_trig_turns_from_degrees(fix64_t degrees) {
+    int64_t full_turn = INT64_C(360) << FIX64_FRAC_BITS;
+    int64_t reduced = degrees.repr % full_turn;
+    reduced += (reduced >> 63) & full_turn; // Q31.32 in [0, 360)
+
+    // Multiplying by 2^72 / 360 gives fractional turns in UQ0.104
+    uint64_t turns_hi;
+    uint64_t turns_lo = fix64_impl_mul_u64_u128(reduced, FIX64_IMPL_TRIG_1_360, &turns_hi);
+    return (turns_hi << 24) | (turns_lo >> 40); // UQ0.64
+}
+
+// The octant of a UQ0.64 fraction of a turn is its top 3 bits, and the rest is the Q0.62 angle
+// within the octant
+static inline fix64_t fix64_impl_trig_sin_turns(uint64_t turns) {
+    return fix64_impl_trig_sin_octant(turns >> 61, (int64_t)((turns << 3) >> 2));
+}
+
+static inline fix64_t fix64_impl_trig_cos_turns(uint64_t turns) {
+    // cos(a) = sin(a + 90deg), which is exact in turns
+    return fix64_impl_trig_sin_turns(turns + (UINT64_C(1) << 62));
+}
+
+static inline fix64_t fix64_impl_trig_tan_turns(uint64_t turns) {
+    return fix64_impl_trig_tan_hexadecant(turns >> 60, (int64_t)((turns << 4) >> 2));
+}
+
+FIX64_MATH_DEF fix64_t fix64_sin_turns(fix64_t turns) {
+    return fix64_impl_trig_sin_turns(fix64_impl_trig_turns_from_turns(turns));
+}
+
+FIX64_MATH_DEF fix64_t fix64_cos_turns(fix64_t turns) {
+    return fix64_impl_trig_cos_turns(fix64_impl_trig_turns_from_turns(turns));
+}
+
+FIX64_MATH_DEF void fix64_sincos_turns(fix64_t turns, fix64_t *sin_result, fix64_t *cos_result) {
+    uint64_t norm_turns = fix64_impl_trig_turns_from_turns(turns);
+    *sin_result = fix64_impl_trig_sin_turns(norm_turns);
+    *cos_result = fix64_impl_trig_cos_turns(norm_turns);
+}
+
+FIX64_MATH_DEF fix64_t fix64_tan_turns(fix64_t turns) {
+    return fix64_impl_trig_tan_turns(fix64_impl_trig_turns_from_turns(turns));
+}
+
+FIX64_MATH_DEF fix64_t fix64_sin_deg(fix64_t degrees) {
+    return fix64_impl_trig_sin_turns(fix64_impl_trig_turns_from_degrees(degrees));
+}
+
+FIX64_MATH_DEF fix64_t fix64_cos_deg(fix64_t degrees) {
+    return fix64_impl_trig_cos_turns(fix64_impl_trig_turns_from_degrees(degrees));
+}
+
+FIX64_MATH_DEF void fix64_sincos_deg(fix64_t degrees, fix64_t *sin_result, fix64_t *cos_result) {
+    uint64_t norm_turns = fix64_impl_trig_turns_from_degrees(degrees);
+    *sin_result = fix64_impl_trig_sin_turns(norm_turns);
+    *cos_result = fix64_impl_trig_cos_turns(norm_turns);
+}
+
+FIX64_MATH_DEF fix64_t fix64_tan_deg(fix64_t degrees) {
+    return fix64_impl_trig_tan_turns(fix64_impl_trig_turns_from_degrees(degrees));
+}
+
+// Computes atan2(y, x) in octants, i.e. where 1.0 = pi/4 = 45deg, as a Q3.60 in [-4, 4]
+static inline int64_t fix64_impl_trig_atan2_octants(fix64_t y, fix64_t x) {
+    uint64_t ux = fix64_impl_abs_u64(x.repr);
+    uint64_t uy = fix64_impl_abs_u64(y.repr);
+
+    // Reflect into the first octant, where 0 <= lo <= hi. atan2(0, 0) is 0 like C's
+    int swap = uy > ux;
+    uint64_t lo = swap ? ux : uy;
+    uint64_t hi = swap ? uy : ux;
+    hi += (hi == 0);
+
+    // Above 22.5deg use atan(t) = 45deg - atan((1 - t) / (1 + t)) so that the polynomial only has
+    // to cover [0, tan(pi/8)]
+    uint64_t tan_hi;
+    fix64_impl_mul_u64_u128(hi, FIX64_IMPL_TRIG_TAN_PI_8, &tan_hi);
+    int upper = lo > tan_hi;
+    if (upper) {
+        // Halve both if needed so that the sum doesn't overflow
+        unsigned shift = hi >> 63;
+        lo >>= shift;
+        hi >>= shift;
+        uint64_t diff = hi - lo;
+        hi += lo;
+        lo = diff;
+    }
+
+    int64_t ratio = fix64_impl_div_u128_u64(lo >> (64 - FIX64_IMPL_TRIG_FRAC_BITS),
+        lo << FIX64_IMPL_TRIG_FRAC_BITS, hi); // Q0.62 in [0, tan(pi/8)]
+    int64_t result = fix64_impl_chebyshev_atan(ratio); // Q1.62 in [0, 0.5]
+    result = upper ? (FIX64_IMPL_TRIG_ONE - result) : result;
+    result >>= 2; // Q3.60 in [0, 1]
+
+    // Undo the reflections
+    int64_t quarter = INT64_C(2) << 60; // 90deg
+    result = swap ? (quarter - result) : result; // [0, 2]
+    result = (x.repr < 0) ? (2 * quarter - result) : result; // [0, 4]
+    result = (y.repr < 0) ? -result : result; // [-4, 4]
+    return result;
+}
+
+FIX64_MATH_DEF fix64_t fix64_atan2(fix64_t y, fix64_t x) {
+    int64_t result;
+    int64_t octants = fix64_impl_trig_atan2_octants(y, x); // Q3.60
+    fix64_impl_mul_i64_u64_i128(octants, FIX64_IMPL_TRIG_PI_4, &result); // Q3.60
+
+    // Round to Q31.32
+    result += (INT64_C(1) << (60 - FIX64_FRAC_BITS - 1));
+    result >>= (60 - FIX64_FRAC_BITS); // Q31.32
+    return (fix64_t){ result };
+}
+
+FIX64_MATH_DEF fix64_t fix64_atan2_turns(fix64_t y, fix64_t x) {
+    // 1 octant = 1/8 turn, so Q3.60 octants = Q0.63 turns
+    int64_t result = fix64_impl_trig_atan2_octants(y, x);
+
+    // Round to Q31.32
+    result += (INT64_C(1) << (63 - FIX64_FRAC_BITS - 1));
+    result >>= (63 - FIX64_FRAC_BITS); // Q31.32
+    return (fix64_t){ result };
+}
+
+FIX64_MATH_DEF fix64_t fix64_atan2_deg(fix64_t y, fix64_t x) {
+    // 1 octant = 45deg
+    int64_t result_hi;
+    int64_t octants = fix64_impl_trig_atan2_octants(y, x); // Q3.60
+    uint64_t result_lo = fix64_impl_mul_i64_u64_i128(octants, 45, &result_hi);
+
+    // Round to Q31.32
+    result_lo = fix64_impl_add_i128(
+        result_hi, result_lo, 0, UINT64_C(1) << (60 - FIX64_FRAC_BITS - 1), &result_hi);
+    uint64_t result = ((uint64_t)result_hi << (64 - (60 - FIX64_FRAC_BITS))) |
+        (result_lo >> (60 - FIX64_FRAC_BITS)); // Q31.32
+    return (fix64_t){ (int64_t)result };
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fix64.h"
+
+//==========================================================
+// Polynomial evaluation
+//==========================================================
+
+/// Evaluation schemes for fix64_poly_t
+typedef enum {
+    /// Horner's method, which uses the fewest multiplications. Best for throughput, e.g. with
+    /// fix64_poly_eval_batch
+    FIX64_POLY_HORNER,
+    /// Estrin's scheme for blocks of 4 coefficients, which are combined with Horner's method. This
+    /// uses more multiplications but has a shorter dependency chain, so it has lower latency
+    FIX64_POLY_ESTRIN,
+} fix64_poly_method_t;
+
+/// A polynomial p(t) = coefs[0] + coefs[1] * t + ... + coefs[n - 1] * t^(n - 1) over an interval
+/// [lo, hi] of x which is mapped onto t in [0, 1].
+///
+/// Like the library's own Chebyshev approximations, t is evaluated as a UQ0.64 and the polynomial
+/// is accumulated with as many fractional bits as the coefficients allow (62 if the sum of their
+/// magnitudes is below 1, i.e. a Q1.62). The result is only rounded to a fix64_t at the end, so
+/// it's much more accurate than evaluating with fix64_mul and fix64_add.
+typedef struct {
+    const fix64_t *coefs; ///< The coefficients, lowest degree first
+    size_t n; ///< The number of coefficients
+    fix64_t lo; ///< The start of the interval, i.e. where t = 0
+    uint64_t recip; ///< Reciprocal of the normalised interval width as a UQ1.63
+    unsigned recip_shift; ///< Shift which converts (x - lo) * recip to a UQ0.64
+    unsigned frac_bits; ///< Number of fractional bits used for the evaluation
+    fix64_poly_method_t method; ///< The evaluation scheme
+} fix64_poly_t;
+
+/// Prepares a polynomial for evaluation with fix64_poly_eval. The coefficients aren't copied, so
+/// they must outlive the polynomial.
+///
+/// @param poly the polynomial to initialise
+/// @param coefs array of n coefficients, lowest degree first
+/// @param n the number of coefficients
+/// @param lo the start of the interval, which is mapped to t = 0
+/// @param hi the end of the interval, which is mapped to t = 1
+/// @param method the evaluation scheme
+/// @return 0 on success, or -1 if n is 0, lo >= hi or the coefficients are too large
+int fix64_poly_init(fix64_poly_t *poly, const fix64_t *coefs, size_t n, fix64_t lo, fix64_t hi,
+    fix64_poly_method_t method);
+
+/// Evaluates a polynomial at x, i.e. p((x - lo) / (hi - lo)). Values of x outside [lo, hi] are
+/// clamped to the interval. The result saturates if it's out of range
+///
+/// @param poly a polynomial created by fix64_poly_init
+/// @param x the value to evaluate the polynomial at
+/// @return the value of the polynomial
+fix64_t fix64_poly_eval(const fix64_poly_t *poly, fix64_t x);
+
+/// Evaluates a polynomial at each element of an array, giving identical results to
+/// fix64_poly_eval. The evaluations are independent, so they can overlap with each other
+///
+/// @param poly a polynomial created by fix64_poly_init
+/// @param xs array of count values to evaluate the polynomial at
+/// @param ys array of count results, which may be the same as xs
+/// @param count the number of values
+void fix64_poly_eval_batch(
+    const fix64_poly_t *poly, const fix64_t *xs, fix64_t *ys, size_t count);
+
+//==========================================================
+// Lookup tables
+//==========================================================
+
+/// A table of polynomials over consecutive intervals of equal width, which are usually generated
+/// at build time by the lut() function in scripts/lut.py (see scripts/lut.jinja).
+///
+/// Each interval's width is a power of 2 (as a repr), so the interval containing x is found with
+/// a shift. Its polynomial is then evaluated with Horner's method in the same way as fix64_poly_t,
+/// i.e. with the offset into the interval as a UQ0.64 and a single rounding.
+typedef struct {
+    const int64_t *coefs; ///< order coefficients for each interval, lowest degree first
+    size_t size; ///< The number of intervals
+    unsigned order; ///< Coefficients for each interval, i.e. 2 for linear or 4 for cubic
+    unsigned frac_bits; ///< Number of fractional bits in the coefficients
+    unsigned shift; ///< log2 of the width of each interval as a repr
+    fix64_t lo; ///< The start of the first interval
+} fix64_lut_t;
+
+/// Evaluates a lookup table at x. Values of x outside the table are clamped to its first or last
+/// interval. The result saturates if it's out of range
+///
+/// @param lut the lookup table
+/// @param x the value to evaluate the table at
+/// @return the interpolated value
+fix64_t fix64_lut_eval(const fix64_lut_t *lut, fix64_t x);
+
+/// Evaluates a lookup table at each element of an array, giving identical results to
+/// fix64_lut_eval
+///
+/// @param lut the lookup table
+/// @param xs array of count values to evaluate the table at
+/// @param ys array of count results, which may be the same as xs
+/// @param count the number of values
+void fix64_lut_eval_batch(const fix64_lut_t *lut, const fix64_t *xs, fix64_t *ys, size_t count);
+
+//==========================================================
+// Piecewise linear interpolation
+//==========================================================
+
+/// Number of segments required by a fix64_pwl_t with n breakpoints
+#define FIX64_PWL_SEGMENTS(n) (n)
+
+/// Segment of a fix64_pwl_t, which starts at a breakpoint and ends at the next one
+typedef struct {
+    fix64_t x; ///< The breakpoint at the start of the segment
+    fix64_t y; ///< The value at the breakpoint
+    uint64_t recip; ///< Reciprocal of the normalised segment width as a UQ1.63
+    unsigned recip_shift; ///< Shift which converts (x - start) * recip to a UQ0.64
+} fix64_pwl_segment_t;
+
+/// Piecewise linear interpolation between sorted (x, y) breakpoints, e.g. a calibration curve.
+///
+/// Each segment's reciprocal width is precomputed, so evaluation doesn't need a division: the
+/// offset into the segment is mapped onto t in [0, 1) as a UQ0.64 like fix64_poly_t, and the
+/// result y0 + t * (y1 - y0) is rounded once. The segment is found with a branchless binary
+/// search, and fix64_pwl_eval_batch searches outwards from the previous segment instead, so
+/// sorted or nearly sorted queries only touch a few segments each.
+typedef struct {
+    const fix64_pwl_segment_t *segments; ///< The segments, one for each breakpoint
+    size_t n; ///< The number of breakpoints
+} fix64_pwl_t;
+
+/// Prepares a piecewise linear interpolation. The segments are stored in a caller provided
+/// buffer, which must outlive the interpolation, while the breakpoints are copied.
+///
+/// @param pwl the interpolation to initialise
+/// @param segments buffer of at least FIX64_PWL_SEGMENTS(n) elements
+/// @param xs array of n breakpoints, which must be strictly increasing
+/// @param ys array of n values at the breakpoints
+/// @param n the number of breakpoints
+/// @return 0 on success, or -1 if n is 0 or the breakpoints aren't strictly increasing
+int fix64_pwl_init(fix64_pwl_t *pwl, fix64_pwl_segment_t *segments, const fix64_t *xs,
+    const fix64_t *ys, size_t n);
+
+/// Evaluates a piecewise linear interpolation at x. Values of x outside the breakpoints are
+/// clamped to the first or last breakpoint. The result is exact at the breakpoints, and is
+/// otherwise within FIX64_EPSILON of the exact interpolation unless adjacent values differ by
+/// more than 2^29 (and within 5 FIX64_EPSILON regardless)
+///
+/// @param pwl an interpolation created by fix64_pwl_init
+/// @param x the value to evaluate the interpolation at
+/// @return the interpolated value
+fix64_t fix64_pwl_eval(const fix64_pwl_t *pwl, fix64_t x);
+
+/// Evaluates a piecewise linear interpolation at each element of an array, giving identical
+/// results to fix64_pwl_eval. Each search starts from the previous element's segment, so this is
+/// fastest when xs is sorted or nearly sorted
+///
+/// @param pwl an interpolation created by fix64_pwl_init
+/// @param xs array of count values to evaluate the interpolation at
+/// @param ys array of count results, which may be the same as xs
+/// @param count the number of values
+void fix64_pwl_eval_batch(const fix64_pwl_t *pwl, const fix64_t *xs, fix64_t *ys, size_t count);
+
+//==========================================================
+// Splines
+//==========================================================
+
+/// Number of segments required by a fix64_spline_t with n breakpoints
+#define FIX64_SPLINE_SEGMENTS(n) (n)
+
+/// Segment of a fix64_spline_t, which starts at a breakpoint and ends at the next one
+typedef struct {
+    fix64_t x; ///< The breakpoint at the start of the segment
+    uint64_t recip; ///< Reciprocal of the normalised segment width as a UQ1.63
+    unsigned recip_shift; ///< Shift which converts (x - start) * recip to a UQ0.64
+    unsigned frac_bits; ///< Number of fractional bits in the coefficients
+    int64_t coefs[4]; ///< The cubic's coefficients in t, lowest degree first
+} fix64_spline_segment_t;
+
+/// Piecewise cubic interpolation between sorted (x, y) breakpoints, where the curve and its first
+/// derivative are continuous.
+///
+/// Each segment is a cubic Hermite polynomial in t in [0, 1), which matches the values and slopes
+/// at both of its breakpoints, with coefficients precomputed in the most precise fixed point
+/// format for that segment. So evaluation finds the segment like fix64_pwl_t, then uses Horner's
+/// method with t as a UQ0.64 and rounds once, without any divisions.
+typedef struct {
+    const fix64_spline_segment_t *segments; ///< The segments, one for each breakpoint
+    size_t n; ///< The number of breakpoints
+} fix64_spline_t;
+
+/// Prepares a natural cubic spline, which also has a continuous second derivative, and a second
+/// derivative of zero at the ends. The slopes at the breakpoints are found by solving a
+/// tridiagonal system with 128-bit intermediates. The segments are stored in a caller provided
+/// buffer, which must outlive the spline, while the breakpoints are copied.
+///
+/// @param spline the spline to initialise
+/// @param segments buffer of at least FIX64_SPLINE_SEGMENTS(n) elements
+/// @param xs array of n breakpoints, which must be strictly increasing
+/// @param ys array of n values at the breakpoints
+/// @param n the number of breakpoints
+/// @return 0 on success, or -1 if n is 0, the breakpoints aren't strictly increasing or the
+/// coefficients are too large
+int fix64_spline_init_natural(fix64_spline_t *spline, fix64_spline_segment_t *segments,
+    const fix64_t *xs, const fix64_t *ys, size_t n);
+
+/// Prepares a monotone cubic spline, which doesn't overshoot: it's monotonic wherever the
+/// breakpoints are, and has no extrema between breakpoints. The slopes are chosen with the
+/// Fritsch-Carlson method, i.e. averages of the adjacent secants, which are limited to 3 times
+/// the secants (and zero at local extrema). Otherwise the same as fix64_spline_init_natural.
+///
+/// @param spline the spline to initialise
+/// @param segments buffer of at least FIX64_SPLINE_SEGMENTS(n) elements
+/// @param xs array of n breakpoints, which must be strictly increasing
+/// @param ys array of n values at the breakpoints
+/// @param n the number of breakpoints
+/// @return 0 on success, or -1 if n is 0, the breakpoints aren't strictly increasing or the
+/// coefficients are too large
+int fix64_spline_init_monotone(fix64_spline_t *spline, fix64_spline_segment_t *segments,
+    const fix64_t *xs, const fix64_t *ys, size_t n);
+
+/// Prepares a cubic Hermite spline with the given slopes at the breakpoints. Otherwise the same as
+/// fix64_spline_init_natural.
+///
+/// @param spline the spline to initialise
+/// @param segments buffer of at least FIX64_SPLINE_SEGMENTS(n) elements
+/// @param xs array of n breakpoints, which must be strictly increasing
+/// @param ys array of n values at the breakpoints
+/// @param slopes array of n slopes (dy / dx) at the breakpoints
+/// @param n the number of breakpoints
+/// @return 0 on success, or -1 if n is 0, the breakpoints aren't strictly increasing or the
+/// coefficients are too large
+int fix64_spline_init_hermite(fix64_spline_t *spline, fix64_spline_segment_t *segments,
+    const fix64_t *xs, const fix64_t *ys, const fix64_t *slopes, size_t n);
+
+/// Evaluates a spline at x. Values of x outside the breakpoints are clamped to the first or last
+/// breakpoint. The result saturates if it's out of range
+///
+/// @param spline a spline created by one of the fix64_spline_init functions
+/// @param x the value to evaluate the spline at
+/// @return the interpolated value
+fix64_t fix64_spline_eval(const fix64_spline_t *spline, fix64_t x);
+
+/// Evaluates a spline at each element of an array, giving identical results to fix64_spline_eval.
+/// Like fix64_pwl_eval_batch, this is fastest when xs is sorted or nearly sorted
+///
+/// @param spline a spline created by one of the fix64_spline_init functions
+/// @param xs array of count values to evaluate the spline at
+/// @param ys array of count results, which may be the same as xs
+/// @param count the number of values
+void fix64_spline_eval_batch(
+    const fix64_spline_t *spline, const fix64_t *xs, fix64_t *ys, size_t count);
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fix64.h"
+
+//==========================================================
+// Random number generation
+//==========================================================
+
+/// State of a xoshiro256** pseudorandom number generator. Initialise it with fix64_rng_seed, or
+/// set the state directly to any value other than all zeros. The sequence is identical on every
+/// platform, which makes it suitable for deterministic simulations.
+///
+/// A generator isn't thread safe, so each thread should use its own stream from fix64_rng_split.
+typedef struct {
+    uint64_t state[4]; ///< The generator's state
+} fix64_rng_t;
+
+/// Seeds a generator by expanding a 64-bit seed with SplitMix64, as recommended by the authors of
+/// xoshiro256**
+///
+/// @param rng the generator to seed
+/// @param seed the seed, any value is allowed
+void fix64_rng_seed(fix64_rng_t *rng, uint64_t seed);
+
+/// Advances a generator by 2^128 steps, i.e. the equivalent of 2^128 calls to fix64_rng_next
+///
+/// @param rng the generator
+void fix64_rng_jump(fix64_rng_t *rng);
+
+/// Splits off an independent stream from a generator. The stream continues from the generator's
+/// current state and the generator jumps ahead 2^128 steps, so up to 2^128 streams split from the
+/// same generator never overlap unless more than 2^128 numbers are drawn from one of them.
+///
+/// @param rng the generator to split, which is advanced
+/// @param stream set to the new stream
+void fix64_rng_split(fix64_rng_t *rng, fix64_rng_t *stream);
+
+// Rotates left by k, where 0 < k < 64
+static inline uint64_t fix64_impl_rotl64(uint64_t x, unsigned k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/// Generates 64 uniformly distributed random bits
+///
+/// @param rng the generator
+/// @return the random bits
+static inline uint64_t fix64_rng_next(fix64_rng_t *rng) {
+    uint64_t *s = rng->state;
+    uint64_t result = fix64_impl_rotl64(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = fix64_impl_rotl64(s[3], 45);
+
+    return result;
+}
+
+/// Generates a uniformly distributed random number in [0, 1), where every multiple of
+/// FIX64_EPSILON is equally likely
+///
+/// @param rng the generator
+/// @return the random number
+static inline fix64_t fix64_rng_uniform(fix64_rng_t *rng) {
+    return (fix64_t){ (int64_t)(fix64_rng_next(rng) >> (64 - FIX64_FRAC_BITS)) };
+}
+
+/// Generates a uniformly distributed random number in [lo, hi). The bias is at most
+/// (hi - lo) / 2^64 FIX64_EPSILON, which is negligible.
+///
+/// @param rng the generator
+/// @param lo the lower bound
+/// @param hi the upper bound, which must be greater than lo
+/// @return the random number
+static inline fix64_t fix64_rng_uniform_range(fix64_rng_t *rng, fix64_t lo, fix64_t hi) {
+    // Scale the random bits by the width as a UQ0.64, which can't overflow
+    uint64_t width = (uint64_t)hi.repr - (uint64_t)lo.repr;
+    uint64_t offset;
+    fix64_impl_mul_u64_u128(fix64_rng_next(rng), width, &offset);
+    return (fix64_t){ (int64_t)((uint64_t)lo.repr + offset) };
+}
+
+/// Generates a random number from the standard normal distribution, i.e. with a mean of 0 and a
+/// standard deviation of 1, using the ziggurat method. Most numbers only take one call to
+/// fix64_rng_next and a multiplication, and the rest use fix64_exp or fix64_log.
+///
+/// @param rng the generator
+/// @return the random number
+fix64_t fix64_rng_normal(fix64_rng_t *rng);
+
+/// Generates a random number from the exponential distribution with a rate (and mean) of 1, using
+/// the ziggurat method. Divide by the rate for other distributions.
+///
+/// @param rng the generator
+/// @return the random number
+fix64_t fix64_rng_exponential(fix64_rng_t *rng);
+
+/// Fills an array with fix64_rng_uniform
+///
+/// @param rng the generator
+/// @param out array of count results
+/// @param count the number of elements
+void fix64_rng_uniform_batch(fix64_rng_t *rng, fix64_t *out, size_t count);
+
+/// Fills an array with fix64_rng_normal
+///
+/// @param rng the generator
+/// @param out array of count results
+/// @param count the number of elements
+void fix64_rng_normal_batch(fix64_rng_t *rng, fix64_t *out, size_t count);
+
+/// Fills an array with fix64_rng_exponential
+///
+/// @param rng the generator
+/// @param out array of count results
+/// @param count the number of elements
+void fix64_rng_exponential_batch(fix64_rng_t *rng, fix64_t *out, size_t count);
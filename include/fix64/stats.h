@@ -0,0 +1,272 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fix64.h"
+#include "fix64/fix128.h"
+#include "fix64/impl.h"
+
+//==========================================================
+// Reductions
+//==========================================================
+
+// The reductions below accumulate in 128-bit (or wider) integers, so there's no intermediate
+// saturation or rounding. Integer addition is associative, so the results don't depend on the
+// order of the elements: summing the halves of an array separately and adding the partial sums
+// (with fix128_add) gives exactly the same result as one serial pass, and each result is rounded
+// only once at the end
+
+/// Sum of an array. The sum is exact and then saturates if it's out of range
+///
+/// @param xs array of count elements
+/// @param count the number of elements
+/// @return the sum of the elements, or zero if count is 0
+fix64_t fix64_array_sum(const fix64_t *xs, size_t count);
+
+/// Sum of an array as a fix128_t, which is exact unless there are more than 2^32 elements. This
+/// can be used to combine partial sums of parts of an array
+///
+/// @param xs array of count elements
+/// @param count the number of elements
+/// @return the sum of the elements, or zero if count is 0
+fix128_t fix64_array_sum_fix128(const fix64_t *xs, size_t count);
+
+/// Arithmetic mean of an array, with halfway values rounded away from zero like fix64_div
+///
+/// @param xs array of count elements
+/// @param count the number of elements
+/// @return the mean of the elements, or zero if count is 0
+fix64_t fix64_array_mean(const fix64_t *xs, size_t count);
+
+/// Minimum of an array
+///
+/// @param xs array of count elements
+/// @param count the number of elements
+/// @return the smallest element, or FIX64_MAX if count is 0
+fix64_t fix64_array_min(const fix64_t *xs, size_t count);
+
+/// Maximum of an array
+///
+/// @param xs array of count elements
+/// @param count the number of elements
+/// @return the largest element, or FIX64_MIN if count is 0
+fix64_t fix64_array_max(const fix64_t *xs, size_t count);
+
+/// Index of the minimum of an array
+///
+/// @param xs array of count elements
+/// @param count the number of elements
+/// @return the index of the first smallest element, or 0 if count is 0
+size_t fix64_array_argmin(const fix64_t *xs, size_t count);
+
+/// Index of the maximum of an array
+///
+/// @param xs array of count elements
+/// @param count the number of elements
+/// @return the index of the first largest element, or 0 if count is 0
+size_t fix64_array_argmax(const fix64_t *xs, size_t count);
+
+/// Population variance of an array, i.e. the mean of the squared differences from the mean. The
+/// mean and squares aren't rounded, so the result is the exact variance rounded to nearest (with
+/// halfway values rounded up), and it saturates if it's out of range
+///
+/// @param xs array of count elements
+/// @param count the number of elements
+/// @return the variance of the elements, or zero if count is 0
+fix64_t fix64_array_variance(const fix64_t *xs, size_t count);
+
+/// L1 norm of an array, i.e. the sum of the absolute values of the elements. The sum is exact and
+/// then saturates if it's out of range
+///
+/// @param xs array of count elements
+/// @param count the number of elements
+/// @return the L1 norm of the elements
+fix64_t fix64_array_norm1(const fix64_t *xs, size_t count);
+
+/// L2 (Euclidean) norm of an array, i.e. the square root of the sum of the squares of the
+/// elements. This is the exact norm rounded to nearest, and it saturates if it's out of range
+///
+/// @param xs array of count elements
+/// @param count the number of elements
+/// @return the L2 norm of the elements
+fix64_t fix64_array_norm2(const fix64_t *xs, size_t count);
+
+//==========================================================
+// Online statistics
+//==========================================================
+
+/// Exponential moving average, i.e. value = alpha * x + (1 - alpha) * value for each new x. The
+/// average is kept with 32 more fractional bits than a fix64_t, so it still converges when alpha
+/// is small.
+typedef struct {
+    fix128_t value; ///< The current average
+    uint64_t decay; ///< 1 - alpha as a UQ0.64
+    int started; ///< Whether any values have been pushed, since the first one sets the average
+} fix64_ema_t;
+
+/// Initialises an exponential moving average with a smoothing factor alpha
+///
+/// @param ema the moving average to initialise
+/// @param alpha the weight of each new value, in (0, 1]
+/// @return 0 on success, or -1 if alpha isn't in (0, 1]
+int fix64_ema_init(fix64_ema_t *ema, fix64_t alpha);
+
+/// Initialises an exponential moving average with the smoothing factor alpha = 2 / (span + 1),
+/// which gives the same centre of mass as a simple moving average of span values
+///
+/// @param ema the moving average to initialise
+/// @param span the span, which must be at least 1
+/// @return 0 on success, or -1 if span is 0
+int fix64_ema_init_span(fix64_ema_t *ema, size_t span);
+
+/// Adds a value to an exponential moving average
+///
+/// @param ema the moving average
+/// @param x the new value
+/// @return the new average, rounded to nearest
+static inline fix64_t fix64_ema_push(fix64_ema_t *ema, fix64_t x) {
+    if (FIX64_UNLIKELY(!ema->started || ema->decay == 0)) {
+        ema->started = 1;
+        ema->value = fix128_from_fix64(x);
+        return x;
+    }
+
+    // decay * value, rounded down
+    int64_t hi, x_hi;
+    uint64_t lo_hi;
+    uint64_t lo = fix64_impl_mul_i64_u64_i128(ema->value.hi, ema->decay, &hi);
+    fix64_impl_mul_u64_u128(ema->value.lo, ema->decay, &lo_hi);
+    lo = fix64_impl_add_i128(hi, lo, 0, lo_hi, &hi);
+
+    // alpha * x, where alpha = 2^64 - decay as a UQ0.64. The product has 96 fractional bits, and
+    // since the sum is a weighted average of the two values it can't overflow
+    uint64_t x_lo = fix64_impl_mul_i64_u64_i128(x.repr, UINT64_C(0) - ema->decay, &x_hi);
+    uint64_t ax_lo = ((uint64_t)x_hi << (64 - FIX64_FRAC_BITS)) | (x_lo >> FIX64_FRAC_BITS);
+    ema->value.lo = fix64_impl_add_i128(hi, lo, x_hi >> FIX64_FRAC_BITS, ax_lo, &ema->value.hi);
+    return fix128_to_fix64(ema->value);
+}
+
+/// Adds an array of values to an exponential moving average, giving identical results to
+/// fix64_ema_push for each element
+///
+/// @param ema the moving average
+/// @param xs array of count values to add, in order
+/// @param out array of count results, which are the average after each value, or NULL
+/// @param count the number of values
+void fix64_ema_push_block(fix64_ema_t *ema, const fix64_t *xs, fix64_t *out, size_t count);
+
+/// Rolling sum, mean and variance over the last window values of a stream. The sums are exact
+/// 128-bit (or 192-bit for squares) integers, so values leaving the window are subtracted without
+/// any drift, and the results are identical to fix64_array_sum, fix64_array_mean and
+/// fix64_array_variance over the same values.
+typedef struct {
+    fix64_t *values; ///< Ring buffer of the values in the window
+    size_t window; ///< The size of the window
+    size_t count; ///< The number of values in the window, which is at most window
+    size_t head; ///< Index of the oldest value in the ring buffer
+    int64_t sum_hi; ///< The sum of the values' representations (upper 64 bits)
+    uint64_t sum_lo; ///< The sum of the values' representations (lower 64 bits)
+    uint64_t sum_sq[3]; ///< The sum of the squares of the representations, most significant first
+} fix64_rolling_t;
+
+/// Initialises a rolling window. The values are stored in a caller provided buffer, which must
+/// outlive the window.
+///
+/// @param roll the rolling window to initialise
+/// @param values buffer of at least window elements
+/// @param window the number of values in the window
+/// @return 0 on success, or -1 if window is 0
+int fix64_rolling_init(fix64_rolling_t *roll, fix64_t *values, size_t window);
+
+/// Adds a value to a rolling window, removing the oldest value if the window is full. This takes
+/// constant time
+///
+/// @param roll the rolling window
+/// @param x the new value
+void fix64_rolling_push(fix64_rolling_t *roll, fix64_t x);
+
+/// Adds an array of values to a rolling window, like calling fix64_rolling_push for each of them
+///
+/// @param roll the rolling window
+/// @param xs array of count values to add, in order
+/// @param count the number of values
+void fix64_rolling_push_block(fix64_rolling_t *roll, const fix64_t *xs, size_t count);
+
+/// Sum of the values in a rolling window, which saturates if it's out of range
+///
+/// @param roll the rolling window
+/// @return the sum, or zero if the window is empty
+fix64_t fix64_rolling_sum(const fix64_rolling_t *roll);
+
+/// Mean of the values in a rolling window, with halfway values rounded away from zero
+///
+/// @param roll the rolling window
+/// @return the mean, or zero if the window is empty
+fix64_t fix64_rolling_mean(const fix64_rolling_t *roll);
+
+/// Population variance of the values in a rolling window, which is the exact variance rounded to
+/// nearest and saturates if it's out of range. This takes constant time
+///
+/// @param roll the rolling window
+/// @return the variance, or zero if the window is empty
+fix64_t fix64_rolling_variance(const fix64_rolling_t *roll);
+
+/// Number of entries required by a fix64_rolling_minmax_t for a window of the given size
+#define FIX64_ROLLING_MINMAX_ENTRIES(window) (2 * (window))
+
+/// Entry of the monotonic queues used by fix64_rolling_minmax_t
+typedef struct {
+    fix64_t value; ///< The value
+    uint64_t index; ///< The position of the value in the stream
+} fix64_rolling_entry_t;
+
+/// Rolling minimum and maximum over the last window values of a stream. Each is kept in a
+/// monotonic queue, which only holds values that can still become the minimum or maximum, so
+/// pushing a value takes amortised constant time.
+typedef struct {
+    fix64_rolling_entry_t *entries; ///< Ring buffers for the minimum and maximum queues
+    size_t window; ///< The size of the window
+    uint64_t next; ///< The position of the next value in the stream
+    size_t min_head; ///< Index of the front of the minimum queue
+    size_t min_len; ///< Length of the minimum queue
+    size_t max_head; ///< Index of the front of the maximum queue
+    size_t max_len; ///< Length of the maximum queue
+} fix64_rolling_minmax_t;
+
+/// Initialises a rolling minimum and maximum. The queues are stored in a caller provided buffer,
+/// which must outlive the window.
+///
+/// @param roll the rolling window to initialise
+/// @param entries buffer of at least FIX64_ROLLING_MINMAX_ENTRIES(window) elements
+/// @param window the number of values in the window
+/// @return 0 on success, or -1 if window is 0
+int fix64_rolling_minmax_init(
+    fix64_rolling_minmax_t *roll, fix64_rolling_entry_t *entries, size_t window);
+
+/// Adds a value to a rolling minimum and maximum, removing the oldest value if the window is full
+///
+/// @param roll the rolling window
+/// @param x the new value
+void fix64_rolling_minmax_push(fix64_rolling_minmax_t *roll, fix64_t x);
+
+/// Adds an array of values to a rolling minimum and maximum, like calling
+/// fix64_rolling_minmax_push for each of them
+///
+/// @param roll the rolling window
+/// @param xs array of count values to add, in order
+/// @param count the number of values
+void fix64_rolling_minmax_push_block(
+    fix64_rolling_minmax_t *roll, const fix64_t *xs, size_t count);
+
+/// Minimum of the values in a rolling window
+///
+/// @param roll the rolling window
+/// @return the minimum, or FIX64_MAX if the window is empty
+fix64_t fix64_rolling_min(const fix64_rolling_minmax_t *roll);
+
+/// Maximum of the values in a rolling window
+///
+/// @param roll the rolling window
+/// @return the maximum, or FIX64_MIN if the window is empty
+fix64_t fix64_rolling_max(const fix64_rolling_minmax_t *roll);
@@ -100,3 +100,68 @@ static inline size_t fix64_to_hex(char *buf, fix64_t val, size_t size) {
     fix64_fmt_param_t fmt = { .decimals = 4, .base = FIX64_BASE_HEXADECIMAL };
     return fix64_to_str_fmt(buf, val, size, fmt);
 }
+
+/// Converts a string to a fix64_t value. The string consists of an optional sign followed by
+/// decimal digits with an optional decimal point, for example "-12.375", "5." or ".5". No leading
+/// whitespace is skipped. At most `size` characters are read, so the string does not need to be
+/// nul-terminated. The result is rounded to the nearest representable value, with halfway values
+/// rounded away from zero (the same as FIX64_C and fix64_to_str_fmt). Values outside of fix64_t's
+/// range are saturated. The result is correctly rounded regardless of the number of digits.
+///
+/// @param str the string to parse
+/// @param size the maximum number of characters to read
+/// @param value the parsed value is written here. Not written if no number could be parsed
+/// @return the number of characters parsed, or 0 if the string doesn't start with a number
+size_t fix64_from_str(const char *str, size_t size, fix64_t *value);
+
+/// Enum of the possible status codes for each row parsed by fix64_from_str_column
+enum {
+    FIX64_PARSE_OK, ///< The field was parsed successfully
+    FIX64_PARSE_EMPTY, ///< The field was empty, or the row doesn't have enough fields
+    FIX64_PARSE_INVALID, ///< The field contains something other than a single number
+};
+
+/// Parses one column of delimited text (e.g. CSV) into an array of fix64_t values. Each line of
+/// the buffer is one row, terminated with "\n" or "\r\n" (the last line doesn't need a terminator).
+/// Fields are separated by `delim` and parsed with the same rules as fix64_from_str; quoted fields
+/// are not supported. Rows which fail to parse are written as FIX64_ZERO and their status is set,
+/// parsing continues with the next row.
+///
+/// Parsing stops once `count` rows have been written. The number of characters consumed is written
+/// to `consumed` (if not NULL) so the remainder of the buffer can be parsed with another call.
+///
+/// The buffer can also be split into chunks with fix64_str_next_line which are then parsed
+/// independently, for example by separate threads.
+///
+/// @param values array of at least `count` values the parsed rows are written to
+/// @param status array of at least `count` status codes (one of the FIX64_PARSE_* constants) for
+/// each row, or NULL if not required
+/// @param count the maximum number of rows to parse
+/// @param buf the buffer to parse
+/// @param size the size of the buffer
+/// @param delim the delimiter between fields, e.g. ','
+/// @param column the index of the field to parse in each row, starting at 0
+/// @param consumed the number of characters consumed is written here, unless it is NULL
+/// @return the number of rows parsed
+size_t fix64_from_str_column(
+    fix64_t *values, unsigned char *status, size_t count, const char *buf, size_t size, char delim,
+    size_t column, size_t *consumed);
+
+/// Finds the start of the line following a given offset in a buffer, for splitting a buffer into
+/// chunks at line boundaries for use with fix64_from_str_column.
+///
+/// @param buf the buffer to search
+/// @param size the size of the buffer
+/// @param offset the offset to start searching at
+/// @return the offset of the first character after the next "\n", or size if there isn't one
+size_t fix64_str_next_line(const char *buf, size_t size, size_t offset);
+
+// Implementations of the string conversions for any number of fractional bits (between 1 and 63),
+// used by the other fixed point formats in fix64/qformat.h. Numbers are given by their sign and
+// magnitude, and parsed magnitudes saturate at max_pos or max_neg depending on the sign
+size_t fix64_impl_to_str_fmt_q(
+    char *buf, int negative, uint64_t mag, unsigned frac_bits, size_t size,
+    fix64_fmt_param_t fmt);
+size_t fix64_impl_from_str_q(
+    const char *str, size_t size, unsigned frac_bits, uint64_t max_pos, uint64_t max_neg,
+    uint64_t *mag, int *negative);
@@ -0,0 +1,633 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fix64.h"
+#include "fix64/impl.h"
+
+//==========================================================
+// Vector, matrix and quaternion types
+//==========================================================
+
+/// 2D vector of fix64_t
+typedef struct {
+    fix64_t x; ///< x component
+    fix64_t y; ///< y component
+} fix64_vec2_t;
+
+/// 3D vector of fix64_t
+typedef struct {
+    fix64_t x; ///< x component
+    fix64_t y; ///< y component
+    fix64_t z; ///< z component
+} fix64_vec3_t;
+
+/// 4D vector of fix64_t
+typedef struct {
+    fix64_t x; ///< x component
+    fix64_t y; ///< y component
+    fix64_t z; ///< z component
+    fix64_t w; ///< w component
+} fix64_vec4_t;
+
+/// 3x3 matrix of fix64_t, stored in row-major order (i.e. m[row][column])
+typedef struct {
+    fix64_t m[3][3]; ///< The matrix elements
+} fix64_mat3_t;
+
+/// 4x4 matrix of fix64_t, stored in row-major order (i.e. m[row][column])
+typedef struct {
+    fix64_t m[4][4]; ///< The matrix elements
+} fix64_mat4_t;
+
+/// Quaternion w + xi + yj + zk of fix64_t
+typedef struct {
+    fix64_t w; ///< Real part
+    fix64_t x; ///< i part
+    fix64_t y; ///< j part
+    fix64_t z; ///< k part
+} fix64_quat_t;
+
+//==========================================================
+// Accumulation
+//==========================================================
+
+// Q62.64 accumulator for sums of products, which are rounded once at the end. Overflow wraps, so
+// the rounded result is the same as the true result modulo 2^64 like fix64_mul
+typedef struct {
+    int64_t hi;
+    uint64_t lo;
+} fix64_vec_impl_acc_t;
+
+// Creates an accumulator with the initial value arg
+static inline fix64_vec_impl_acc_t fix64_vec_impl_acc(fix64_t arg) {
+    fix64_vec_impl_acc_t acc;
+    acc.hi = arg.repr >> (64 - FIX64_FRAC_BITS);
+    acc.lo = (uint64_t)arg.repr << FIX64_FRAC_BITS;
+    return acc;
+}
+
+// acc += lhs * rhs
+static inline void fix64_vec_impl_mac(fix64_vec_impl_acc_t *acc, fix64_t lhs, fix64_t rhs) {
+    int64_t hi;
+    uint64_t lo = fix64_impl_mul_i64_i128(lhs.repr, rhs.repr, &hi);
+    acc->lo = fix64_impl_add_i128(acc->hi, acc->lo, hi, lo, &acc->hi);
+}
+
+// acc -= lhs * rhs
+static inline void fix64_vec_impl_msub(fix64_vec_impl_acc_t *acc, fix64_t lhs, fix64_t rhs) {
+    int64_t hi;
+    uint64_t lo = fix64_impl_mul_i64_i128(lhs.repr, rhs.repr, &hi);
+    acc->lo = fix64_impl_sub_i128(acc->hi, acc->lo, hi, lo, &acc->hi);
+}
+
+// Rounds the accumulator to a fix64_t, with halfway values rounded up like fix64_mul
+static inline fix64_t fix64_vec_impl_round(fix64_vec_impl_acc_t acc) {
+    int64_t hi;
+    // For rounding
+    uint64_t lo = fix64_impl_add_i128(acc.hi, acc.lo, 0, (1ull << (FIX64_FRAC_BITS - 1)), &hi);
+    int64_t result = (hi << (64 - FIX64_FRAC_BITS)) | (lo >> FIX64_FRAC_BITS);
+    return (fix64_t){ result };
+}
+
+//==========================================================
+// Vectors
+//==========================================================
+
+/// Creates a fix64_vec2_t from its components
+///
+/// @param x the x component
+/// @param y the y component
+/// @return the vector (x, y)
+static inline fix64_vec2_t fix64_vec2_make(fix64_t x, fix64_t y) {
+    fix64_vec2_t result;
+    result.x = x;
+    result.y = y;
+    return result;
+}
+
+/// Creates a fix64_vec3_t from its components
+///
+/// @param x the x component
+/// @param y the y component
+/// @param z the z component
+/// @return the vector (x, y, z)
+static inline fix64_vec3_t fix64_vec3_make(fix64_t x, fix64_t y, fix64_t z) {
+    fix64_vec3_t result;
+    result.x = x;
+    result.y = y;
+    result.z = z;
+    return result;
+}
+
+/// Creates a fix64_vec4_t from its components
+///
+/// @param x the x component
+/// @param y the y component
+/// @param z the z component
+/// @param w the w component
+/// @return the vector (x, y, z, w)
+static inline fix64_vec4_t fix64_vec4_make(fix64_t x, fix64_t y, fix64_t z, fix64_t w) {
+    fix64_vec4_t result;
+    result.x = x;
+    result.y = y;
+    result.z = z;
+    result.w = w;
+    return result;
+}
+
+/// Addition of two fix64_vec2_t vectors
+///
+/// @param lhs left hand side for the addition
+/// @param rhs right hand side for the addition
+/// @return the sum of the two inputs
+static inline fix64_vec2_t fix64_vec2_add(fix64_vec2_t lhs, fix64_vec2_t rhs) {
+    return fix64_vec2_make(fix64_add(lhs.x, rhs.x), fix64_add(lhs.y, rhs.y));
+}
+
+/// Addition of two fix64_vec3_t vectors
+///
+/// @param lhs left hand side for the addition
+/// @param rhs right hand side for the addition
+/// @return the sum of the two inputs
+static inline fix64_vec3_t fix64_vec3_add(fix64_vec3_t lhs, fix64_vec3_t rhs) {
+    return fix64_vec3_make(
+        fix64_add(lhs.x, rhs.x), fix64_add(lhs.y, rhs.y), fix64_add(lhs.z, rhs.z));
+}
+
+/// Addition of two fix64_vec4_t vectors
+///
+/// @param lhs left hand side for the addition
+/// @param rhs right hand side for the addition
+/// @return the sum of the two inputs
+static inline fix64_vec4_t fix64_vec4_add(fix64_vec4_t lhs, fix64_vec4_t rhs) {
+    return fix64_vec4_make(fix64_add(lhs.x, rhs.x), fix64_add(lhs.y, rhs.y),
+        fix64_add(lhs.z, rhs.z), fix64_add(lhs.w, rhs.w));
+}
+
+/// Subtraction of two fix64_vec2_t vectors
+///
+/// @param lhs left hand side for the subtraction
+/// @param rhs right hand side for the subtraction
+/// @return the difference of the two inputs
+static inline fix64_vec2_t fix64_vec2_sub(fix64_vec2_t lhs, fix64_vec2_t rhs) {
+    return fix64_vec2_make(fix64_sub(lhs.x, rhs.x), fix64_sub(lhs.y, rhs.y));
+}
+
+/// Subtraction of two fix64_vec3_t vectors
+///
+/// @param lhs left hand side for the subtraction
+/// @param rhs right hand side for the subtraction
+/// @return the difference of the two inputs
+static inline fix64_vec3_t fix64_vec3_sub(fix64_vec3_t lhs, fix64_vec3_t rhs) {
+    return fix64_vec3_make(
+        fix64_sub(lhs.x, rhs.x), fix64_sub(lhs.y, rhs.y), fix64_sub(lhs.z, rhs.z));
+}
+
+/// Subtraction of two fix64_vec4_t vectors
+///
+/// @param lhs left hand side for the subtraction
+/// @param rhs right hand side for the subtraction
+/// @return the difference of the two inputs
+static inline fix64_vec4_t fix64_vec4_sub(fix64_vec4_t lhs, fix64_vec4_t rhs) {
+    return fix64_vec4_make(fix64_sub(lhs.x, rhs.x), fix64_sub(lhs.y, rhs.y),
+        fix64_sub(lhs.z, rhs.z), fix64_sub(lhs.w, rhs.w));
+}
+
+/// Multiplication of a fix64_vec2_t vector by a scalar
+///
+/// @param lhs the vector
+/// @param rhs the scalar
+/// @return the vector with each component multiplied by rhs
+static inline fix64_vec2_t fix64_vec2_scale(fix64_vec2_t lhs, fix64_t rhs) {
+    return fix64_vec2_make(fix64_mul(lhs.x, rhs), fix64_mul(lhs.y, rhs));
+}
+
+/// Multiplication of a fix64_vec3_t vector by a scalar
+///
+/// @param lhs the vector
+/// @param rhs the scalar
+/// @return the vector with each component multiplied by rhs
+static inline fix64_vec3_t fix64_vec3_scale(fix64_vec3_t lhs, fix64_t rhs) {
+    return fix64_vec3_make(fix64_mul(lhs.x, rhs), fix64_mul(lhs.y, rhs), fix64_mul(lhs.z, rhs));
+}
+
+/// Multiplication of a fix64_vec4_t vector by a scalar
+///
+/// @param lhs the vector
+/// @param rhs the scalar
+/// @return the vector with each component multiplied by rhs
+static inline fix64_vec4_t fix64_vec4_scale(fix64_vec4_t lhs, fix64_t rhs) {
+    return fix64_vec4_make(fix64_mul(lhs.x, rhs), fix64_mul(lhs.y, rhs), fix64_mul(lhs.z, rhs),
+        fix64_mul(lhs.w, rhs));
+}
+
+/// Dot product of two fix64_vec2_t vectors. The products are summed with 128-bit intermediates and
+/// rounded once. Overflow wraps like fix64_mul
+///
+/// @param lhs left hand side for the dot product
+/// @param rhs right hand side for the dot product
+/// @return the dot product of the two inputs
+static inline fix64_t fix64_vec2_dot(fix64_vec2_t lhs, fix64_vec2_t rhs) {
+    fix64_vec_impl_acc_t acc = fix64_vec_impl_acc(FIX64_ZERO);
+    fix64_vec_impl_mac(&acc, lhs.x, rhs.x);
+    fix64_vec_impl_mac(&acc, lhs.y, rhs.y);
+    return fix64_vec_impl_round(acc);
+}
+
+/// Dot product of two fix64_vec3_t vectors. The products are summed with 128-bit intermediates and
+/// rounded once. Overflow wraps like fix64_mul
+///
+/// @param lhs left hand side for the dot product
+/// @param rhs right hand side for the dot product
+/// @return the dot product of the two inputs
+static inline fix64_t fix64_vec3_dot(fix64_vec3_t lhs, fix64_vec3_t rhs) {
+    fix64_vec_impl_acc_t acc = fix64_vec_impl_acc(FIX64_ZERO);
+    fix64_vec_impl_mac(&acc, lhs.x, rhs.x);
+    fix64_vec_impl_mac(&acc, lhs.y, rhs.y);
+    fix64_vec_impl_mac(&acc, lhs.z, rhs.z);
+    return fix64_vec_impl_round(acc);
+}
+
+/// Dot product of two fix64_vec4_t vectors. The products are summed with 128-bit intermediates and
+/// rounded once. Overflow wraps like fix64_mul
+///
+/// @param lhs left hand side for the dot product
+/// @param rhs right hand side for the dot product
+/// @return the dot product of the two inputs
+static inline fix64_t fix64_vec4_dot(fix64_vec4_t lhs, fix64_vec4_t rhs) {
+    fix64_vec_impl_acc_t acc = fix64_vec_impl_acc(FIX64_ZERO);
+    fix64_vec_impl_mac(&acc, lhs.x, rhs.x);
+    fix64_vec_impl_mac(&acc, lhs.y, rhs.y);
+    fix64_vec_impl_mac(&acc, lhs.z, rhs.z);
+    fix64_vec_impl_mac(&acc, lhs.w, rhs.w);
+    return fix64_vec_impl_round(acc);
+}
+
+/// Cross product of two fix64_vec3_t vectors. Each component is calculated with 128-bit
+/// intermediates and rounded once. Overflow wraps like fix64_mul
+///
+/// @param lhs left hand side for the cross product
+/// @param rhs right hand side for the cross product
+/// @return the cross product of the two inputs
+static inline fix64_vec3_t fix64_vec3_cross(fix64_vec3_t lhs, fix64_vec3_t rhs) {
+    fix64_vec_impl_acc_t x = fix64_vec_impl_acc(FIX64_ZERO);
+    fix64_vec_impl_acc_t y = fix64_vec_impl_acc(FIX64_ZERO);
+    fix64_vec_impl_acc_t z = fix64_vec_impl_acc(FIX64_ZERO);
+    fix64_vec_impl_mac(&x, lhs.y, rhs.z);
+    fix64_vec_impl_msub(&x, lhs.z, rhs.y);
+    fix64_vec_impl_mac(&y, lhs.z, rhs.x);
+    fix64_vec_impl_msub(&y, lhs.x, rhs.z);
+    fix64_vec_impl_mac(&z, lhs.x, rhs.y);
+    fix64_vec_impl_msub(&z, lhs.y, rhs.x);
+    return fix64_vec3_make(
+        fix64_vec_impl_round(x), fix64_vec_impl_round(y), fix64_vec_impl_round(z));
+}
+
+/// Length of a fix64_vec2_t vector, saturating at FIX64_MAX. The result is correctly rounded
+/// since it is calculated with an integer square root of the exact 128-bit squared length
+///
+/// @param arg the vector
+/// @return the length of arg
+fix64_t fix64_vec2_length(fix64_vec2_t arg);
+
+/// Length of a fix64_vec3_t vector, saturating at FIX64_MAX. The result is correctly rounded
+/// since it is calculated with an integer square root of the exact 128-bit squared length
+///
+/// @param arg the vector
+/// @return the length of arg
+fix64_t fix64_vec3_length(fix64_vec3_t arg);
+
+/// Length of a fix64_vec4_t vector, saturating at FIX64_MAX. The result is correctly rounded
+/// since it is calculated with an integer square root of the exact 128-bit squared length
+///
+/// @param arg the vector
+/// @return the length of arg
+fix64_t fix64_vec4_length(fix64_vec4_t arg);
+
+/// Scales a fix64_vec2_t vector to unit length. The reciprocal square root of the exact squared
+/// length is calculated with a few Newton iterations using only multiplications, so each
+/// component has an error of at most 1 epsilon. The zero vector is returned unchanged
+///
+/// @param arg the vector
+/// @return arg divided by its length
+fix64_vec2_t fix64_vec2_normalize(fix64_vec2_t arg);
+
+/// Scales a fix64_vec3_t vector to unit length. The reciprocal square root of the exact squared
+/// length is calculated with a few Newton iterations using only multiplications, so each
+/// component has an error of at most 1 epsilon. The zero vector is returned unchanged
+///
+/// @param arg the vector
+/// @return arg divided by its length
+fix64_vec3_t fix64_vec3_normalize(fix64_vec3_t arg);
+
+/// Scales a fix64_vec4_t vector to unit length. The reciprocal square root of the exact squared
+/// length is calculated with a few Newton iterations using only multiplications, so each
+/// component has an error of at most 1 epsilon. The zero vector is returned unchanged
+///
+/// @param arg the vector
+/// @return arg divided by its length
+fix64_vec4_t fix64_vec4_normalize(fix64_vec4_t arg);
+
+/// Compares two fix64_vec2_t vectors for equality
+///
+/// @param lhs left hand side for comparison
+/// @param rhs right hand side for comparison
+/// @return 1 if the vectors are equal, 0 otherwise
+static inline int fix64_vec2_eq(fix64_vec2_t lhs, fix64_vec2_t rhs) {
+    return (lhs.x.repr == rhs.x.repr) && (lhs.y.repr == rhs.y.repr);
+}
+
+/// Compares two fix64_vec3_t vectors for equality
+///
+/// @param lhs left hand side for comparison
+/// @param rhs right hand side for comparison
+/// @return 1 if the vectors are equal, 0 otherwise
+static inline int fix64_vec3_eq(fix64_vec3_t lhs, fix64_vec3_t rhs) {
+    return (lhs.x.repr == rhs.x.repr) && (lhs.y.repr == rhs.y.repr) && (lhs.z.repr == rhs.z.repr);
+}
+
+/// Compares two fix64_vec4_t vectors for equality
+///
+/// @param lhs left hand side for comparison
+/// @param rhs right hand side for comparison
+/// @return 1 if the vectors are equal, 0 otherwise
+static inline int fix64_vec4_eq(fix64_vec4_t lhs, fix64_vec4_t rhs) {
+    return (lhs.x.repr == rhs.x.repr) && (lhs.y.repr == rhs.y.repr) &&
+        (lhs.z.repr == rhs.z.repr) && (lhs.w.repr == rhs.w.repr);
+}
+
+//==========================================================
+// Matrices
+//==========================================================
+
+/// The 3x3 identity matrix
+///
+/// @return the identity matrix
+static inline fix64_mat3_t fix64_mat3_identity(void) {
+    fix64_mat3_t result;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            result.m[i][j] = (i == j) ? FIX64_ONE : FIX64_ZERO;
+        }
+    }
+    return result;
+}
+
+/// The 4x4 identity matrix
+///
+/// @return the identity matrix
+static inline fix64_mat4_t fix64_mat4_identity(void) {
+    fix64_mat4_t result;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            result.m[i][j] = (i == j) ? FIX64_ONE : FIX64_ZERO;
+        }
+    }
+    return result;
+}
+
+/// Transpose of a fix64_mat3_t matrix
+///
+/// @param arg the matrix
+/// @return the transpose of arg
+static inline fix64_mat3_t fix64_mat3_transpose(fix64_mat3_t arg) {
+    fix64_mat3_t result;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            result.m[i][j] = arg.m[j][i];
+        }
+    }
+    return result;
+}
+
+/// Transpose of a fix64_mat4_t matrix
+///
+/// @param arg the matrix
+/// @return the transpose of arg
+static inline fix64_mat4_t fix64_mat4_transpose(fix64_mat4_t arg) {
+    fix64_mat4_t result;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            result.m[i][j] = arg.m[j][i];
+        }
+    }
+    return result;
+}
+
+/// Multiplication of two fix64_mat3_t matrices. Each element is calculated with 128-bit
+/// intermediates and rounded once. Overflow wraps like fix64_mul
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @return the matrix product of the two inputs
+static inline fix64_mat3_t fix64_mat3_mul(const fix64_mat3_t *lhs, const fix64_mat3_t *rhs) {
+    fix64_mat3_t result;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            fix64_vec_impl_acc_t acc = fix64_vec_impl_acc(FIX64_ZERO);
+            for (int k = 0; k < 3; k++) {
+                fix64_vec_impl_mac(&acc, lhs->m[i][k], rhs->m[k][j]);
+            }
+            result.m[i][j] = fix64_vec_impl_round(acc);
+        }
+    }
+    return result;
+}
+
+/// Multiplication of two fix64_mat4_t matrices. Each element is calculated with 128-bit
+/// intermediates and rounded once. Overflow wraps like fix64_mul
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @return the matrix product of the two inputs
+static inline fix64_mat4_t fix64_mat4_mul(const fix64_mat4_t *lhs, const fix64_mat4_t *rhs) {
+    fix64_mat4_t result;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            fix64_vec_impl_acc_t acc = fix64_vec_impl_acc(FIX64_ZERO);
+            for (int k = 0; k < 4; k++) {
+                fix64_vec_impl_mac(&acc, lhs->m[i][k], rhs->m[k][j]);
+            }
+            result.m[i][j] = fix64_vec_impl_round(acc);
+        }
+    }
+    return result;
+}
+
+/// Multiplication of a fix64_vec3_t column vector by a fix64_mat3_t matrix. Each component is
+/// calculated with 128-bit intermediates and rounded once. Overflow wraps like fix64_mul
+///
+/// @param lhs the matrix
+/// @param rhs the vector
+/// @return the product lhs * rhs
+static inline fix64_vec3_t fix64_mat3_mul_vec3(const fix64_mat3_t *lhs, fix64_vec3_t rhs) {
+    fix64_t result[3];
+    for (int i = 0; i < 3; i++) {
+        fix64_vec_impl_acc_t acc = fix64_vec_impl_acc(FIX64_ZERO);
+        fix64_vec_impl_mac(&acc, lhs->m[i][0], rhs.x);
+        fix64_vec_impl_mac(&acc, lhs->m[i][1], rhs.y);
+        fix64_vec_impl_mac(&acc, lhs->m[i][2], rhs.z);
+        result[i] = fix64_vec_impl_round(acc);
+    }
+    return fix64_vec3_make(result[0], result[1], result[2]);
+}
+
+/// Multiplication of a fix64_vec4_t column vector by a fix64_mat4_t matrix. Each component is
+/// calculated with 128-bit intermediates and rounded once. Overflow wraps like fix64_mul
+///
+/// @param lhs the matrix
+/// @param rhs the vector
+/// @return the product lhs * rhs
+static inline fix64_vec4_t fix64_mat4_mul_vec4(const fix64_mat4_t *lhs, fix64_vec4_t rhs) {
+    fix64_t result[4];
+    for (int i = 0; i < 4; i++) {
+        fix64_vec_impl_acc_t acc = fix64_vec_impl_acc(FIX64_ZERO);
+        fix64_vec_impl_mac(&acc, lhs->m[i][0], rhs.x);
+        fix64_vec_impl_mac(&acc, lhs->m[i][1], rhs.y);
+        fix64_vec_impl_mac(&acc, lhs->m[i][2], rhs.z);
+        fix64_vec_impl_mac(&acc, lhs->m[i][3], rhs.w);
+        result[i] = fix64_vec_impl_round(acc);
+    }
+    return fix64_vec4_make(result[0], result[1], result[2], result[3]);
+}
+
+/// Transforms a fix64_vec3_t point by an affine fix64_mat4_t matrix, i.e. the point is treated as
+/// (x, y, z, 1) and the last row of the matrix is ignored. Each component is calculated with
+/// 128-bit intermediates and rounded once. Overflow wraps like fix64_mul
+///
+/// @param lhs the matrix
+/// @param rhs the point
+/// @return the transformed point
+static inline fix64_vec3_t fix64_mat4_mul_point3(const fix64_mat4_t *lhs, fix64_vec3_t rhs) {
+    fix64_t result[3];
+    for (int i = 0; i < 3; i++) {
+        fix64_vec_impl_acc_t acc = fix64_vec_impl_acc(lhs->m[i][3]);
+        fix64_vec_impl_mac(&acc, lhs->m[i][0], rhs.x);
+        fix64_vec_impl_mac(&acc, lhs->m[i][1], rhs.y);
+        fix64_vec_impl_mac(&acc, lhs->m[i][2], rhs.z);
+        result[i] = fix64_vec_impl_round(acc);
+    }
+    return fix64_vec3_make(result[0], result[1], result[2]);
+}
+
+/// Transforms an array of vectors by a fix64_mat3_t matrix in place. The vectors are stored as
+/// a structure of arrays, i.e. vector i is (xs[i], ys[i], zs[i]). The results are identical to
+/// fix64_mat3_mul_vec3, but the matrix is only loaded once
+///
+/// @param mat the matrix
+/// @param xs array of count x components
+/// @param ys array of count y components
+/// @param zs array of count z components
+/// @param count the number of vectors
+void fix64_mat3_transform_soa(
+    const fix64_mat3_t *mat, fix64_t *xs, fix64_t *ys, fix64_t *zs, size_t count);
+
+/// Transforms an array of points by an affine fix64_mat4_t matrix in place. The points are stored
+/// as a structure of arrays, i.e. point i is (xs[i], ys[i], zs[i]). The results are identical to
+/// fix64_mat4_mul_point3, but the matrix is only loaded once
+///
+/// @param mat the matrix
+/// @param xs array of count x components
+/// @param ys array of count y components
+/// @param zs array of count z components
+/// @param count the number of points
+void fix64_mat4_transform_soa(
+    const fix64_mat4_t *mat, fix64_t *xs, fix64_t *ys, fix64_t *zs, size_t count);
+
+//==========================================================
+// Quaternions
+//==========================================================
+
+/// Creates a fix64_quat_t from its components
+///
+/// @param w the real part
+/// @param x the i part
+/// @param y the j part
+/// @param z the k part
+/// @return the quaternion w + xi + yj + zk
+static inline fix64_quat_t fix64_quat_make(fix64_t w, fix64_t x, fix64_t y, fix64_t z) {
+    fix64_quat_t result;
+    result.w = w;
+    result.x = x;
+    result.y = y;
+    result.z = z;
+    return result;
+}
+
+/// The identity quaternion, i.e. 1 + 0i + 0j + 0k
+///
+/// @return the identity quaternion
+static inline fix64_quat_t fix64_quat_identity(void) {
+    return fix64_quat_make(FIX64_ONE, FIX64_ZERO, FIX64_ZERO, FIX64_ZERO);
+}
+
+/// Conjugate of a fix64_quat_t, which is the inverse rotation for a unit quaternion
+///
+/// @param arg the quaternion
+/// @return the conjugate of arg
+static inline fix64_quat_t fix64_quat_conj(fix64_quat_t arg) {
+    return fix64_quat_make(arg.w, fix64_neg(arg.x), fix64_neg(arg.y), fix64_neg(arg.z));
+}
+
+/// Hamilton product of two fix64_quat_t numbers. Each component is calculated with 128-bit
+/// intermediates and rounded once. Overflow wraps like fix64_mul
+///
+/// @param lhs left hand side for the multiplication
+/// @param rhs right hand side for the multiplication
+/// @return the product of the two inputs
+static inline fix64_quat_t fix64_quat_mul(fix64_quat_t lhs, fix64_quat_t rhs) {
+    fix64_vec_impl_acc_t w = fix64_vec_impl_acc(FIX64_ZERO);
+    fix64_vec_impl_mac(&w, lhs.w, rhs.w);
+    fix64_vec_impl_msub(&w, lhs.x, rhs.x);
+    fix64_vec_impl_msub(&w, lhs.y, rhs.y);
+    fix64_vec_impl_msub(&w, lhs.z, rhs.z);
+
+    fix64_vec_impl_acc_t x = fix64_vec_impl_acc(FIX64_ZERO);
+    fix64_vec_impl_mac(&x, lhs.w, rhs.x);
+    fix64_vec_impl_mac(&x, lhs.x, rhs.w);
+    fix64_vec_impl_mac(&x, lhs.y, rhs.z);
+    fix64_vec_impl_msub(&x, lhs.z, rhs.y);
+
+    fix64_vec_impl_acc_t y = fix64_vec_impl_acc(FIX64_ZERO);
+    fix64_vec_impl_mac(&y, lhs.w, rhs.y);
+    fix64_vec_impl_msub(&y, lhs.x, rhs.z);
+    fix64_vec_impl_mac(&y, lhs.y, rhs.w);
+    fix64_vec_impl_mac(&y, lhs.z, rhs.x);
+
+    fix64_vec_impl_acc_t z = fix64_vec_impl_acc(FIX64_ZERO);
+    fix64_vec_impl_mac(&z, lhs.w, rhs.z);
+    fix64_vec_impl_mac(&z, lhs.x, rhs.y);
+    fix64_vec_impl_msub(&z, lhs.y, rhs.x);
+    fix64_vec_impl_mac(&z, lhs.z, rhs.w);
+
+    return fix64_quat_make(fix64_vec_impl_round(w), fix64_vec_impl_round(x),
+        fix64_vec_impl_round(y), fix64_vec_impl_round(z));
+}
+
+/// Scales a fix64_quat_t to unit length, in the same way as fix64_vec4_normalize. The zero
+/// quaternion is returned unchanged
+///
+/// @param arg the quaternion
+/// @return arg divided by its length
+fix64_quat_t fix64_quat_normalize(fix64_quat_t arg);
+
+/// Converts a unit fix64_quat_t to the equivalent rotation matrix. Each element is calculated
+/// with 128-bit intermediates and rounded once
+///
+/// @param arg the quaternion, which should have unit length
+/// @return the rotation matrix
+fix64_mat3_t fix64_quat_to_mat3(fix64_quat_t arg);
+
+/// Rotates a fix64_vec3_t by a unit fix64_quat_t, i.e. q * v * conj(q). This is the same as
+/// multiplying by the matrix from fix64_quat_to_mat3, so it's faster to use that directly to
+/// rotate many vectors by the same quaternion
+///
+/// @param lhs the quaternion, which should have unit length
+/// @param rhs the vector to rotate
+/// @return the rotated vector
+static inline fix64_vec3_t fix64_quat_rotate(fix64_quat_t lhs, fix64_vec3_t rhs) {
+    fix64_mat3_t mat = fix64_quat_to_mat3(lhs);
+    return fix64_mat3_mul_vec3(&mat, rhs);
+}
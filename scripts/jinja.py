@@ -1,6 +1,8 @@
 #!/usr/bin/env python3
 
 import consts
+import lut
+import ziggurat
 
 import sys
 from pathlib import Path
@@ -19,10 +21,50 @@ def const(value, base="x", frac_bits=32, digits=1):
 def uconst(value, base="x", frac_bits=32, digits=1):
     return f"U{const(value, base, frac_bits, digits)}"
 
+def int_lit(value):
+    if value == -(1 << 63):
+        return "INT64_MIN"
+    elif value < 0:
+        return f"-INT64_C({-value:#x})"
+    elif value >= (1 << 63):
+        return f"UINT64_C({value:#x})"
+    return f"INT64_C({value:#x})"
+
+def qformat(q, bits, frac_bits, signed):
+    repr = f"{'' if signed else 'u'}int{bits}_t"
+    return {
+        "type": None, # filled in below
+        "q": q,
+        "repr": repr,
+        "bits": bits,
+        "frac_bits": frac_bits,
+        "int_bits": bits - frac_bits - signed,
+        "signed": signed,
+        "min": -(1 << (bits - 1)) if signed else 0,
+        "max": (1 << (bits - signed)) - 1,
+        "repr_min": f"{repr[:-2].upper()}_MIN" if signed else "0",
+        "repr_max": f"{repr[:-2].upper()}_MAX",
+    }
+
+# Alternative fixed point formats generated in fix64/qformat.h. Formats with 31 or fewer integral
+# bits and 32 or fewer fractional bits fit in a fix64_t, so they can also use its math functions
+QFORMATS = {
+    "fix32":    qformat("Q15.16",  32, 16, True),
+    "ufix64":   qformat("UQ32.32", 64, 32, False),
+    "fix64q16": qformat("Q47.16",  64, 16, True),
+}
+FORMATS = { "fix64": qformat("Q31.32", 64, 32, True), **QFORMATS }
+for name, f in FORMATS.items():
+    f["type"] = f"{name}_t"
+    f["fits_fix64"] = f["int_bits"] <= 31 and f["frac_bits"] <= 32
+
 ARGS = {
     "autogen_comment": "// autogenerated file - edits to this file will be lost",
     "const": const,
+    "lut": lut.Lut,
+    "ziggurat": ziggurat,
     "uconst": uconst,
+    "int_lit": int_lit,
     "consts": {
         "zero":     { "str": "0",          "val": consts.zero },
         "one":      { "str": "1",          "val": consts.one },
@@ -46,16 +88,31 @@ ARGS = {
         "int":          { "short": "int",  "signed": True },
         "unsigned int": { "short": "uint", "signed": False },
     },
+    "fixed_ints": {
+        "int8_t":   { "short": "i8",  "signed": True,  "bits": 8 },
+        "int16_t":  { "short": "i16", "signed": True,  "bits": 16 },
+        "int32_t":  { "short": "i32", "signed": True,  "bits": 32 },
+        "int64_t":  { "short": "i64", "signed": True,  "bits": 64 },
+        "uint8_t":  { "short": "u8",  "signed": False, "bits": 8 },
+        "uint16_t": { "short": "u16", "signed": False, "bits": 16 },
+        "uint32_t": { "short": "u32", "signed": False, "bits": 32 },
+        "uint64_t": { "short": "u64", "signed": False, "bits": 64 },
+    },
     "floats": {
-        "float":       { "short": "flt",  "suffix": "f" },
-        "double":      { "short": "dbl",  "suffix": "" },
-        "long double": { "short": "ldbl", "suffix": "l" },
+        "float":       { "short": "flt",  "suffix": "f", "ieee": { "bits": 32, "exp_bits": 8 } },
+        "double":      { "short": "dbl",  "suffix": "",  "ieee": { "bits": 64, "exp_bits": 11 } },
+        "long double": { "short": "ldbl", "suffix": "l", "ieee": None },
     },
+    "qformats": QFORMATS,
+    "formats": FORMATS,
     "poly": {
         "sin": consts.Poly("sin(\pi x/4)", lambda a: _mp.sin(a * consts.pi_4), (0, 1), 2**-42),
         "cos": consts.Poly("cos(\pi x/4)", lambda a: _mp.cos(a * consts.pi_4), (0, 1), 2**-42),
         # Proportional error so we can use 1/tan and angle sum identities
         "tan": consts.Poly("tan(\pi x/4)", lambda a: _mp.tan(a * consts.pi / 8), (0, 1), 2**-42, proportional=True),
+        # Only needs to cover [0, tan(pi/8)] since atan2 reduces larger arguments with
+        # atan(x) = pi/4 - atan((1 - x) / (1 + x))
+        "atan": consts.Poly("4/\pi atan(x)", lambda x: _mp.atan(x) / consts.pi_4, (0, _mp.tan(consts.pi / 8)), 2**-42, proportional=True),
         "exp2m1": consts.Poly("2^x-1", lambda x: _mp.powm1(2, x), (0, 1), 2**-48),
     },
     "digit_coefs": [
@@ -65,13 +122,17 @@ ARGS = {
     "rounding_coefs": [
         consts.half / (10 ** i) for i in range(len(str(2 ** 64)))
     ],
+    "len_pow10": len(str(2 ** 64)),
+    # Seeds for Möller and Granlund's reciprocal, see fix64_impl_recip_u64
+    "recip_seeds": [(2**19 - 3 * 2**8) // d for d in range(256, 512)],
 }
 
 def render(filename, args):
     filename = Path(filename)
     env = _jinja2.Environment(
         keep_trailing_newline=True,
-        loader=_jinja2.FileSystemLoader(filename.parent),
+        # Templates can also import macros from this directory, e.g. lut.jinja
+        loader=_jinja2.FileSystemLoader([filename.parent, Path(__file__).absolute().parent]),
         lstrip_blocks=True,
         trim_blocks=True,
         undefined=_jinja2.StrictUndefined)
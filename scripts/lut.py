@@ -0,0 +1,111 @@
+import consts as _
+
+from mpmath import mp as _mp, mpf as _mpf
+
+FRAC_BITS = 32 # fix64_t fractional bits
+MAX_COEF_FRAC_BITS = 62 # Matches POLY_MAX_FRAC_BITS in src/poly.c
+
+# Functions and constants available to expressions, e.g. "1 / (1 + exp(-x))"
+_NAMESPACE = { name: getattr(_mp, name) for name in dir(_mp) if not name.startswith("_") }
+
+def _parse(value, var=None):
+    # Numbers are used as is, while strings are evaluated as expressions of mpmath functions
+    if callable(value):
+        return value
+    elif isinstance(value, str):
+        if var is None:
+            return eval(value, { "__builtins__": {} }, _NAMESPACE)
+        return lambda x: eval(value, { "__builtins__": {} }, { **_NAMESPACE, var: x })
+    return _mpf(value)
+
+class Lut:
+    """Piecewise polynomial approximation of a function as a table for fix64_lut_t
+
+    The table covers [lo, hi] with at most 2^log2_size intervals of equal width. The width is
+    rounded up to a power of 2 so that the interval of x can be found with a shift, so the table
+    may have fewer intervals and its last interval may end after hi. Each interval has its own
+    polynomial in u in [0, 1): "linear" interpolates between the function's values at the ends of
+    the interval, and "cubic" is the Hermite cubic which also matches the function's derivatives
+    there, which is far more accurate for smooth functions. A larger log2_size trades memory for
+    accuracy
+    """
+
+    def __init__(self, name, func, lo, hi, log2_size=8, interp="linear", max_error=None):
+        if interp not in ("linear", "cubic"):
+            raise ValueError(f"{name}: unsupported interpolation \"{interp}\"")
+        self.name = name
+        self.expr = func if isinstance(func, str) else None
+        self.func = _parse(func, "x")
+        self.interp = interp
+        self.order = 2 if interp == "linear" else 4
+
+        lo = int(_mp.floor(_parse(lo) * (1 << FRAC_BITS)))
+        hi = int(_mp.ceil(_parse(hi) * (1 << FRAC_BITS)))
+        if lo >= hi or lo < -(1 << 63) or hi >= (1 << 63):
+            raise ValueError(f"{name}: invalid interval")
+        self.shift = ((hi - lo - 1) >> log2_size).bit_length()
+        self.size = (hi - lo + (1 << self.shift) - 1) >> self.shift
+        if self.shift > 63 or lo + (self.size << self.shift) > (1 << 63):
+            raise ValueError(f"{name}: the table doesn't fit in a fix64_t")
+        self.lo = lo
+        self.hi = lo + (self.size << self.shift)
+
+        coefs = [self._interval_coefs(i) for i in range(self.size)]
+
+        # Use as many fractional bits as possible while leaving a bit of headroom, like fix64_poly_t
+        max_sum = max(sum(abs(c) for c in interval) for interval in coefs)
+        self.frac_bits = MAX_COEF_FRAC_BITS
+        while max_sum * 2**self.frac_bits >= 2**62:
+            self.frac_bits -= 1
+        if self.frac_bits < 0:
+            raise ValueError(f"{name}: the function is too large for a fix64_t")
+        self.coefs = [
+            [int(_mp.nint(c * 2**self.frac_bits)) for c in interval] for interval in coefs
+        ]
+
+        self.max_error = self._max_error()
+        print(f"{name}: {interp} table with {self.size} intervals; "
+            f"e_max = {_mp.nstr(self.max_error, strip_zeros=False)}")
+        if max_error is not None and self.max_error > max_error:
+            raise ValueError(f"{name}: maximum error {_mp.nstr(self.max_error)} is larger than "
+                f"{max_error}, try a larger log2_size or cubic interpolation")
+
+    def _x(self, i):
+        return _mpf(self.lo + (i << self.shift)) / (1 << FRAC_BITS)
+
+    def _interval_coefs(self, i):
+        x0, x1 = self._x(i), self._x(i + 1)
+        v0, v1 = self.func(x0), self.func(x1)
+        if self.interp == "linear":
+            return [v0, v1 - v0]
+        # Derivatives with respect to u, i.e. scaled by the width of the interval
+        h = x1 - x0
+        m0, m1 = _mp.diff(self.func, x0) * h, _mp.diff(self.func, x1) * h
+        return [v0, m0, 3 * (v1 - v0) - 2 * m0 - m1, 2 * (v0 - v1) + m0 + m1]
+
+    def _max_error(self):
+        # Sample each interval of the rounded table, which includes the rounding of the result
+        samples = 8
+        err = _mp.zero
+        for i, interval in enumerate(self.coefs):
+            for j in range(samples + 1):
+                u = _mpf(j) / samples
+                approx = _mp.polyval([c / _mpf(2)**self.frac_bits for c in reversed(interval)], u)
+                x = self._x(i) + u * (self._x(i + 1) - self._x(i))
+                err = max(err, abs(approx - self.func(x)))
+        return err + _mpf(2)**-(FRAC_BITS + 1)
+
+    @staticmethod
+    def _lit(value):
+        if value == -(1 << 63):
+            return "INT64_MIN"
+        elif value < 0:
+            return f"-INT64_C({-value:#018x})"
+        return f"INT64_C({value:#018x})"
+
+    def c_coefs(self):
+        # Each interval's coefficients as C integer literals
+        return [", ".join(Lut._lit(c) for c in interval) for interval in self.coefs]
+
+    def c_lo(self):
+        return Lut._lit(self.lo)
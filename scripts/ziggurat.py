@@ -0,0 +1,73 @@
+import consts as _
+
+from mpmath import mp as _mp, mpf as _mpf
+
+FRAC_BITS = 32 # fix64_t fractional bits
+
+class Ziggurat:
+    """Tables for Marsaglia and Tsang's ziggurat method of sampling a decreasing density on [0, inf)
+
+    The area under f is covered by a base strip (a rectangle containing the tail beyond r) and
+    size - 1 rectangles stacked on top of it, all of area v. Rectangle i spans [0, x[i]] and its
+    bottom edge is at f(x[i]), so that x[0] = v / f(r), x[1] = r and x[size] = 0. r is found so
+    that the top rectangle ends exactly at f(0)
+    """
+
+    def __init__(self, name, func, func_inv, tail_area, size=256):
+        self.name = name
+        self.size = size
+        self.func = func
+
+        def rectangles(r):
+            v = r * func(r) + tail_area(r)
+            x = [v / func(r), r]
+            for _i in range(2, size):
+                y = func(x[-1]) + v / x[-1]
+                if y >= func(0):
+                    return v, x, y
+                x.append(func_inv(y))
+            return v, x, func(x[-1]) + v / x[-1]
+
+        # The top of the last rectangle decreases as r increases, so bisect for where it hits f(0)
+        lo, hi = _mpf(1), _mpf(20)
+        for _i in range(_mp.prec):
+            mid = (lo + hi) / 2
+            _v, x, top = rectangles(mid)
+            if len(x) < size or top > func(0):
+                lo = mid
+            else:
+                hi = mid
+        self.r = hi
+        self.v, x, _top = rectangles(hi)
+        self.x = x + [_mp.zero]
+        self.f = [func(xi) for xi in self.x]
+        print(f"{name}: ziggurat with {size} rectangles; r = {_mp.nstr(self.r, 17)}, "
+            f"v = {_mp.nstr(self.v, 17)}")
+
+    @staticmethod
+    def _fix(value):
+        return f"INT64_C({int(_mp.nint(value * 2**FRAC_BITS)):#018x})"
+
+    def c_ratios(self):
+        # floor(2^64 * x[i + 1] / x[i]), so that x = u * x[i] < x[i + 1] iff u < ratio with a
+        # UQ0.64 u, up to rounding
+        return [f"UINT64_C({int(_mp.floor(2**64 * self.x[i + 1] / self.x[i])):#018x})"
+            for i in range(self.size)]
+
+    def c_x(self):
+        return [Ziggurat._fix(xi) for xi in self.x]
+
+    def c_f(self):
+        return [Ziggurat._fix(fi) for fi in self.f]
+
+    def c_r(self):
+        return Ziggurat._fix(self.r)
+
+def normal(size=256):
+    # Unnormalised standard normal density, since the scale doesn't matter
+    return Ziggurat("normal", lambda x: _mp.exp(-x * x / 2), lambda y: _mp.sqrt(-2 * _mp.ln(y)),
+        lambda r: _mp.sqrt(_mp.pi / 2) * _mp.erfc(r / _mp.sqrt(2)), size)
+
+def exponential(size=256):
+    return Ziggurat("exponential", lambda x: _mp.exp(-x), lambda y: -_mp.ln(y),
+        lambda r: _mp.exp(-r), size)
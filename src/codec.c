@@ -0,0 +1,224 @@
+#include "fix64.h"
+#include "fix64/impl.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Block layout, all integers are little endian:
+//   u8  count   number of values in the block, 1 to FIX64_CODEC_BLOCK_SIZE
+//   u8  mode    CODEC_MODE_DELTA or CODEC_MODE_DELTA2 in bit 0, shift in bits 1 to 6
+//   u8  width   number of bits per packed residual, 0 to 64
+//   i64 first   the first value
+//   i64 min     the smallest value
+//   i64 max     the largest value
+//   ... count - 1 residuals, arithmetic shifted right by shift bits (they are all multiples of
+//       2^shift), zigzag encoded and packed LSB first with width bits each
+
+enum {
+    CODEC_MODE_DELTA, // residuals are x[i] - x[i-1]
+    CODEC_MODE_DELTA2, // residuals are (x[i] - x[i-1]) - (x[i-1] - x[i-2])
+};
+
+// Note: GCC and Clang merge these into a single load/store on little endian architectures
+static inline uint64_t load_le64(const uint8_t *buf) {
+    return (uint64_t)buf[0] | (uint64_t)buf[1] << 8 | (uint64_t)buf[2] << 16 |
+        (uint64_t)buf[3] << 24 | (uint64_t)buf[4] << 32 | (uint64_t)buf[5] << 40 |
+        (uint64_t)buf[6] << 48 | (uint64_t)buf[7] << 56;
+}
+
+static inline void store_le64(uint8_t *buf, uint64_t value) {
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+    buf[4] = (uint8_t)(value >> 32);
+    buf[5] = (uint8_t)(value >> 40);
+    buf[6] = (uint8_t)(value >> 48);
+    buf[7] = (uint8_t)(value >> 56);
+}
+
+// Maps signed differences to unsigned so that small magnitudes have few significant bits:
+// 0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3, ...
+static inline uint64_t zigzag(uint64_t x) {
+    return (x << 1) ^ (UINT64_C(0) - (x >> 63));
+}
+
+static inline uint64_t unzigzag(uint64_t x) {
+    return (x >> 1) ^ (UINT64_C(0) - (x & 1));
+}
+
+// Arithmetic shift right, the sign bit is replicated
+static inline uint64_t asr(uint64_t x, unsigned shift) {
+    return (x >> shift) | ((UINT64_C(0) - (x >> 63)) << (63 - shift) << 1);
+}
+
+// Avoid UB of unsigned -> signed conversion, gets optimised out on most compilers
+static inline int64_t to_signed(uint64_t x) {
+    return (x > INT64_MAX) ? (int64_t)(x - INT64_MIN) + INT64_MIN : (int64_t)x;
+}
+
+static inline size_t packed_size(size_t count, unsigned width) {
+    return ((count - 1) * width + 7) / 8;
+}
+
+static size_t encode_block(uint8_t *buf, const fix64_t *values, size_t count) {
+    uint64_t residuals[2][FIX64_CODEC_BLOCK_SIZE];
+    uint64_t bits[2] = { 0, 0 };
+    uint64_t zbits[2] = { 0, 0 };
+    unsigned shifts[2] = { 0, 0 };
+
+    int64_t min = values[0].repr;
+    int64_t max = values[0].repr;
+    uint64_t prev = values[0].repr;
+    uint64_t prev_delta = 0;
+    for (size_t i = 1; i < count; i++) {
+        // Wrapping unsigned arithmetic makes the encoding lossless for any input
+        uint64_t delta = (uint64_t)values[i].repr - prev;
+        residuals[CODEC_MODE_DELTA][i - 1] = delta;
+        residuals[CODEC_MODE_DELTA2][i - 1] = delta - prev_delta;
+        bits[CODEC_MODE_DELTA] |= residuals[CODEC_MODE_DELTA][i - 1];
+        bits[CODEC_MODE_DELTA2] |= residuals[CODEC_MODE_DELTA2][i - 1];
+
+        min = (values[i].repr < min) ? values[i].repr : min;
+        max = (values[i].repr > max) ? values[i].repr : max;
+        prev = values[i].repr;
+        prev_delta = delta;
+    }
+
+    // Values with reduced precision (e.g. from an ADC) have common trailing zero bits in all of
+    // the residuals, which don't need to be stored
+    for (unsigned m = 0; m < 2; m++) {
+        if (bits[m]) {
+            shifts[m] = 63 - fix64_impl_clz64(bits[m] & (UINT64_C(0) - bits[m]));
+        }
+        for (size_t i = 0; i < count - 1; i++) {
+            residuals[m][i] = zigzag(asr(residuals[m][i], shifts[m]));
+            zbits[m] |= residuals[m][i];
+        }
+    }
+
+    unsigned mode = (zbits[CODEC_MODE_DELTA2] < zbits[CODEC_MODE_DELTA]) ? CODEC_MODE_DELTA2
+                                                                           : CODEC_MODE_DELTA;
+    unsigned width = 64 - fix64_impl_clz64(zbits[mode]);
+
+    buf[0] = (uint8_t)count;
+    buf[1] = (uint8_t)(mode | shifts[mode] << 1);
+    buf[2] = (uint8_t)width;
+    store_le64(buf + 3, values[0].repr);
+    store_le64(buf + 11, min);
+    store_le64(buf + 19, max);
+
+    uint8_t *out = buf + FIX64_CODEC_HEADER_SIZE;
+    size_t out_size = packed_size(count, width);
+    memset(out, 0, out_size);
+    size_t pos = 0; // position in bits
+    for (size_t i = 0; i < count - 1; i++, pos += width) {
+        uint64_t r = residuals[mode][i];
+        unsigned offset = pos % 8;
+        size_t byte = pos / 8;
+        // A residual spans at most 9 bytes
+        for (unsigned written = 0; written < width + offset; written += 8, byte++) {
+            out[byte] |= (uint8_t)((written ? r >> (written - offset) : r << offset));
+        }
+    }
+
+    return FIX64_CODEC_HEADER_SIZE + out_size;
+}
+
+size_t fix64_encode(uint8_t *buf, size_t size, const fix64_t *values, size_t count) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i += FIX64_CODEC_BLOCK_SIZE) {
+        size_t n = count - i;
+        n = (n > FIX64_CODEC_BLOCK_SIZE) ? FIX64_CODEC_BLOCK_SIZE : n;
+
+        // Encode to a temporary buffer if there might not be enough space. This is only the case
+        // near the end of the buffer, so it doesn't cost much
+        uint8_t tmp[FIX64_CODEC_HEADER_SIZE + FIX64_CODEC_BLOCK_SIZE * sizeof(int64_t)];
+        size_t max_size = fix64_encode_bound(n);
+        if (size - total >= max_size) {
+            total += encode_block(buf + total, values + i, n);
+        } else {
+            size_t block_size = encode_block(tmp, values + i, n);
+            if (block_size > size - total) {
+                return 0;
+            }
+            memcpy(buf + total, tmp, block_size);
+            total += block_size;
+        }
+    }
+    return total;
+}
+
+int fix64_decode_block_info(fix64_block_info_t *info, const uint8_t *buf, size_t size) {
+    if (size < FIX64_CODEC_HEADER_SIZE) {
+        return 0;
+    }
+    size_t count = buf[0];
+    unsigned mode = buf[1];
+    unsigned width = buf[2];
+    if (count == 0 || count > FIX64_CODEC_BLOCK_SIZE || mode > 127 || width > 64) {
+        return 0;
+    }
+    size_t block_size = FIX64_CODEC_HEADER_SIZE + packed_size(count, width);
+    if (block_size > size) {
+        return 0;
+    }
+
+    info->count = count;
+    info->size = block_size;
+    info->min.repr = to_signed(load_le64(buf + 11));
+    info->max.repr = to_signed(load_le64(buf + 19));
+    return 1;
+}
+
+static void decode_block(fix64_t *values, const uint8_t *buf, size_t count) {
+    unsigned mode = buf[1] & 1;
+    unsigned shift = buf[1] >> 1;
+    unsigned width = buf[2];
+    uint64_t mask = (width < 64) ? (UINT64_C(1) << width) - 1 : UINT64_MAX;
+
+    // Copy the packed data to a zero padded buffer so each residual can be read with unaligned 64
+    // bit loads without reading past the end of the input
+    uint8_t packed[FIX64_CODEC_BLOCK_SIZE * sizeof(int64_t) + 16];
+    size_t size = packed_size(count, width);
+    memcpy(packed, buf + FIX64_CODEC_HEADER_SIZE, size);
+    memset(packed + size, 0, 16);
+
+    uint64_t prev = load_le64(buf + 3);
+    uint64_t delta = 0;
+    values[0].repr = to_signed(prev);
+    size_t pos = 0; // position in bits
+    for (size_t i = 1; i < count; i++, pos += width) {
+        const uint8_t *p = packed + pos / 8;
+        unsigned offset = pos % 8;
+        // If offset + width > 64 the top bits are in the 9th byte
+        uint64_t r = load_le64(p) >> offset;
+        r |= (offset ? (uint64_t)p[8] << (64 - offset) : 0);
+        r = unzigzag(r & mask) << shift;
+
+        delta = (mode == CODEC_MODE_DELTA2) ? delta + r : r;
+        prev += delta;
+        values[i].repr = to_signed(prev);
+    }
+}
+
+size_t fix64_decode(
+    fix64_t *values, size_t count, const uint8_t *buf, size_t size, size_t *consumed) {
+    size_t n_values = 0;
+    size_t offset = 0;
+    fix64_block_info_t info;
+    while (fix64_decode_block_info(&info, buf + offset, size - offset)) {
+        if (info.count > count - n_values) {
+            break;
+        }
+        decode_block(values + n_values, buf + offset, info.count);
+        n_values += info.count;
+        offset += info.size;
+    }
+
+    if (consumed) {
+        *consumed = offset;
+    }
+    return n_values;
+}
@@ -0,0 +1,140 @@
+#include "fix64.h"
+#include "fix64/impl.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// pi as a UQ2.62
+#define PI_Q62 UINT64_C(0xc90fdaa22168c235)
+
+// Components must be below 2^61 (as a repr) before each FFT stage. A butterfly's outputs are then
+// at most 2^61 + sqrt(2) * 2^61 < 2^63, so they can't overflow
+#define FFT_HEADROOM_BITS 61
+
+fix64_t fix64c_abs(fix64c_t arg) {
+    // Negate as unsigned to avoid UB for INT64_MIN
+    uint64_t re = (arg.re.repr < 0) ? UINT64_C(0) - arg.re.repr : (uint64_t)arg.re.repr;
+    uint64_t im = (arg.im.repr < 0) ? UINT64_C(0) - arg.im.repr : (uint64_t)arg.im.repr;
+
+    // re^2 + im^2 <= 2^127, which is the squared magnitude with 64 fractional bits so its square
+    // root has 32
+    uint64_t rr_hi, ii_hi, norm_hi;
+    uint64_t rr_lo = fix64_impl_mul_u64_u128(re, re, &rr_hi);
+    uint64_t ii_lo = fix64_impl_mul_u64_u128(im, im, &ii_hi);
+    uint64_t norm_lo = fix64_impl_add_u128(rr_hi, rr_lo, ii_hi, ii_lo, &norm_hi);
+    uint64_t root = fix64_impl_sqrt_u128(norm_hi, norm_lo);
+
+    // Round up if norm > (root + 0.5)^2 = root^2 + root + 0.25, i.e. norm - root^2 > root since the
+    // norm is an integer. Halfway values aren't possible
+    uint64_t sq_hi, rem_hi;
+    uint64_t sq_lo = fix64_impl_mul_u64_u128(root, root, &sq_hi);
+    uint64_t rem_lo = fix64_impl_sub_u128(norm_hi, norm_lo, sq_hi, sq_lo, &rem_hi);
+    root += (rem_hi || rem_lo > root);
+
+    if (FIX64_UNLIKELY(root > INT64_MAX)) {
+        return FIX64_MAX;
+    }
+    return (fix64_t){ (int64_t)root };
+}
+
+int fix64_fft_plan_init(fix64_fft_plan_t *plan, fix64c_t *twiddles, size_t size) {
+    // The size is limited to 2^32 so that the angles below can be calculated with a simple shift
+    if (size == 0 || (size & (size - 1)) || (uint64_t)size > (UINT64_C(1) << 32)) {
+        return -1;
+    }
+    unsigned log2_size = 63 - fix64_impl_clz64(size);
+
+    // The angle 2 pi k / size is calculated from pi with 62 fractional bits so that it's correctly
+    // rounded, i.e. angle = round(k * PI_Q62 / 2^(log2_size + 29))
+    const unsigned shift = log2_size + 62 - FIX64_FRAC_BITS - 1;
+    for (size_t k = 0; k < size / 2; k++) {
+        uint64_t hi;
+        uint64_t lo = fix64_impl_mul_u64_u128(k, PI_Q62, &hi);
+        lo = fix64_impl_add_u128(hi, lo, 0, UINT64_C(1) << (shift - 1), &hi); // For rounding
+        fix64_t angle = { (int64_t)((hi << (64 - shift)) | (lo >> shift)) };
+        twiddles[k] = fix64c_make(fix64_cos(angle), fix64_neg(fix64_sin(angle)));
+    }
+
+    plan->size = size;
+    plan->log2_size = log2_size;
+    plan->twiddles = twiddles;
+    return 0;
+}
+
+// Bits which are set if any component of data is large, i.e. the OR of all of their magnitudes
+// (less 1 for negative components)
+static inline uint64_t magnitude_bits(fix64c_t arg) {
+    return (uint64_t)(arg.re.repr ^ (arg.re.repr >> 63)) |
+        (uint64_t)(arg.im.repr ^ (arg.im.repr >> 63));
+}
+
+// Scales data down by enough powers of 2 that every component is below 2^FFT_HEADROOM_BITS,
+// returning the number of powers of 2
+static unsigned fft_scale(fix64c_t *data, size_t size, uint64_t mag_bits) {
+    if (FIX64_LIKELY(!(mag_bits >> FFT_HEADROOM_BITS))) {
+        return 0;
+    }
+    unsigned shift = 64 - fix64_impl_clz64(mag_bits) - FFT_HEADROOM_BITS;
+    for (size_t i = 0; i < size; i++) {
+        // Round to nearest, with halfway values rounded up
+        int64_t re = data[i].re.repr;
+        int64_t im = data[i].im.repr;
+        data[i].re.repr = (re >> shift) + ((re >> (shift - 1)) & 1);
+        data[i].im.repr = (im >> shift) + ((im >> (shift - 1)) & 1);
+    }
+    return shift;
+}
+
+static inline int fft(const fix64_fft_plan_t *plan, fix64c_t *data, int inverse) {
+    const size_t size = plan->size;
+
+    // Reorder the input by bit reversed index
+    for (size_t i = 1, j = 0; i < size; i++) {
+        size_t bit = size >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j |= bit;
+        if (i < j) {
+            fix64c_t tmp = data[i];
+            data[i] = data[j];
+            data[j] = tmp;
+        }
+    }
+
+    uint64_t mag_bits = 0;
+    for (size_t i = 0; i < size; i++) {
+        mag_bits |= magnitude_bits(data[i]);
+    }
+
+    int exponent = 0;
+    for (unsigned stage = 0; stage < plan->log2_size; stage++) {
+        exponent += fft_scale(data, size, mag_bits);
+        mag_bits = 0;
+
+        // Butterflies between pairs of elements half apart, with twiddles every stride entries
+        const size_t half = (size_t)1 << stage;
+        const size_t stride = size >> (stage + 1);
+        for (size_t start = 0; start < size; start += 2 * half) {
+            for (size_t j = 0; j < half; j++) {
+                fix64c_t *a = &data[start + j];
+                fix64c_t *b = a + half;
+                fix64c_t w = plan->twiddles[j * stride];
+                fix64c_t t = inverse ? fix64c_mul_conj(*b, w) : fix64c_mul(*b, w);
+                fix64c_t u = *a;
+                *a = fix64c_add(u, t);
+                *b = fix64c_sub(u, t);
+                mag_bits |= magnitude_bits(*a) | magnitude_bits(*b);
+            }
+        }
+    }
+    return exponent;
+}
+
+int fix64_fft(const fix64_fft_plan_t *plan, fix64c_t *data) {
+    return fft(plan, data, 0);
+}
+
+int fix64_ifft(const fix64_fft_plan_t *plan, fix64c_t *data) {
+    return fft(plan, data, 1);
+}
@@ -3,9 +3,8 @@
 
 #include <stdint.h>
 
-#if !FIX64_IMPL_USE_NATIVE_DIVQ
-
-uint64_t fix64_impl_div_u128_u64(uint64_t u_hi, uint64_t u_lo, uint64_t v) {
+// Always compiled so that every FIX64_DIV_ENGINE can be tested and benchmarked
+uint64_t fix64_impl_div_u128_u64_soft(uint64_t u_hi, uint64_t u_lo, uint64_t v) {
 
     // This function is based on libdivide's libdivide_128_div_64_to_64
     // See: https://github.com/ridiculousfish/libdivide
@@ -80,28 +79,33 @@ uint64_t fix64_impl_div_u128_u64(uint64_t u_hi, uint64_t u_lo, uint64_t v) {
     return ((uint64_t)q_hi << 32) | q_lo;
 }
 
-int64_t fix64_impl_div_i128_i64(int64_t u_hi, uint64_t u_lo, int64_t v) {
-    // unsigned variables
-    uint64_t uu_hi = u_hi;
-    uint64_t uu_lo = u_lo;
-    uint64_t uv = v;
-
-    // u_sign = -(u < 0)
-    uint64_t u_sign = u_hi >> 63;
-    // uu_hi:uu_lo = abs(u_hi:u_lo)
-    uu_lo = fix64_impl_add_u128(uu_hi, uu_lo, u_sign, u_sign, &uu_hi);
-    uu_lo ^= u_sign;
-    uu_hi ^= u_sign;
-
-    uint64_t v_sign = v >> 63; // = -(v < 0)
-    uv = (v_sign) ? -uv : uv; // = labs(v);
-
-    uint64_t result = fix64_impl_div_u128_u64(uu_hi, uu_lo, uv);
+#if FIX64_IMPL_USE_NATIVE_DIVQ
+uint64_t (*fix64_impl_div_u128_u64_runtime)(uint64_t, uint64_t, uint64_t) =
+    fix64_impl_div_u128_u64_divq;
+int fix64_impl_div_engine_runtime = FIX64_DIV_ENGINE_DIVQ;
+#else
+uint64_t (*fix64_impl_div_u128_u64_runtime)(uint64_t, uint64_t, uint64_t) =
+    fix64_impl_div_u128_u64_soft;
+int fix64_impl_div_engine_runtime = FIX64_DIV_ENGINE_SOFT;
+#endif
 
-    uint64_t q_sign = u_sign ^ v_sign; // sign of the quotient
-    result = (q_sign) ? -result : result;
+int fix64_select_div_engine(int engine) {
+    uint64_t (*div)(uint64_t, uint64_t, uint64_t) = NULL;
+#if FIX64_IMPL_USE_NATIVE_DIVQ
+    if (engine == FIX64_DIV_ENGINE_DIVQ) {
+        div = fix64_impl_div_u128_u64_divq;
+    }
+#endif
+    if (engine == FIX64_DIV_ENGINE_SOFT) {
+        div = fix64_impl_div_u128_u64_soft;
+    } else if (engine == FIX64_DIV_ENGINE_RECIP) {
+        div = fix64_impl_div_u128_u64_recip;
+    }
 
-    return result;
+    if (!div) {
+        return 0;
+    }
+    fix64_impl_div_u128_u64_runtime = div;
+    fix64_impl_div_engine_runtime = engine;
+    return 1;
 }
-
-#endif
@@ -0,0 +1,170 @@
+#include "fix64.h"
+#include "fix64/impl.h"
+
+#include <stdint.h>
+
+// Divides u2:u1:u0 by v1:v0, where v1 is normalised (i.e. its top bit is set) and u2:u1 < v1:v0 so
+// that the quotient fits in 64 bits. Returns the quotient and writes the remainder to r1:r0. This
+// is step D3 to D6 of Knuth's algorithm D, TAOCP vol. 2 section 4.3.1
+static uint64_t div_3by2(
+    uint64_t u2, uint64_t u1, uint64_t u0, uint64_t v1, uint64_t v0, uint64_t *r1, uint64_t *r0) {
+    // Estimate the quotient from the top two limbs, which is at most 2 too large
+    uint64_t qhat, rhat;
+    int rhat_overflow;
+    if (FIX64_UNLIKELY(u2 >= v1)) {
+        // u2 == v1, so the quotient would be 2^64 which is clamped to 2^64 - 1
+        qhat = UINT64_MAX;
+        rhat_overflow = fix64_impl_add_u64_overflow(u1, v1, &rhat);
+    } else {
+        qhat = fix64_impl_div_u128_u64(u2, u1, v1);
+        rhat = u1 - qhat * v1;
+        rhat_overflow = 0;
+    }
+
+    // Refine the estimate using v0, after which it is at most 1 too large
+    while (!rhat_overflow) {
+        uint64_t p_hi;
+        uint64_t p_lo = fix64_impl_mul_u64_u128(qhat, v0, &p_hi);
+        if (p_hi < rhat || (p_hi == rhat && p_lo <= u0)) {
+            break;
+        }
+        qhat--;
+        rhat_overflow = fix64_impl_add_u64_overflow(rhat, v1, &rhat);
+    }
+
+    // u2:u1:u0 -= qhat * v1:v0
+    uint64_t p0_hi, p1_hi, m1;
+    uint64_t p0 = fix64_impl_mul_u64_u128(qhat, v0, &p0_hi);
+    uint64_t p1 = fix64_impl_mul_u64_u128(qhat, v1, &p1_hi);
+    uint64_t m2 = p1_hi + fix64_impl_add_u64_overflow(p1, p0_hi, &m1);
+    uint64_t borrow = fix64_impl_sub_u64_underflow(u0, p0, r0);
+    uint64_t hi;
+    uint64_t lo = fix64_impl_sub_u128(u2, u1, m2, m1, &hi);
+    lo = fix64_impl_sub_u128(hi, lo, 0, borrow, &hi);
+
+    // If the remainder is negative the estimate was 1 too large, so add the divisor back
+    if (FIX64_UNLIKELY(hi)) {
+        qhat--;
+        uint64_t carry = fix64_impl_add_u64_overflow(*r0, v0, r0);
+        lo += v1 + carry;
+    }
+
+    *r1 = lo;
+    return qhat;
+}
+
+// Divides the magnitudes of lhs and rhs, with the quotient rounded to nearest with halfway values
+// rounded away from zero. The quotient is written to q_hi:q_lo modulo 2^128, and the return value
+// is non-zero if it overflowed 128 bits
+static int div_mag(fix128_t lhs, fix128_t rhs, uint64_t *q_hi, uint64_t *q_lo) {
+    // Negate as unsigned to avoid UB for FIX128_MIN
+    uint64_t a_hi = lhs.hi;
+    uint64_t a_lo = lhs.lo;
+    if (lhs.hi < 0) {
+        a_lo = fix64_impl_sub_u128(0, 0, a_hi, a_lo, &a_hi);
+    }
+    uint64_t d1 = rhs.hi;
+    uint64_t d0 = rhs.lo;
+    if (rhs.hi < 0) {
+        d0 = fix64_impl_sub_u128(0, 0, d1, d0, &d1);
+    }
+
+    // n2:n1:n0 = (a << 64) + d / 2, where a <= 2^127 so n2 can't overflow
+    uint64_t n0 = (d0 >> 1) | (d1 << 63);
+    uint64_t n1 = fix64_impl_add_u128(a_hi, a_lo, 0, d1 >> 1, &a_hi);
+    uint64_t n2 = a_hi;
+
+    if (d1 == 0) {
+        // Long division by a single limb, where the top limb only contributes to the overflow
+        int overflow = (n2 >= d0);
+        n2 = FIX64_UNLIKELY(overflow) ? n2 % d0 : n2;
+        *q_hi = fix64_impl_div_u128_u64(n2, n1, d0);
+        uint64_t rem = n1 - *q_hi * d0;
+        *q_lo = fix64_impl_div_u128_u64(rem, n0, d0);
+        return overflow;
+    }
+
+    // Normalise so that the top bit of the divisor is set. The quotient then fits in 128 bits since
+    // the divisor is at least 2^64. The right shifts are split in two since shift can be 0
+    unsigned shift = fix64_impl_clz64(d1);
+    uint64_t v1 = (d1 << shift) | ((d0 >> 1) >> (63 - shift));
+    uint64_t v0 = d0 << shift;
+    uint64_t u3 = (n2 >> 1) >> (63 - shift);
+    uint64_t u2 = (n2 << shift) | ((n1 >> 1) >> (63 - shift));
+    uint64_t u1 = (n1 << shift) | ((n0 >> 1) >> (63 - shift));
+    uint64_t u0 = n0 << shift;
+
+    uint64_t r1, r0;
+    *q_hi = div_3by2(u3, u2, u1, v1, v0, &r1, &r0);
+    *q_lo = div_3by2(r1, r0, u0, v1, v0, &r1, &r0);
+    return 0;
+}
+
+fix128_t fix128_div(fix128_t lhs, fix128_t rhs) {
+    uint64_t q_hi, q_lo;
+    div_mag(lhs, rhs, &q_hi, &q_lo);
+    if ((lhs.hi < 0) != (rhs.hi < 0)) {
+        q_lo = fix64_impl_sub_u128(0, 0, q_hi, q_lo, &q_hi);
+    }
+    fix128_t result;
+    result.hi = (q_hi > INT64_MAX) ? (int64_t)(q_hi - INT64_MIN) + INT64_MIN : (int64_t)q_hi;
+    result.lo = q_lo;
+    return result;
+}
+
+fix128_t fix128_div_sat(fix128_t lhs, fix128_t rhs) {
+    if (FIX64_UNLIKELY(rhs.hi == 0 && rhs.lo == 0)) {
+        return (lhs.hi < 0) ? FIX128_MIN : FIX128_MAX;
+    }
+
+    uint64_t q_hi, q_lo;
+    int overflow = div_mag(lhs, rhs, &q_hi, &q_lo);
+    if ((lhs.hi < 0) != (rhs.hi < 0)) {
+        // The magnitude of FIX128_MIN is 2^127
+        if (FIX64_UNLIKELY(overflow || q_hi > (uint64_t)INT64_MAX + (q_lo == 0))) {
+            return FIX128_MIN;
+        }
+        q_lo = fix64_impl_sub_u128(0, 0, q_hi, q_lo, &q_hi);
+    } else if (FIX64_UNLIKELY(overflow || q_hi > INT64_MAX)) {
+        return FIX128_MAX;
+    }
+
+    fix128_t result;
+    result.hi = (q_hi > INT64_MAX) ? (int64_t)(q_hi - INT64_MIN) + INT64_MIN : (int64_t)q_hi;
+    result.lo = q_lo;
+    return result;
+}
+
+fix128_t fix128_from_dbl(double arg) {
+    // 2^63 and -2^63, which are exactly representable
+    static const double max = 9223372036854775808.0;
+    static const double min = -9223372036854775808.0;
+    if (FIX64_UNLIKELY(arg >= max)) {
+        return FIX128_MAX;
+    }
+    if (FIX64_UNLIKELY(arg < min)) {
+        return FIX128_MIN;
+    }
+
+    // Convert the magnitude, for which both the integral part and the fraction are exact (the
+    // conversion to uint64_t truncates). The fraction is scaled by 2^64, and only needs rounding if
+    // it's small enough to have bits below 2^-64, in which case adding 0.5 is also exact. Rounding
+    // can't carry into the integral part since frac <= 1 - 2^-53. This avoids depending on libm
+    double mag = (arg < 0) ? -arg : arg;
+    uint64_t ipart = (uint64_t)mag;
+    double frac = (mag - (double)ipart) * 18446744073709551616.0;
+    if (frac < 4503599627370496.0) { // 2^52
+        frac += 0.5;
+    }
+
+    // The magnitude is at most 2^63, so negate as unsigned
+    uint64_t hi = ipart;
+    uint64_t lo = (uint64_t)frac;
+    if (arg < 0) {
+        lo = fix64_impl_sub_u128(0, 0, hi, lo, &hi);
+    }
+    fix128_t result;
+    result.hi = (hi > INT64_MAX) ? (int64_t)(hi - INT64_MIN) + INT64_MIN : (int64_t)hi;
+    result.lo = lo;
+    return result;
+}
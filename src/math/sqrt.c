@@ -0,0 +1,6 @@
+// The library always has out of line definitions, so that it can be linked with code which is
+// compiled either with or without FIX64_INLINE_MATH
+#undef FIX64_INLINE_MATH
+
+#include "fix64.h"
+#include "fix64/math/sqrt.h"
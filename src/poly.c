@@ -0,0 +1,598 @@
+#include "fix64.h"
+#include "fix64/impl.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The most fractional bits used for evaluation, which matches the library's Chebyshev kernels
+#define POLY_MAX_FRAC_BITS 62
+
+// Reciprocal of a non-zero width for poly_map. t = offset / width = offset * 2^shift / (width *
+// 2^shift), where the normalised width is in [2^63, 2^64) and its reciprocal is calculated as
+// (2^127 - 1) / normalised width
+static uint64_t poly_recip(uint64_t width, unsigned *recip_shift) {
+    unsigned shift = fix64_impl_clz64(width);
+    *recip_shift = 63 - shift;
+    return fix64_impl_div_u128_u64(INT64_MAX, UINT64_MAX, width << shift);
+}
+
+// Maps an offset in [0, width] onto t in [0, 1) as a UQ0.64, where t = 1 is represented by
+// 1 - 2^-64. The reciprocal is rounded down, so offsets up to the width give t < 1. Larger offsets
+// may not, so are clamped
+static inline uint64_t poly_map_offset(uint64_t offset, uint64_t recip, unsigned shift) {
+    uint64_t hi;
+    uint64_t lo = fix64_impl_mul_u64_u128(offset, recip, &hi);
+    if (FIX64_UNLIKELY(hi >> shift)) {
+        return UINT64_MAX;
+    }
+    return shift ? (hi << (64 - shift)) | (lo >> shift) : lo;
+}
+
+int fix64_poly_init(fix64_poly_t *poly, const fix64_t *coefs, size_t n, fix64_t lo, fix64_t hi,
+    fix64_poly_method_t method) {
+    if (n == 0 || lo.repr >= hi.repr) {
+        return -1;
+    }
+
+    // Each partial sum has a magnitude of at most the sum of the coefficients' magnitudes since
+    // 0 <= t <= 1. Leave one bit of headroom for the rounding errors of each step
+    uint64_t sum_hi = 0, sum_lo = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t mag = (coefs[i].repr < 0) ? UINT64_C(0) - coefs[i].repr : (uint64_t)coefs[i].repr;
+        sum_lo = fix64_impl_add_u128(sum_hi, sum_lo, 0, mag, &sum_hi);
+    }
+    unsigned sum_bits = sum_hi ? 128 - fix64_impl_clz64(sum_hi) :
+                                 (sum_lo ? 64 - fix64_impl_clz64(sum_lo) : 0);
+    if (sum_bits > 62 + FIX64_FRAC_BITS) {
+        return -1;
+    }
+    unsigned frac_bits = 62 + FIX64_FRAC_BITS - sum_bits;
+
+    poly->coefs = coefs;
+    poly->n = n;
+    poly->lo = lo;
+    poly->recip = poly_recip((uint64_t)hi.repr - (uint64_t)lo.repr, &poly->recip_shift);
+    poly->frac_bits = (frac_bits < POLY_MAX_FRAC_BITS) ? frac_bits : POLY_MAX_FRAC_BITS;
+    poly->method = method;
+    return 0;
+}
+
+// Maps x onto t in [0, 1) as a UQ0.64, where t = 1 is represented by 1 - 2^-64
+static inline uint64_t poly_map(const fix64_poly_t *poly, fix64_t x) {
+    if (FIX64_UNLIKELY(x.repr <= poly->lo.repr)) {
+        return 0;
+    }
+    uint64_t offset = (uint64_t)x.repr - (uint64_t)poly->lo.repr;
+    return poly_map_offset(offset, poly->recip, poly->recip_shift);
+}
+
+// Converts a coefficient to the evaluation format
+static inline int64_t poly_coef(fix64_t coef, unsigned frac_bits) {
+    if (frac_bits >= FIX64_FRAC_BITS) {
+        return (int64_t)((uint64_t)coef.repr << (frac_bits - FIX64_FRAC_BITS));
+    }
+    unsigned shift = FIX64_FRAC_BITS - frac_bits;
+    return (coef.repr >> shift) + ((coef.repr >> (shift - 1)) & 1);
+}
+
+// Multiplies by t, i.e. the upper half of the Q63.64 product like the Chebyshev kernels
+static inline int64_t poly_mul_t(int64_t value, uint64_t t) {
+    int64_t hi;
+    fix64_impl_mul_i64_u64_i128(value, t, &hi);
+    return hi;
+}
+
+static inline int64_t poly_horner(const fix64_poly_t *poly, uint64_t t) {
+    const unsigned frac_bits = poly->frac_bits;
+    int64_t sum = poly_coef(poly->coefs[poly->n - 1], frac_bits);
+    for (size_t i = poly->n - 1; i-- > 0;) {
+        sum = poly_mul_t(sum, t) + poly_coef(poly->coefs[i], frac_bits);
+    }
+    return sum;
+}
+
+static inline int64_t poly_estrin(const fix64_poly_t *poly, uint64_t t) {
+    const unsigned frac_bits = poly->frac_bits;
+    uint64_t t2, t4;
+    fix64_impl_mul_u64_u128(t, t, &t2);
+    fix64_impl_mul_u64_u128(t2, t2, &t4);
+
+    // Each block of 4 coefficients is (c0 + c1 * t) + t^2 * (c2 + c3 * t), and the blocks are
+    // combined with Horner's method in t^4. Missing coefficients in the last block are 0
+    int64_t sum = 0;
+    for (size_t block = (poly->n + 3) / 4; block-- > 0;) {
+        int64_t c[4] = { 0, 0, 0, 0 };
+        for (size_t i = 0; i < 4 && block * 4 + i < poly->n; i++) {
+            c[i] = poly_coef(poly->coefs[block * 4 + i], frac_bits);
+        }
+        int64_t lo = c[0] + poly_mul_t(c[1], t);
+        int64_t hi = c[2] + poly_mul_t(c[3], t);
+        sum = poly_mul_t(sum, t4) + lo + poly_mul_t(hi, t2);
+    }
+    return sum;
+}
+
+// Rounds the result of the evaluation to a fix64_t
+static inline fix64_t poly_round(int64_t value, unsigned frac_bits) {
+    if (frac_bits > FIX64_FRAC_BITS) {
+        // Round to nearest, with halfway values rounded up
+        unsigned shift = frac_bits - FIX64_FRAC_BITS;
+        return (fix64_t){ (value >> shift) + ((value >> (shift - 1)) & 1) };
+    }
+    unsigned shift = FIX64_FRAC_BITS - frac_bits;
+    if (FIX64_UNLIKELY(value > (INT64_MAX >> shift))) {
+        return FIX64_MAX;
+    } else if (FIX64_UNLIKELY(value < (INT64_MIN >> shift))) {
+        return FIX64_MIN;
+    }
+    return (fix64_t){ (int64_t)((uint64_t)value << shift) };
+}
+
+fix64_t fix64_poly_eval(const fix64_poly_t *poly, fix64_t x) {
+    uint64_t t = poly_map(poly, x);
+    int64_t value =
+        (poly->method == FIX64_POLY_ESTRIN) ? poly_estrin(poly, t) : poly_horner(poly, t);
+    return poly_round(value, poly->frac_bits);
+}
+
+void fix64_poly_eval_batch(
+    const fix64_poly_t *poly, const fix64_t *xs, fix64_t *ys, size_t count) {
+    // Separate loops so that the scheme isn't checked for every element
+    if (poly->method == FIX64_POLY_ESTRIN) {
+        for (size_t i = 0; i < count; i++) {
+            ys[i] = poly_round(poly_estrin(poly, poly_map(poly, xs[i])), poly->frac_bits);
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            ys[i] = poly_round(poly_horner(poly, poly_map(poly, xs[i])), poly->frac_bits);
+        }
+    }
+}
+
+// Finds the interval containing x and the offset into it as a UQ0.64
+static inline const int64_t *lut_interval(const fix64_lut_t *lut, fix64_t x, uint64_t *u) {
+    if (FIX64_UNLIKELY(x.repr < lut->lo.repr)) {
+        *u = 0;
+        return lut->coefs;
+    }
+    // Larger values are clamped to the last value in the table
+    uint64_t offset = (uint64_t)x.repr - (uint64_t)lut->lo.repr;
+    uint64_t index = offset >> lut->shift;
+    if (FIX64_UNLIKELY(index >= lut->size)) {
+        index = lut->size - 1;
+        offset = UINT64_MAX;
+    }
+    // The shift is less than 64 since the table fits in a fix64_t
+    *u = lut->shift ? offset << (64 - lut->shift) : 0;
+    return lut->coefs + index * lut->order;
+}
+
+static inline fix64_t lut_eval(const fix64_lut_t *lut, fix64_t x) {
+    uint64_t u;
+    const int64_t *coefs = lut_interval(lut, x, &u);
+    int64_t sum = coefs[lut->order - 1];
+    for (unsigned i = lut->order - 1; i-- > 0;) {
+        sum = poly_mul_t(sum, u) + coefs[i];
+    }
+    return poly_round(sum, lut->frac_bits);
+}
+
+fix64_t fix64_lut_eval(const fix64_lut_t *lut, fix64_t x) {
+    return lut_eval(lut, x);
+}
+
+void fix64_lut_eval_batch(const fix64_lut_t *lut, const fix64_t *xs, fix64_t *ys, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        ys[i] = lut_eval(lut, xs[i]);
+    }
+}
+
+int fix64_pwl_init(fix64_pwl_t *pwl, fix64_pwl_segment_t *segments, const fix64_t *xs,
+    const fix64_t *ys, size_t n) {
+    if (n == 0) {
+        return -1;
+    }
+    for (size_t i = 0; i + 1 < n; i++) {
+        if (xs[i].repr >= xs[i + 1].repr) {
+            return -1;
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        segments[i].x = xs[i];
+        segments[i].y = ys[i];
+        segments[i].recip = 0;
+        segments[i].recip_shift = 0;
+        if (i + 1 < n) {
+            uint64_t width = (uint64_t)xs[i + 1].repr - (uint64_t)xs[i].repr;
+            segments[i].recip = poly_recip(width, &segments[i].recip_shift);
+        }
+    }
+    pwl->segments = segments;
+    pwl->n = n;
+    return 0;
+}
+
+// The breakpoint at the start of segment i. Segments are stride bytes each, and start with their
+// breakpoint so that piecewise linear interpolations and splines can share the searches below
+static inline int64_t segment_x(const void *segments, size_t stride, size_t i) {
+    return ((const fix64_t *)(const void *)((const char *)segments + i * stride))->repr;
+}
+
+// Index of the segment containing x in [start, start + len), i.e. the last one which starts at or
+// before x, given that segment start does. The comparison becomes a conditional move, so there are
+// no mispredicted branches
+static inline size_t segment_search(
+    const void *segments, size_t stride, size_t start, size_t len, int64_t x) {
+    while (len > 1) {
+        size_t half = len / 2;
+        start = (segment_x(segments, stride, start + half) <= x) ? start + half : start;
+        len -= half;
+    }
+    return start;
+}
+
+// Index of the segment containing x out of the segments of n breakpoints, checking the segment
+// index and the one after it before searching all of them. x must be within the breakpoints. The
+// checks are combined into a single branch, which is predictable for both sorted and random
+// queries
+static inline size_t segment_search_from(
+    const void *segments, size_t stride, size_t n, size_t index, int64_t x) {
+    // x is before the last breakpoint, so if it's after the end of the segment index then the next
+    // segment isn't the last one
+    size_t next = index + (x >= segment_x(segments, stride, index + 1));
+    if ((segment_x(segments, stride, next) <= x) & (x < segment_x(segments, stride, next + 1))) {
+        return next;
+    }
+    return segment_search(segments, stride, 0, n - 1, x);
+}
+
+// Interpolates within a segment
+static inline fix64_t pwl_lerp(const fix64_pwl_segment_t *segment, int64_t x) {
+    uint64_t offset = (uint64_t)x - (uint64_t)segment->x.repr;
+    uint64_t t = poly_map_offset(offset, segment->recip, segment->recip_shift);
+
+    // y0 + t * (y1 - y0), with halfway values rounded up. The difference needs 65 bits, so it's
+    // dy - 2^64 where dy is the difference modulo 2^64 if y1 < y0. The result is between y0 and
+    // y1, so the upper half of the product can be calculated modulo 2^64
+    uint64_t y0 = (uint64_t)segment[0].y.repr;
+    uint64_t dy = (uint64_t)segment[1].y.repr - y0;
+    uint64_t hi;
+    uint64_t lo = fix64_impl_mul_u64_u128(t, dy, &hi);
+    hi += lo >> 63; // For rounding
+    hi -= (segment[1].y.repr < segment[0].y.repr) ? t : 0;
+    return (fix64_t){ (int64_t)(y0 + hi) };
+}
+
+// Clamps x to the breakpoints, returning whether it's outside of them and setting y if so
+static inline int pwl_clamp(const fix64_pwl_t *pwl, fix64_t x, fix64_t *y) {
+    if (FIX64_UNLIKELY(x.repr <= pwl->segments[0].x.repr)) {
+        *y = pwl->segments[0].y;
+        return 1;
+    } else if (FIX64_UNLIKELY(x.repr >= pwl->segments[pwl->n - 1].x.repr)) {
+        *y = pwl->segments[pwl->n - 1].y;
+        return 1;
+    }
+    return 0;
+}
+
+fix64_t fix64_pwl_eval(const fix64_pwl_t *pwl, fix64_t x) {
+    fix64_t y;
+    if (pwl_clamp(pwl, x, &y)) {
+        return y;
+    }
+    size_t index = segment_search(pwl->segments, sizeof(*pwl->segments), 0, pwl->n - 1, x.repr);
+    return pwl_lerp(pwl->segments + index, x.repr);
+}
+
+// Number of queries between choosing whether a batch evaluation uses the previous segment
+#define SEGMENT_BATCH_BLOCK 64
+
+// Starting from the previous segment only helps if most queries are in the same segment or the
+// next one. Otherwise each search depends on the last one, so the searches can't overlap and it's
+// slower than searching from scratch. So each block of queries uses the previous segment if most
+// of the last block's queries would have found it
+void fix64_pwl_eval_batch(const fix64_pwl_t *pwl, const fix64_t *xs, fix64_t *ys, size_t count) {
+    size_t index = 0;
+    int use_previous = 1;
+    for (size_t start = 0; start < count; start += SEGMENT_BATCH_BLOCK) {
+        size_t end = (count - start < SEGMENT_BATCH_BLOCK) ? count : start + SEGMENT_BATCH_BLOCK;
+        size_t near = 0;
+        for (size_t i = start; i < end; i++) {
+            fix64_t x = xs[i];
+            if (pwl_clamp(pwl, x, &ys[i])) {
+                near++;
+                continue;
+            }
+            size_t prev = index;
+            index = use_previous ?
+                segment_search_from(pwl->segments, sizeof(*pwl->segments), pwl->n, index, x.repr) :
+                segment_search(pwl->segments, sizeof(*pwl->segments), 0, pwl->n - 1, x.repr);
+            near += (index - prev <= 1);
+            ys[i] = pwl_lerp(pwl->segments + index, x.repr);
+        }
+        use_previous = (near * 4 >= (end - start) * 3);
+    }
+}
+
+// Validates the breakpoints and sets up the segments' mapping onto t
+static int spline_prepare(fix64_spline_t *spline, fix64_spline_segment_t *segments,
+    const fix64_t *xs, size_t n) {
+    if (n == 0) {
+        return -1;
+    }
+    for (size_t i = 0; i + 1 < n; i++) {
+        if (xs[i].repr >= xs[i + 1].repr) {
+            return -1;
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        segments[i].x = xs[i];
+        segments[i].recip = 0;
+        segments[i].recip_shift = 0;
+        if (i + 1 < n) {
+            uint64_t width = (uint64_t)xs[i + 1].repr - (uint64_t)xs[i].repr;
+            segments[i].recip = poly_recip(width, &segments[i].recip_shift);
+        }
+    }
+    spline->segments = segments;
+    spline->n = n;
+    return 0;
+}
+
+// Stores a fix128_t in two of a segment's coefficients, which hold temporary values until
+// spline_finish calculates the actual coefficients
+static inline void spline_store(fix64_spline_segment_t *segment, unsigned slot, fix128_t value) {
+    segment->coefs[slot] = value.hi;
+    segment->coefs[slot + 1] = (int64_t)value.lo;
+}
+
+static inline fix128_t spline_load(const fix64_spline_segment_t *segment, unsigned slot) {
+    fix128_t value = { segment->coefs[slot], (uint64_t)segment->coefs[slot + 1] };
+    return value;
+}
+
+// The width of segment i, which may be too large for a fix64_t
+static fix128_t spline_width(const fix64_t *xs, size_t i) {
+    uint64_t width = (uint64_t)xs[i + 1].repr - (uint64_t)xs[i].repr;
+    fix128_t result = { (int64_t)(width >> FIX64_FRAC_BITS), width << (64 - FIX64_FRAC_BITS) };
+    return result;
+}
+
+// The slope of the line between breakpoints i and i + 1
+static fix128_t spline_secant(const fix64_t *xs, const fix64_t *ys, size_t i) {
+    fix128_t dy = fix128_sub(fix128_from_fix64(ys[i + 1]), fix128_from_fix64(ys[i]));
+    return fix128_div_sat(dy, spline_width(xs, i));
+}
+
+// The coefficients of segment i's Hermite polynomial in t, given the slopes at both ends
+static void spline_hermite(const fix64_t *xs, const fix64_t *ys, size_t i, fix128_t slope0,
+    fix128_t slope1, fix128_t coefs[4]) {
+    // The derivatives with respect to t, i.e. scaled by the width of the segment
+    fix128_t width = spline_width(xs, i);
+    fix128_t m0 = fix128_mul_sat(slope0, width);
+    fix128_t m1 = fix128_mul_sat(slope1, width);
+    fix128_t dy = fix128_sub(fix128_from_fix64(ys[i + 1]), fix128_from_fix64(ys[i]));
+    fix128_t dy3 = fix128_mul_sat(dy, fix128_from_i64(3));
+    fix128_t dy2 = fix128_add(dy, dy);
+
+    coefs[0] = fix128_from_fix64(ys[i]);
+    coefs[1] = m0;
+    coefs[2] = fix128_sub_sat(fix128_sub_sat(fix128_sub_sat(dy3, m0), m0), m1);
+    coefs[3] = fix128_add_sat(fix128_sub_sat(m0, dy2), m1);
+}
+
+// Converts a coefficient to a format with frac_bits fractional bits, rounding to nearest
+static int64_t spline_coef(fix128_t coef, unsigned frac_bits) {
+    unsigned shift = 64 - frac_bits;
+    int64_t hi;
+    uint64_t lo = fix64_impl_add_i128(coef.hi, coef.lo, 0, UINT64_C(1) << (shift - 1), &hi);
+    return (shift == 64) ? hi : (int64_t)(((uint64_t)hi << (64 - shift)) | (lo >> shift));
+}
+
+// Number of significant bits in a magnitude
+static unsigned spline_bits(fix128_t mag) {
+    return mag.hi ? 128 - fix64_impl_clz64((uint64_t)mag.hi) : 64 - fix64_impl_clz64(mag.lo);
+}
+
+// Converts a segment's coefficients to the format with the most fractional bits where the sum of
+// their magnitudes is less than 2^62, like fix64_poly_init
+static int spline_segment_coefs(fix64_spline_segment_t *segment, const fix128_t coefs[4]) {
+    fix128_t sum = FIX128_ZERO;
+    for (unsigned i = 0; i < 4; i++) {
+        sum = fix128_add_sat(sum, fix128_abs(coefs[i]));
+    }
+    // A saturated sum has 127 bits
+    unsigned bits = spline_bits(sum);
+    if (bits > 62 + 64) {
+        return -1;
+    }
+    unsigned frac_bits = 62 + 64 - bits;
+    frac_bits = (frac_bits < POLY_MAX_FRAC_BITS) ? frac_bits : POLY_MAX_FRAC_BITS;
+    for (unsigned i = 0; i < 4; i++) {
+        segment->coefs[i] = spline_coef(coefs[i], frac_bits);
+    }
+    segment->frac_bits = frac_bits;
+    return 0;
+}
+
+// Calculates the coefficients of each segment from the slopes at the breakpoints, which have been
+// stored with spline_store in slot 0 of each segment
+static int spline_finish(fix64_spline_segment_t *segments, const fix64_t *xs, const fix64_t *ys,
+    size_t n) {
+    fix128_t coefs[4];
+    // Each segment needs the next one's slope, so go forwards
+    for (size_t i = 0; i + 1 < n; i++) {
+        spline_hermite(xs, ys, i, spline_load(&segments[i], 0), spline_load(&segments[i + 1], 0),
+            coefs);
+        if (spline_segment_coefs(&segments[i], coefs)) {
+            return -1;
+        }
+    }
+    // The last breakpoint's value, for x at or after it
+    coefs[0] = fix128_from_fix64(ys[n - 1]);
+    coefs[1] = coefs[2] = coefs[3] = FIX128_ZERO;
+    return spline_segment_coefs(&segments[n - 1], coefs);
+}
+
+// The slopes k of a natural spline satisfy mu_i * k_(i-1) + 2 * k_i + lambda_i * k_(i+1) =
+// 3 * (mu_i * d_(i-1) + lambda_i * d_i) at each interior breakpoint, where d_i is the secant of
+// segment i, mu_i = h_i / (h_(i-1) + h_i) and lambda_i = 1 - mu_i for segment widths h. The ends
+// have 2 * k_0 + k_1 = 3 * d_0 and k_(n-2) + 2 * k_(n-1) = 3 * d_(n-2). The system is diagonally
+// dominant with weights in [0, 1], so it's solved with the Thomas algorithm in fix128_t without
+// pivoting, and the intermediate values stay well scaled however wide the segments are
+int fix64_spline_init_natural(fix64_spline_t *spline, fix64_spline_segment_t *segments,
+    const fix64_t *xs, const fix64_t *ys, size_t n) {
+    if (spline_prepare(spline, segments, xs, n)) {
+        return -1;
+    }
+    if (n == 1) {
+        spline_store(&segments[0], 0, FIX128_ZERO);
+        return spline_finish(segments, xs, ys, n);
+    }
+
+    // Forward elimination, storing the modified upper diagonal c in slot 0 and the modified right
+    // hand side d in slot 2
+    const fix128_t two = fix128_from_i64(2), three = fix128_from_i64(3);
+    fix128_t secant = spline_secant(xs, ys, 0);
+    fix128_t c = FIX128_HALF;
+    fix128_t d = fix128_mul_sat(fix128_mul_sat(secant, three), FIX128_HALF);
+    spline_store(&segments[0], 0, c);
+    spline_store(&segments[0], 2, d);
+    for (size_t i = 1; i < n; i++) {
+        fix128_t mu = FIX128_ONE, lambda = FIX128_ZERO, rhs;
+        if (i + 1 < n) {
+            fix128_t next_secant = spline_secant(xs, ys, i);
+            fix128_t width = spline_width(xs, i);
+            mu = fix128_div(width, fix128_add(spline_width(xs, i - 1), width));
+            lambda = fix128_sub(FIX128_ONE, mu);
+            rhs = fix128_add_sat(fix128_mul_sat(mu, secant), fix128_mul_sat(lambda, next_secant));
+            secant = next_secant;
+        } else {
+            rhs = secant;
+        }
+        fix128_t denom = fix128_sub(two, fix128_mul(mu, c));
+        c = fix128_div(lambda, denom);
+        rhs = fix128_sub_sat(fix128_mul_sat(rhs, three), fix128_mul_sat(mu, d));
+        d = fix128_div_sat(rhs, denom);
+        spline_store(&segments[i], 0, c);
+        spline_store(&segments[i], 2, d);
+    }
+
+    // Back substitution, replacing c with the slope
+    fix128_t slope = d;
+    spline_store(&segments[n - 1], 0, slope);
+    for (size_t i = n - 1; i-- > 0;) {
+        c = spline_load(&segments[i], 0);
+        slope = fix128_sub_sat(spline_load(&segments[i], 2), fix128_mul_sat(c, slope));
+        spline_store(&segments[i], 0, slope);
+    }
+    return spline_finish(segments, xs, ys, n);
+}
+
+int fix64_spline_init_monotone(fix64_spline_t *spline, fix64_spline_segment_t *segments,
+    const fix64_t *xs, const fix64_t *ys, size_t n) {
+    if (spline_prepare(spline, segments, xs, n)) {
+        return -1;
+    }
+    if (n == 1) {
+        spline_store(&segments[0], 0, FIX128_ZERO);
+        return spline_finish(segments, xs, ys, n);
+    }
+
+    // The ends use the secant of their segment
+    const fix128_t three = fix128_from_i64(3);
+    fix128_t prev = spline_secant(xs, ys, 0);
+    spline_store(&segments[0], 0, prev);
+    for (size_t i = 1; i + 1 < n; i++) {
+        fix128_t next = spline_secant(xs, ys, i);
+        fix128_t slope = FIX128_ZERO;
+        // Local extrema and flat segments have a slope of zero
+        if ((prev.hi < 0) == (next.hi < 0) && fix128_neq(prev, FIX128_ZERO) &&
+            fix128_neq(next, FIX128_ZERO)) {
+            fix128_t abs_prev = fix128_abs(prev), abs_next = fix128_abs(next);
+            fix128_t mean = fix128_mul(fix128_add_sat(abs_prev, abs_next), FIX128_HALF);
+            fix128_t min = fix128_lt(abs_prev, abs_next) ? abs_prev : abs_next;
+            fix128_t limit = fix128_mul_sat(min, three);
+            slope = fix128_lt(mean, limit) ? mean : limit;
+            slope = (prev.hi < 0) ? fix128_neg(slope) : slope;
+        }
+        spline_store(&segments[i], 0, slope);
+        prev = next;
+    }
+    spline_store(&segments[n - 1], 0, prev);
+    return spline_finish(segments, xs, ys, n);
+}
+
+int fix64_spline_init_hermite(fix64_spline_t *spline, fix64_spline_segment_t *segments,
+    const fix64_t *xs, const fix64_t *ys, const fix64_t *slopes, size_t n) {
+    if (spline_prepare(spline, segments, xs, n)) {
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        spline_store(&segments[i], 0, fix128_from_fix64(slopes[i]));
+    }
+    return spline_finish(segments, xs, ys, n);
+}
+
+// Index of the segment to evaluate at x, clamping x to the breakpoints. The last segment is only
+// the last breakpoint's value
+static inline size_t spline_clamp(const fix64_spline_t *spline, fix64_t *x) {
+    const fix64_spline_segment_t *segments = spline->segments;
+    if (FIX64_UNLIKELY(x->repr >= segments[spline->n - 1].x.repr)) {
+        *x = segments[spline->n - 1].x;
+        return spline->n - 1;
+    } else if (FIX64_UNLIKELY(x->repr <= segments[0].x.repr)) {
+        *x = segments[0].x;
+        return 0;
+    }
+    return SIZE_MAX;
+}
+
+static inline fix64_t spline_eval(const fix64_spline_t *spline, size_t index, fix64_t x) {
+    const fix64_spline_segment_t *segment = spline->segments + index;
+    uint64_t offset = (uint64_t)x.repr - (uint64_t)segment->x.repr;
+    uint64_t t = poly_map_offset(offset, segment->recip, segment->recip_shift);
+    int64_t sum = segment->coefs[3];
+    for (unsigned i = 3; i-- > 0;) {
+        sum = poly_mul_t(sum, t) + segment->coefs[i];
+    }
+    return poly_round(sum, segment->frac_bits);
+}
+
+fix64_t fix64_spline_eval(const fix64_spline_t *spline, fix64_t x) {
+    size_t index = spline_clamp(spline, &x);
+    if (index == SIZE_MAX) {
+        const size_t stride = sizeof(*spline->segments);
+        index = segment_search(spline->segments, stride, 0, spline->n - 1, x.repr);
+    }
+    return spline_eval(spline, index, x);
+}
+
+// Uses the previous segment like fix64_pwl_eval_batch
+void fix64_spline_eval_batch(
+    const fix64_spline_t *spline, const fix64_t *xs, fix64_t *ys, size_t count) {
+    const size_t stride = sizeof(*spline->segments);
+    size_t index = 0;
+    int use_previous = 1;
+    for (size_t start = 0; start < count; start += SEGMENT_BATCH_BLOCK) {
+        size_t end = (count - start < SEGMENT_BATCH_BLOCK) ? count : start + SEGMENT_BATCH_BLOCK;
+        size_t near = 0;
+        for (size_t i = start; i < end; i++) {
+            fix64_t x = xs[i];
+            size_t clamped = spline_clamp(spline, &x);
+            if (clamped != SIZE_MAX) {
+                near++;
+                ys[i] = spline_eval(spline, clamped, x);
+                continue;
+            }
+            size_t prev = index;
+            index = use_previous ?
+                segment_search_from(spline->segments, stride, spline->n, index, x.repr) :
+                segment_search(spline->segments, stride, 0, spline->n - 1, x.repr);
+            near += (index - prev <= 1);
+            ys[i] = spline_eval(spline, index, x);
+        }
+        use_previous = (near * 4 >= (end - start) * 3);
+    }
+}
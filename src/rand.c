@@ -0,0 +1,137 @@
+#include "fix64.h"
+#include "fix64/impl.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rand.inc"
+
+void fix64_rng_seed(fix64_rng_t *rng, uint64_t seed) {
+    // SplitMix64, see https://prng.di.unimi.it/splitmix64.c
+    for (size_t i = 0; i < 4; i++) {
+        seed += UINT64_C(0x9e3779b97f4a7c15);
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+        z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+        rng->state[i] = z ^ (z >> 31);
+    }
+}
+
+void fix64_rng_jump(fix64_rng_t *rng) {
+    // See https://prng.di.unimi.it/xoshiro256starstar.c
+    static const uint64_t jump[4] = {
+        UINT64_C(0x180ec6d33cfd0aba),
+        UINT64_C(0xd5a61266f0c9392c),
+        UINT64_C(0xa9582618e03fc9aa),
+        UINT64_C(0x39abdc4529b1661c),
+    };
+
+    uint64_t s[4] = { 0, 0, 0, 0 };
+    for (size_t i = 0; i < 4; i++) {
+        for (unsigned b = 0; b < 64; b++) {
+            if (jump[i] & (UINT64_C(1) << b)) {
+                s[0] ^= rng->state[0];
+                s[1] ^= rng->state[1];
+                s[2] ^= rng->state[2];
+                s[3] ^= rng->state[3];
+            }
+            fix64_rng_next(rng);
+        }
+    }
+    for (size_t i = 0; i < 4; i++) {
+        rng->state[i] = s[i];
+    }
+}
+
+void fix64_rng_split(fix64_rng_t *rng, fix64_rng_t *stream) {
+    *stream = *rng;
+    fix64_rng_jump(rng);
+}
+
+// Uniform random number in (0, 1], which is safe to take the log of
+static fix64_t rand_uniform_nonzero(fix64_rng_t *rng) {
+    return (fix64_t){ fix64_rng_uniform(rng).repr + 1 };
+}
+
+// Samples one of the ziggurats in src/rand.inc.jinja. The layer is chosen by the lowest 8 bits of
+// a random number, and the position within the layer by the top bits. For the normal distribution
+// bit 8 gives the sign
+static fix64_t rand_ziggurat(fix64_rng_t *rng, int normal) {
+    const uint64_t *ratios = normal ? normal_ratios : exponential_ratios;
+    const int64_t *xs = normal ? normal_x : exponential_x;
+    const int64_t *fs = normal ? normal_f : exponential_f;
+
+    for (;;) {
+        uint64_t bits = fix64_rng_next(rng);
+        size_t layer = bits & 0xff;
+        uint64_t neg = normal ? (0 - ((bits >> 8) & 1)) : 0; // = -(result < 0)
+        uint64_t u = bits & ~UINT64_C(0x1ff); // UQ0.64
+
+        uint64_t x;
+        fix64_impl_mul_u64_u128(u, xs[layer], &x);
+
+        // Inside the rectangle below the next layer, which is by far the most common case
+        if (FIX64_LIKELY(u < ratios[layer])) {
+            return (fix64_t){ (int64_t)((x ^ neg) - neg) };
+        }
+
+        if (layer == 0) {
+            // The tail beyond r. The exponential distribution is memoryless, so its tail is just a
+            // shifted exponential
+            if (!normal) {
+                fix64_t tail = fix64_neg(fix64_log(rand_uniform_nonzero(rng)));
+                return fix64_add((fix64_t){ RAND_EXPONENTIAL_R }, tail);
+            }
+
+            // Marsaglia's method for the normal distribution's tail
+            fix64_t r = { RAND_NORMAL_R };
+            fix64_t tail, y;
+            do {
+                tail = fix64_div(fix64_neg(fix64_log(rand_uniform_nonzero(rng))), r);
+                y = fix64_neg(fix64_log(rand_uniform_nonzero(rng)));
+            } while (fix64_lt(fix64_add(y, y), fix64_mul(tail, tail)));
+            x = (uint64_t)fix64_add(r, tail).repr;
+            return (fix64_t){ (int64_t)((x ^ neg) - neg) };
+        }
+
+        // In the wedge between the rectangle and the next layer, accept if a random point in it
+        // is below the density
+        uint64_t dy;
+        fix64_impl_mul_u64_u128(fix64_rng_next(rng), fs[layer + 1] - fs[layer], &dy);
+        fix64_t y = { fs[layer] + (int64_t)dy };
+        fix64_t fx = { (int64_t)x };
+        if (normal) {
+            fx = fix64_mul(fx, fx);
+            fx.repr >>= 1; // exp(-x^2 / 2)
+        }
+        if (fix64_lt(y, fix64_exp(fix64_neg(fx)))) {
+            return (fix64_t){ (int64_t)((x ^ neg) - neg) };
+        }
+    }
+}
+
+fix64_t fix64_rng_normal(fix64_rng_t *rng) {
+    return rand_ziggurat(rng, 1);
+}
+
+fix64_t fix64_rng_exponential(fix64_rng_t *rng) {
+    return rand_ziggurat(rng, 0);
+}
+
+void fix64_rng_uniform_batch(fix64_rng_t *rng, fix64_t *out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = fix64_rng_uniform(rng);
+    }
+}
+
+void fix64_rng_normal_batch(fix64_rng_t *rng, fix64_t *out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = rand_ziggurat(rng, 1);
+    }
+}
+
+void fix64_rng_exponential_batch(fix64_rng_t *rng, fix64_t *out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = rand_ziggurat(rng, 0);
+    }
+}
@@ -0,0 +1,13 @@
+#include "fix64.h"
+#include "fix64/impl.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "recip.inc"
+
+void fix64_recip_batch(const fix64_t *xs, fix64_t *ys, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        ys[i] = fix64_recip(xs[i]);
+    }
+}
@@ -0,0 +1,432 @@
+#include "fix64.h"
+#include "fix64/impl.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Number of elements which are summed in 64-bit lanes before they're added to a 128-bit total.
+// Each lane adds 32-bit halves, so it can't overflow within a block
+#define STATS_BLOCK (UINT64_C(1) << 30)
+
+// Unsigned 192-bit accumulator for sums of squares, which are up to 128 bits each
+typedef struct {
+    uint64_t top;
+    uint64_t hi;
+    uint64_t lo;
+} stats_acc_t;
+
+// acc += x * x
+static inline void stats_add_square(stats_acc_t *acc, uint64_t x) {
+    uint64_t sq_hi, carry;
+    uint64_t sq_lo = fix64_impl_mul_u64_u128(x, x, &sq_hi);
+    acc->lo = fix64_impl_add_u128(0, acc->lo, 0, sq_lo, &carry);
+    acc->hi = fix64_impl_add_u128(0, acc->hi, 0, sq_hi + carry, &carry);
+    acc->top += carry;
+}
+
+// acc -= x * x, where the result must be non-negative
+static inline void stats_sub_square(stats_acc_t *acc, uint64_t x) {
+    uint64_t sq_hi, borrow;
+    uint64_t sq_lo = fix64_impl_mul_u64_u128(x, x, &sq_hi);
+    acc->lo = fix64_impl_sub_u128(0, acc->lo, 0, sq_lo, &borrow);
+    acc->hi = fix64_impl_sub_u128(0, acc->hi, 0, sq_hi + (borrow & 1), &borrow);
+    acc->top -= borrow & 1;
+}
+
+static inline uint64_t stats_abs(int64_t x) {
+    return (x < 0) ? UINT64_C(0) - (uint64_t)x : (uint64_t)x;
+}
+
+// Exact sum of the elements' representations as a signed 128-bit integer. The elements are offset
+// by 2^63 so they're unsigned, and their 32-bit halves are added separately with plain 64-bit
+// additions, which compilers vectorise
+static uint64_t stats_sum_i128(const fix64_t *xs, size_t count, int64_t *hi) {
+    int64_t sum_hi = 0;
+    uint64_t sum_lo = 0;
+    while (count > 0) {
+        size_t n = (count < STATS_BLOCK) ? count : (size_t)STATS_BLOCK;
+        uint64_t upper = 0, lower = 0;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t u = (uint64_t)xs[i].repr ^ (UINT64_C(1) << 63);
+            upper += u >> 32;
+            lower += u & UINT32_MAX;
+        }
+        // Add upper * 2^32 + lower - n * 2^63
+        sum_lo = fix64_impl_add_i128(sum_hi, sum_lo, (int64_t)(upper >> 32), upper << 32, &sum_hi);
+        sum_lo = fix64_impl_add_i128(sum_hi, sum_lo, 0, lower, &sum_hi);
+        sum_lo = fix64_impl_sub_i128(sum_hi, sum_lo, (int64_t)(n >> 1), (uint64_t)n << 63, &sum_hi);
+        xs += n;
+        count -= n;
+    }
+    *hi = sum_hi;
+    return sum_lo;
+}
+
+// The mean of count values with a sum of sum_hi:sum_lo, with halfway values rounded away from
+// zero. It always fits since it's between the smallest and largest values
+static int64_t stats_mean(int64_t sum_hi, uint64_t sum_lo, uint64_t count) {
+    // |sum| <= count * 2^63, so the quotient of the magnitude always fits
+    uint64_t mag_hi = (uint64_t)sum_hi, mag_lo = sum_lo;
+    if (sum_hi < 0) {
+        mag_lo = fix64_impl_sub_u128(0, 0, mag_hi, mag_lo, &mag_hi);
+    }
+    uint64_t quot = fix64_impl_div_u128_u64(mag_hi, mag_lo, count);
+    uint64_t rem = mag_lo - quot * count;
+    quot += (rem >= count - rem);
+    return (sum_hi < 0) ? (int64_t)(UINT64_C(0) - quot) : (int64_t)quot;
+}
+
+// The variance needs the sum of squared differences from the exact mean m = q + r / n, where q is
+// the rounded mean and |r| <= n / 2. With T = sum((x - q)^2) = a * n + b, the variance (in units
+// of 2^-64) is T / n - r^2 / n^2 = a + (b * n - r^2) / n^2, where the fraction is in (-1, 1). So
+// rounding it to a fix64_t only needs a and the sign of the fraction. T must be less than n * 2^128
+static fix64_t stats_variance(stats_acc_t t, uint64_t r, uint64_t n) {
+    // Long division of T by n
+    uint64_t a_hi = fix64_impl_div_u128_u64(t.top, t.hi, n);
+    uint64_t rem = t.hi - a_hi * n;
+    uint64_t a_lo = fix64_impl_div_u128_u64(rem, t.lo, n);
+    uint64_t b = t.lo - a_lo * n;
+
+    uint64_t bn_hi, r2_hi;
+    uint64_t bn_lo = fix64_impl_mul_u64_u128(b, n, &bn_hi);
+    uint64_t r2_lo = fix64_impl_mul_u64_u128(r, r, &r2_hi);
+    int frac_neg = (bn_hi < r2_hi) || (bn_hi == r2_hi && bn_lo < r2_lo);
+
+    // Round (a + frac) / 2^32 to nearest. a is an integer, so the fraction only matters if it's
+    // negative and a + 2^31 is a multiple of 2^32
+    a_lo = fix64_impl_add_u128(a_hi, a_lo, 0, UINT64_C(1) << (63 - FIX64_FRAC_BITS), &a_hi);
+    uint64_t result_hi = a_hi >> FIX64_FRAC_BITS;
+    uint64_t result = (a_hi << (64 - FIX64_FRAC_BITS)) | (a_lo >> FIX64_FRAC_BITS);
+    if (frac_neg && (a_lo & UINT32_MAX) == 0) {
+        result_hi -= (result == 0);
+        result--;
+    }
+    if (FIX64_UNLIKELY(result_hi != 0 || result > INT64_MAX)) {
+        return FIX64_MAX;
+    }
+    return (fix64_t){ (int64_t)result };
+}
+
+fix64_t fix64_array_sum(const fix64_t *xs, size_t count) {
+    int64_t hi;
+    uint64_t lo = stats_sum_i128(xs, count, &hi);
+    if (FIX64_UNLIKELY(hi != ((int64_t)lo >> 63))) {
+        return (hi < 0) ? FIX64_MIN : FIX64_MAX;
+    }
+    return (fix64_t){ (int64_t)lo };
+}
+
+fix128_t fix64_array_sum_fix128(const fix64_t *xs, size_t count) {
+    int64_t hi;
+    uint64_t lo = stats_sum_i128(xs, count, &hi);
+    fix128_t result;
+    result.hi = (int64_t)(((uint64_t)hi << (64 - FIX64_FRAC_BITS)) | (lo >> FIX64_FRAC_BITS));
+    result.lo = lo << (64 - FIX64_FRAC_BITS);
+    return result;
+}
+
+fix64_t fix64_array_mean(const fix64_t *xs, size_t count) {
+    if (count == 0) {
+        return FIX64_ZERO;
+    }
+    int64_t sum_hi;
+    uint64_t sum_lo = stats_sum_i128(xs, count, &sum_hi);
+    return (fix64_t){ stats_mean(sum_hi, sum_lo, count) };
+}
+
+fix64_t fix64_array_min(const fix64_t *xs, size_t count) {
+    int64_t result = INT64_MAX;
+    for (size_t i = 0; i < count; i++) {
+        result = (xs[i].repr < result) ? xs[i].repr : result;
+    }
+    return (fix64_t){ result };
+}
+
+fix64_t fix64_array_max(const fix64_t *xs, size_t count) {
+    int64_t result = INT64_MIN;
+    for (size_t i = 0; i < count; i++) {
+        result = (xs[i].repr > result) ? xs[i].repr : result;
+    }
+    return (fix64_t){ result };
+}
+
+// Finding the extreme value first lets that loop be vectorised, and the search for its first
+// index usually stops early
+size_t fix64_array_argmin(const fix64_t *xs, size_t count) {
+    int64_t min = fix64_array_min(xs, count).repr;
+    size_t i = 0;
+    while (i + 1 < count && xs[i].repr != min) {
+        i++;
+    }
+    return i;
+}
+
+size_t fix64_array_argmax(const fix64_t *xs, size_t count) {
+    int64_t max = fix64_array_max(xs, count).repr;
+    size_t i = 0;
+    while (i + 1 < count && xs[i].repr != max) {
+        i++;
+    }
+    return i;
+}
+
+fix64_t fix64_array_variance(const fix64_t *xs, size_t count) {
+    if (count == 0) {
+        return FIX64_ZERO;
+    }
+    int64_t sum_hi, nq_hi;
+    uint64_t sum_lo = stats_sum_i128(xs, count, &sum_hi);
+    int64_t q = stats_mean(sum_hi, sum_lo, count);
+    uint64_t nq_lo = fix64_impl_mul_i64_u64_i128(q, count, &nq_hi);
+    uint64_t r = stats_abs((int64_t)fix64_impl_sub_i128(sum_hi, sum_lo, nq_hi, nq_lo, &sum_hi));
+
+    // q is between the smallest and largest elements, so each difference fits in a uint64_t and
+    // T < n * 2^128
+    stats_acc_t acc = { 0, 0, 0 };
+    for (size_t i = 0; i < count; i++) {
+        int64_t x = xs[i].repr;
+        stats_add_square(&acc, (x >= q) ? (uint64_t)x - (uint64_t)q : (uint64_t)q - (uint64_t)x);
+    }
+    return stats_variance(acc, r, count);
+}
+
+fix64_t fix64_array_norm1(const fix64_t *xs, size_t count) {
+    uint64_t sum_hi = 0, sum_lo = 0;
+    while (count > 0) {
+        size_t n = (count < STATS_BLOCK) ? count : (size_t)STATS_BLOCK;
+        uint64_t upper = 0, lower = 0;
+        for (size_t i = 0; i < n; i++) {
+            // stats_abs without a branch or an arithmetic shift, which SSE2 doesn't have
+            uint64_t sign = UINT64_C(0) - ((uint64_t)xs[i].repr >> 63);
+            uint64_t u = ((uint64_t)xs[i].repr ^ sign) - sign;
+            upper += u >> 32;
+            lower += u & UINT32_MAX;
+        }
+        sum_lo = fix64_impl_add_u128(sum_hi, sum_lo, upper >> 32, upper << 32, &sum_hi);
+        sum_lo = fix64_impl_add_u128(sum_hi, sum_lo, 0, lower, &sum_hi);
+        xs += n;
+        count -= n;
+    }
+    if (FIX64_UNLIKELY(sum_hi != 0 || sum_lo > INT64_MAX)) {
+        return FIX64_MAX;
+    }
+    return (fix64_t){ (int64_t)sum_lo };
+}
+
+// There's no SIMD for the sums of squares: each square needs a 64x64->128-bit multiply, which no
+// common vector instruction set has
+fix64_t fix64_array_norm2(const fix64_t *xs, size_t count) {
+    stats_acc_t acc = { 0, 0, 0 };
+    for (size_t i = 0; i < count; i++) {
+        stats_add_square(&acc, stats_abs(xs[i].repr));
+    }
+    // sqrt(2^126) = 2^63 is already out of range
+    if (FIX64_UNLIKELY(acc.top != 0 || (acc.hi >> 62) != 0)) {
+        return FIX64_MAX;
+    }
+
+    // Round the square root to nearest. sqrt(u) >= s + 1/2 iff u >= s^2 + s + 1/4, and since u is
+    // an integer that's when u - s^2 > s
+    uint64_t root = fix64_impl_sqrt_u128(acc.hi, acc.lo);
+    uint64_t sq_hi, rem_hi;
+    uint64_t sq_lo = fix64_impl_mul_u64_u128(root, root, &sq_hi);
+    uint64_t rem_lo = fix64_impl_sub_u128(acc.hi, acc.lo, sq_hi, sq_lo, &rem_hi);
+    root += (rem_hi != 0 || rem_lo > root);
+    if (FIX64_UNLIKELY(root > INT64_MAX)) {
+        return FIX64_MAX;
+    }
+    return (fix64_t){ (int64_t)root };
+}
+
+int fix64_ema_init(fix64_ema_t *ema, fix64_t alpha) {
+    if (alpha.repr <= 0 || alpha.repr > FIX64_ONE.repr) {
+        return -1;
+    }
+    ema->value = FIX128_ZERO;
+    ema->decay = UINT64_C(0) - ((uint64_t)alpha.repr << (64 - FIX64_FRAC_BITS));
+    ema->started = 0;
+    return 0;
+}
+
+int fix64_ema_init_span(fix64_ema_t *ema, size_t span) {
+    if (span == 0) {
+        return -1;
+    }
+    // 1 - 2 / (span + 1) = (span - 1) / (span + 1), rounded down
+    ema->value = FIX128_ZERO;
+    uint64_t n = (uint64_t)span;
+    ema->decay = (n == UINT64_MAX) ? UINT64_MAX : fix64_impl_div_u128_u64(n - 1, 0, n + 1);
+    ema->started = 0;
+    return 0;
+}
+
+void fix64_ema_push_block(fix64_ema_t *ema, const fix64_t *xs, fix64_t *out, size_t count) {
+    fix64_ema_t state = *ema;
+    for (size_t i = 0; i < count; i++) {
+        fix64_t value = fix64_ema_push(&state, xs[i]);
+        if (out) {
+            out[i] = value;
+        }
+    }
+    *ema = state;
+}
+
+int fix64_rolling_init(fix64_rolling_t *roll, fix64_t *values, size_t window) {
+    if (window == 0) {
+        return -1;
+    }
+    roll->values = values;
+    roll->window = window;
+    roll->count = 0;
+    roll->head = 0;
+    roll->sum_hi = 0;
+    roll->sum_lo = 0;
+    roll->sum_sq[0] = roll->sum_sq[1] = roll->sum_sq[2] = 0;
+    return 0;
+}
+
+void fix64_rolling_push(fix64_rolling_t *roll, fix64_t x) {
+    stats_acc_t sum_sq = { roll->sum_sq[0], roll->sum_sq[1], roll->sum_sq[2] };
+    if (roll->count == roll->window) {
+        // Replace the oldest value
+        fix64_t old = roll->values[roll->head];
+        roll->sum_lo = fix64_impl_sub_i128(
+            roll->sum_hi, roll->sum_lo, old.repr >> 63, (uint64_t)old.repr, &roll->sum_hi);
+        stats_sub_square(&sum_sq, stats_abs(old.repr));
+        roll->values[roll->head] = x;
+        roll->head = (roll->head + 1 == roll->window) ? 0 : roll->head + 1;
+    } else {
+        size_t tail = roll->head + roll->count;
+        roll->values[(tail >= roll->window) ? tail - roll->window : tail] = x;
+        roll->count++;
+    }
+    roll->sum_lo = fix64_impl_add_i128(
+        roll->sum_hi, roll->sum_lo, x.repr >> 63, (uint64_t)x.repr, &roll->sum_hi);
+    stats_add_square(&sum_sq, stats_abs(x.repr));
+    roll->sum_sq[0] = sum_sq.top;
+    roll->sum_sq[1] = sum_sq.hi;
+    roll->sum_sq[2] = sum_sq.lo;
+}
+
+void fix64_rolling_push_block(fix64_rolling_t *roll, const fix64_t *xs, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        fix64_rolling_push(roll, xs[i]);
+    }
+}
+
+fix64_t fix64_rolling_sum(const fix64_rolling_t *roll) {
+    if (FIX64_UNLIKELY(roll->sum_hi != ((int64_t)roll->sum_lo >> 63))) {
+        return (roll->sum_hi < 0) ? FIX64_MIN : FIX64_MAX;
+    }
+    return (fix64_t){ (int64_t)roll->sum_lo };
+}
+
+fix64_t fix64_rolling_mean(const fix64_rolling_t *roll) {
+    if (roll->count == 0) {
+        return FIX64_ZERO;
+    }
+    return (fix64_t){ stats_mean(roll->sum_hi, roll->sum_lo, roll->count) };
+}
+
+// Uses the same method as fix64_array_variance, but T is found from the sums as
+// sum(x^2) - 2 * q * sum(x) + n * q^2 = sum(x^2) - q * (sum(x) + r), where r = sum(x) - n * q
+fix64_t fix64_rolling_variance(const fix64_rolling_t *roll) {
+    size_t n = roll->count;
+    if (n == 0) {
+        return FIX64_ZERO;
+    }
+    int64_t q = stats_mean(roll->sum_hi, roll->sum_lo, n);
+    int64_t r_hi, m_hi;
+    uint64_t nq_lo = fix64_impl_mul_i64_u64_i128(q, n, &r_hi);
+    uint64_t r_lo = fix64_impl_sub_i128(roll->sum_hi, roll->sum_lo, r_hi, nq_lo, &r_hi);
+    uint64_t m_lo = fix64_impl_add_i128(roll->sum_hi, roll->sum_lo, r_hi, r_lo, &m_hi);
+
+    // The magnitude of q * m as a 192-bit integer
+    uint64_t mag_hi = (uint64_t)m_hi, mag_lo = m_lo;
+    if (m_hi < 0) {
+        mag_lo = fix64_impl_sub_u128(0, 0, mag_hi, mag_lo, &mag_hi);
+    }
+    stats_acc_t prod;
+    uint64_t p_hi, carry;
+    prod.lo = fix64_impl_mul_u64_u128(stats_abs(q), mag_lo, &p_hi);
+    prod.hi = fix64_impl_mul_u64_u128(stats_abs(q), mag_hi, &prod.top);
+    prod.hi = fix64_impl_add_u128(0, prod.hi, 0, p_hi, &carry);
+    prod.top += carry;
+
+    // T = sum(x^2) -/+ |q * m|, which is exact since T is non-negative and less than n * 2^128
+    stats_acc_t t = { roll->sum_sq[0], roll->sum_sq[1], roll->sum_sq[2] };
+    uint64_t carry_lo, carry_hi;
+    if ((q < 0) != (m_hi < 0)) {
+        t.lo = fix64_impl_add_u128(0, t.lo, 0, prod.lo, &carry_lo);
+        t.hi = fix64_impl_add_u128(0, t.hi, 0, prod.hi, &carry_hi);
+        t.hi = fix64_impl_add_u128(carry_hi, t.hi, 0, carry_lo, &carry_hi);
+        t.top += prod.top + carry_hi;
+    } else {
+        // The high halves of the differences are 0 or -1, i.e. the negated borrow
+        t.lo = fix64_impl_sub_u128(0, t.lo, 0, prod.lo, &carry_lo);
+        t.hi = fix64_impl_sub_u128(0, t.hi, 0, prod.hi, &carry_hi);
+        t.hi = fix64_impl_sub_u128(carry_hi, t.hi, 0, carry_lo & 1, &carry_hi);
+        t.top += carry_hi - prod.top;
+    }
+    return stats_variance(t, stats_abs((int64_t)r_lo), n);
+}
+
+int fix64_rolling_minmax_init(
+    fix64_rolling_minmax_t *roll, fix64_rolling_entry_t *entries, size_t window) {
+    if (window == 0) {
+        return -1;
+    }
+    roll->entries = entries;
+    roll->window = window;
+    roll->next = 0;
+    roll->min_head = roll->min_len = 0;
+    roll->max_head = roll->max_len = 0;
+    return 0;
+}
+
+// Pushes a value onto a monotonic queue, which is increasing for the minimum (so its front is the
+// minimum) and decreasing for the maximum. Values which can never be the front are removed
+static void stats_queue_push(fix64_rolling_entry_t *queue, size_t window, size_t *head,
+    size_t *len, fix64_t x, uint64_t index, int is_max) {
+    // The front expires when it leaves the window, which only happens to one value at a time
+    if (*len > 0 && queue[*head].index + window <= index) {
+        *head = (*head + 1 == window) ? 0 : *head + 1;
+        (*len)--;
+    }
+    while (*len > 0) {
+        size_t back = *head + *len - 1;
+        back = (back >= window) ? back - window : back;
+        int64_t value = queue[back].value.repr;
+        if (is_max ? (value > x.repr) : (value < x.repr)) {
+            break;
+        }
+        (*len)--;
+    }
+    size_t tail = *head + *len;
+    tail = (tail >= window) ? tail - window : tail;
+    queue[tail].value = x;
+    queue[tail].index = index;
+    (*len)++;
+}
+
+void fix64_rolling_minmax_push(fix64_rolling_minmax_t *roll, fix64_t x) {
+    uint64_t index = roll->next++;
+    stats_queue_push(roll->entries, roll->window, &roll->min_head, &roll->min_len, x, index, 0);
+    stats_queue_push(roll->entries + roll->window, roll->window, &roll->max_head, &roll->max_len,
+        x, index, 1);
+}
+
+void fix64_rolling_minmax_push_block(
+    fix64_rolling_minmax_t *roll, const fix64_t *xs, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        fix64_rolling_minmax_push(roll, xs[i]);
+    }
+}
+
+fix64_t fix64_rolling_min(const fix64_rolling_minmax_t *roll) {
+    return (roll->min_len > 0) ? roll->entries[roll->min_head].value : FIX64_MAX;
+}
+
+fix64_t fix64_rolling_max(const fix64_rolling_minmax_t *roll) {
+    return (roll->max_len > 0) ? roll->entries[roll->window + roll->max_head].value : FIX64_MIN;
+}
@@ -27,21 +27,48 @@ static inline const char *decimal_100(uint32_t x) {
              "90919293949596979899"[x * 2]);
 }
 
-static char *fmt_frac_10(char *buf, uint64_t repr, unsigned prec) {
-    const unsigned max_prec = sizeof(frac_10_rounding) / sizeof(frac_10_rounding[0]) - 1;
+static unsigned digits_64(uint64_t arg) {
+    if (FIX64_LIKELY(arg <= UINT32_MAX)) {
+        return digits(arg);
+    }
+    unsigned n = 10;
+    while (n < sizeof(pow10_table) / sizeof(pow10_table[0]) && arg >= pow10_table[n]) {
+        n++;
+    }
+    return n;
+}
+
+// The formatting functions take the integral part and the fractional part as a UQ0.64, so that
+// they work for any of the fixed point formats. frac_bits is the number of meaningful bits in
+// fpart, which limits the precision for the power of 2 bases
+
+// Integer digits are generated two at a time from the least significant end, and fractional digits
+// two at a time by multiplying the UQ0.64 fraction by 100 (i.e. the same approach as jeaiii's
+// itoa). Note: generating 8 digits per step (both SWAR and 10^8 chunked variants) was measured and
+// is no faster on x86-64 since the lookup table loads are cheap and the multiply chain is
+// short, so any vectorised version must beat this while producing byte-identical output.
+//
+// The number of decimals is capped at max_prec, which is at most 20. 20 decimals are needed for a
+// UQ0.64 to round trip, but 0.5 / 10^20 is less than 2^-64 so it isn't in frac_10_rounding. Instead
+// the 20 digits are truncated, and then rounded up afterwards if the rest of the fraction is at
+// least a half, which is (fpart * 10^20) mod 2^64 as a UQ0.64
+static char *fmt_frac_10(
+    char *buf, uint64_t ipart, uint64_t fpart, unsigned prec, unsigned max_prec) {
+    const unsigned n_rounding = sizeof(frac_10_rounding) / sizeof(frac_10_rounding[0]);
     prec = FIX64_UNLIKELY(prec > max_prec) ? max_prec : prec;
 
-    uint32_t ipart = repr >> FIX64_FRAC_BITS;
-    uint64_t fpart = (repr & ((UINT64_C(1) << FIX64_FRAC_BITS) - 1)) << (64 - FIX64_FRAC_BITS);
+    // pow10_table[19] * 10 wraps to 10^20 mod 2^64
+    int round_up = FIX64_UNLIKELY(prec == n_rounding)
+        && (fpart * (pow10_table[n_rounding - 1] * 10)) >> 63;
 
     // TODO add compiler-agnostic version? GCC/Clang currently produce pretty suboptimal signed
     // saturation code for any implementation that doesn't use __builtin_*_overflow
-    if (__builtin_add_overflow(fpart, frac_10_rounding[prec], &fpart)) {
-        // This won't overflow since ipart only uses 31 bits since it comes from a signed int32_t
+    if (prec < n_rounding && __builtin_add_overflow(fpart, frac_10_rounding[prec], &fpart)) {
+        // This won't overflow since ipart is at most 2^63 for any of the formats
         ipart++;
     }
 
-    unsigned idigits = digits(ipart);
+    unsigned idigits = digits_64(ipart);
     char *end = buf + idigits;
     while (idigits > 1) {
         const char *d = decimal_100(ipart % 100);
@@ -72,30 +99,36 @@ static char *fmt_frac_10(char *buf, uint64_t repr, unsigned prec) {
         fix64_impl_mul_u64_u128(fpart, 10, &tmp_hi);
         *(end++) = '0' + tmp_hi;
     }
+
+    if (FIX64_UNLIKELY(round_up)) {
+        // Increment the last digit, carrying through any 9s. This never reaches the decimal point,
+        // since the largest fpart 1 - 2^-64 is 0.99999999999999999994...
+        char *digit = end - 1;
+        while (*digit == '9') {
+            *(digit--) = '0';
+        }
+        (*digit)++;
+    }
     return end;
 }
 
-static char *fmt_frac_16(char *buf, uint64_t repr, unsigned prec, int upper) {
-    const unsigned bits_per_digit = 4; // 4 bits per hex digit
+// Formats a number in a power of 2 base, i.e. binary, octal or hexadecimal
+static char *fmt_frac_pow2(
+    char *buf, uint64_t ipart, uint64_t fpart, unsigned frac_bits, unsigned prec,
+    unsigned bits_per_digit, const char *digits) {
     const unsigned digit_mask = (1 << bits_per_digit) - 1;
-    const unsigned max_prec = FIX64_FRAC_BITS / bits_per_digit;
+    const unsigned max_prec = (frac_bits + (bits_per_digit - 1)) / bits_per_digit;
     prec = FIX64_UNLIKELY(prec > max_prec) ? max_prec : prec;
 
-    const char *digits;
-    if (upper) {
-        digits = "0123456789ABCDEF";
-    } else {
-        digits = "0123456789abcdef";
+    // Round at the last digit. This only affects bits below frac_bits if prec == max_prec
+    const unsigned round_shift = prec * bits_per_digit;
+    if (round_shift < 64 &&
+        __builtin_add_overflow(fpart, (UINT64_C(1) << 63) >> round_shift, &fpart)) {
+        ipart++;
     }
 
-    // This won't overflow since ipart only uses 31 bits since it comes from a signed int32_t
-    repr += FIX64_HALF.repr >> (prec * bits_per_digit);
-
-    uint32_t ipart = repr >> FIX64_FRAC_BITS;
-    uint64_t fpart = repr & ((UINT64_C(1) << FIX64_FRAC_BITS) - 1);
-
     // Use (arg | 1) because "0" still needs 1 digit
-    unsigned idigits = (32 / bits_per_digit) - (fix64_impl_clz32(ipart | 1) / bits_per_digit);
+    unsigned idigits = ((64 - fix64_impl_clz64(ipart | 1)) + (bits_per_digit - 1)) / bits_per_digit;
     buf += idigits;
     char *end = buf;
     do {
@@ -110,93 +143,27 @@ static char *fmt_frac_16(char *buf, uint64_t repr, unsigned prec, int upper) {
 
     while (prec) {
         prec--;
+        *(end++) = digits[fpart >> (64 - bits_per_digit)];
         fpart <<= bits_per_digit;
-        *(end++) = digits[fpart >> FIX64_FRAC_BITS];
-        fpart &= ((UINT64_C(1) << FIX64_FRAC_BITS) - 1);
     }
     return end;
 }
 
-static char *fmt_frac_8(char *buf, uint64_t repr, unsigned prec) {
-    const unsigned bits_per_digit = 3; // 3 bits per octal digit
-    const unsigned digit_mask = (1 << bits_per_digit) - 1;
-    const unsigned max_prec = (FIX64_FRAC_BITS + (bits_per_digit - 1)) / bits_per_digit;
-    prec = FIX64_UNLIKELY(prec > max_prec) ? max_prec : prec;
-
-    // This won't overflow since ipart only uses 31 bits since it comes from a signed int32_t
-    repr += FIX64_HALF.repr >> (prec * bits_per_digit);
+// fix64_t and the Q formats are formatted with at most 19 decimals, while fix128_t allows the 20
+// that its 64 fractional bits need to round trip
+#define MAX_DECIMALS        19
+#define MAX_DECIMALS_FIX128 20
 
-    uint32_t ipart = repr >> FIX64_FRAC_BITS;
-    uint64_t fpart = repr & ((UINT64_C(1) << FIX64_FRAC_BITS) - 1);
-
-    // Use (arg | 1) because "0" still needs 1 digit
-    unsigned idigits = ((32 - fix64_impl_clz32(ipart | 1)) + (bits_per_digit - 1)) / bits_per_digit;
-    buf += idigits;
-    char *end = buf;
-    do {
-        *(--buf) = '0' + (ipart & digit_mask);
-        ipart >>= bits_per_digit;
-    } while (ipart);
-
-    if (FIX64_UNLIKELY(!prec)) {
-        return end;
-    }
-    *(end++) = '.';
-
-    while (prec) {
-        prec--;
-        fpart <<= bits_per_digit;
-        *(end++) = '0' + (fpart >> FIX64_FRAC_BITS);
-        fpart &= ((UINT64_C(1) << FIX64_FRAC_BITS) - 1);
-    }
-    return end;
-}
-
-static char *fmt_frac_2(char *buf, uint64_t repr, unsigned prec) {
-    const unsigned max_prec = FIX64_FRAC_BITS;
-    prec = FIX64_UNLIKELY(prec > max_prec) ? max_prec : prec;
-
-    // This won't overflow since ipart only uses 31 bits since it comes from a signed int32_t
-    repr += FIX64_HALF.repr >> prec;
-
-    uint32_t ipart = repr >> FIX64_FRAC_BITS;
-    uint64_t fpart = repr & ((UINT64_C(1) << FIX64_FRAC_BITS) - 1);
-
-    // Use (arg | 1) because "0" still needs 1 digit
-    unsigned idigits = 32 - fix64_impl_clz32(ipart | 1);
-    buf += idigits;
-    char *end = buf;
-    do {
-        *(--buf) = '0' + (ipart & 1);
-        ipart >>= 1;
-    } while (ipart);
-
-    if (FIX64_UNLIKELY(!prec)) {
-        return end;
-    }
-    *(end++) = '.';
-
-    while (prec) {
-        prec--;
-        fpart <<= 1;
-        *(end++) = '0' + (fpart >> FIX64_FRAC_BITS);
-        fpart &= ((UINT64_C(1) << FIX64_FRAC_BITS) - 1);
-    }
-    return end;
-}
-
-size_t fix64_to_str_fmt(char *buf, fix64_t val, size_t size, fix64_fmt_param_t fmt) {
+// Formats a fixed point number given as its sign and the integral and fractional parts of its
+// magnitude. fpart is a UQ0.64, of which only the top frac_bits bits are used. Decimal formatting
+// is limited to max_decimals
+static inline size_t to_str_fmt(
+    char *buf, int negative, uint64_t ipart, uint64_t fpart, unsigned frac_bits,
+    unsigned max_decimals, size_t size, fix64_fmt_param_t fmt) {
 
     char tmp_buf[256]; // number is formatted here, max width = 255 + 1 for the nul
     char *end = tmp_buf; // points to end of buf
 
-    uint64_t repr = val.repr;
-    int negative = 0;
-    if (val.repr < 0) {
-        repr = UINT64_C(0) - val.repr;
-        negative = 1;
-    }
-
     unsigned prec = fmt.decimals;
     int trim_0 = 0;
     if (fmt.decimals < 0) {
@@ -204,16 +171,17 @@ size_t fix64_to_str_fmt(char *buf, fix64_t val, size_t size, fix64_fmt_param_t f
         trim_0 = 1;
     }
 
-    char num_buf[72]; // For binary formatting, 64 bits + '.' + alignment
+    char num_buf[136]; // For binary formatting, 64 + 64 bits + '.' + alignment
     char *num_end; // points to end of num_buf
     if (fmt.base == FIX64_BASE_DECIMAL) {
-        num_end = fmt_frac_10(num_buf, repr, prec);
+        num_end = fmt_frac_10(num_buf, ipart, fpart, prec, max_decimals);
     } else if (fmt.base == FIX64_BASE_HEXADECIMAL) {
-        num_end = fmt_frac_16(num_buf, repr, prec, fmt.uppercase);
+        const char *digits = fmt.uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+        num_end = fmt_frac_pow2(num_buf, ipart, fpart, frac_bits, prec, 4, digits);
     } else if (fmt.base == FIX64_BASE_BINARY) {
-        num_end = fmt_frac_2(num_buf, repr, prec);
+        num_end = fmt_frac_pow2(num_buf, ipart, fpart, frac_bits, prec, 1, "01");
     } else { // if (fmt.base == FIX64_BASE_OCTAL)
-        num_end = fmt_frac_8(num_buf, repr, prec);
+        num_end = fmt_frac_pow2(num_buf, ipart, fpart, frac_bits, prec, 3, "01234567");
     }
 
     // Only trim zeros if we actually have a fractional part
@@ -279,3 +247,305 @@ size_t fix64_to_str_fmt(char *buf, fix64_t val, size_t size, fix64_fmt_param_t f
     }
     return len - 1; // don't include the '\0' in the length
 }
+
+size_t fix64_to_str_fmt(char *buf, fix64_t val, size_t size, fix64_fmt_param_t fmt) {
+    uint64_t mag = val.repr;
+    int negative = 0;
+    if (val.repr < 0) {
+        mag = UINT64_C(0) - val.repr;
+        negative = 1;
+    }
+    uint64_t ipart = mag >> FIX64_FRAC_BITS;
+    uint64_t fpart = mag << (64 - FIX64_FRAC_BITS);
+    return to_str_fmt(buf, negative, ipart, fpart, FIX64_FRAC_BITS, MAX_DECIMALS, size, fmt);
+}
+
+size_t fix64_impl_to_str_fmt_q(
+    char *buf, int negative, uint64_t mag, unsigned frac_bits, size_t size,
+    fix64_fmt_param_t fmt) {
+    uint64_t ipart = mag >> frac_bits;
+    uint64_t fpart = mag << (64 - frac_bits);
+    return to_str_fmt(buf, negative, ipart, fpart, frac_bits, MAX_DECIMALS, size, fmt);
+}
+
+size_t fix128_to_str_fmt(char *buf, fix128_t val, size_t size, fix64_fmt_param_t fmt) {
+    int negative = val.hi < 0;
+    uint64_t ipart = val.hi;
+    uint64_t fpart = val.lo;
+    if (negative) {
+        // Negate as unsigned to avoid UB for FIX128_MIN
+        fpart = fix64_impl_sub_u128(0, 0, ipart, fpart, &ipart);
+    }
+    return to_str_fmt(buf, negative, ipart, fpart, 64, MAX_DECIMALS_FIX128, size, fmt);
+}
+
+// Parses a decimal number into its sign, integral part and fractional part with frac_bits (at most
+// 64) fractional bits. ipart saturates at ipart_max_pos or ipart_max_neg depending on the sign, and
+// rounding which carries out of the fractional part is added to ipart
+static inline size_t parse_decimal(
+    const char *str, size_t size, unsigned frac_bits, uint64_t ipart_max_pos,
+    uint64_t ipart_max_neg, int *negative_out, uint64_t *ipart_out, uint64_t *fpart_out) {
+    const unsigned max_frac_digits = sizeof(pow10_table) / sizeof(pow10_table[0]) - 1;
+
+    const char *ptr = str;
+    const char *end = str + size;
+
+    int negative = 0;
+    if (ptr < end && (*ptr == '-' || *ptr == '+')) {
+        negative = (*ptr == '-');
+        ptr++;
+    }
+
+    // Any larger ipart saturates, so stop accumulating once ipart gets that large. ipart_max can be
+    // close to 2^64, so saturate before multiplying too
+    const uint64_t ipart_max = negative ? ipart_max_neg : ipart_max_pos;
+    const uint64_t ipart_max_10 = ipart_max / 10;
+    uint64_t ipart = 0;
+    unsigned n_digits = 0;
+    for (; ptr < end && (unsigned)(*ptr - '0') < 10; ptr++, n_digits++) {
+        ipart = FIX64_UNLIKELY(ipart > ipart_max_10) ? ipart_max : ipart * 10 + (*ptr - '0');
+        ipart = FIX64_UNLIKELY(ipart > ipart_max) ? ipart_max : ipart;
+    }
+
+    // The first 19 fractional digits are accumulated in fdigits, and the next 19 in xdigits. This is
+    // enough for correct rounding of fix64_t since halfway values (odd multiples of 2^-33) have at
+    // most 33 digits. Any further digits, from rest up to ptr, are needed for more fractional bits,
+    // e.g. for Q63.64 where halfway values have up to 65 digits
+    uint64_t fdigits = 0;
+    uint64_t xdigits = 0;
+    unsigned n_frac = 0;
+    unsigned n_extra = 0;
+    const char *rest = NULL;
+    if (ptr < end && *ptr == '.') {
+        ptr++;
+        for (; ptr < end && (unsigned)(*ptr - '0') < 10; ptr++, n_digits++) {
+            if (n_frac < max_frac_digits) {
+                fdigits = fdigits * 10 + (*ptr - '0');
+                n_frac++;
+            } else if (n_extra < max_frac_digits) {
+                xdigits = xdigits * 10 + (*ptr - '0');
+                n_extra++;
+            } else if (!rest) {
+                rest = ptr;
+            }
+        }
+    }
+
+    if (FIX64_UNLIKELY(!n_digits)) {
+        return 0;
+    }
+
+    // fpart = round(fdigits / 10^n_frac) with frac_bits fractional bits. Since fdigits < 10^n_frac
+    // the quotient fits in 64 bits. Rounding up can carry into the integral part, e.g. for
+    // "0.99999999999". The left shifts are split in two since frac_bits can be 64
+    uint64_t pow10 = pow10_table[n_frac];
+    uint64_t hi = fdigits >> (64 - frac_bits);
+    uint64_t lo = (fdigits << (frac_bits - 1)) << 1;
+    lo = fix64_impl_add_u128(hi, lo, 0, pow10 / 2, &hi);
+    uint64_t fpart = fix64_impl_div_u128_u64(hi, lo, pow10);
+    uint64_t carry = 0;
+
+    // The extra digits increase the result by 1 each time the remainder plus the extra digits'
+    // contribution reaches the divisor:
+    // rem + xdigits / 10^n_extra * 2^frac_bits >= 10^n_frac
+    // which can happen at most once for up to 63 fractional bits, and at most twice for 64 since
+    // 10^-19 is more than 1 but less than 2 units of 2^-64
+    if (FIX64_UNLIKELY(n_extra)) {
+        uint64_t rem = lo - fpart * pow10;
+        uint64_t lhs_hi, rhs_hi;
+        uint64_t lhs_lo = fix64_impl_mul_u64_u128(rem, pow10_table[n_extra], &lhs_hi);
+        lhs_lo = fix64_impl_add_u128(lhs_hi, lhs_lo, xdigits >> (64 - frac_bits),
+            (xdigits << (frac_bits - 1)) << 1, &lhs_hi);
+        uint64_t rhs_lo = fix64_impl_mul_u64_u128(pow10, pow10_table[n_extra], &rhs_hi);
+        uint64_t inc = 0;
+        while ((lhs_hi > rhs_hi) || (lhs_hi == rhs_hi && lhs_lo >= rhs_lo)) {
+            lhs_lo = fix64_impl_sub_u128(lhs_hi, lhs_lo, rhs_hi, rhs_lo, &lhs_hi);
+            inc++;
+        }
+
+        // The digits after the first 38 add (0.rest digits) * 2^frac_bits to lhs, so they round up
+        // if that reaches the gap to rhs. That's only possible if the gap is less than 2^frac_bits,
+        // and then gap / 2^frac_bits has a finite decimal expansion to compare digit by digit
+        if (FIX64_UNLIKELY(rest != NULL)) {
+            uint64_t gap_hi;
+            uint64_t gap = fix64_impl_sub_u128(rhs_hi, rhs_lo, lhs_hi, lhs_lo, &gap_hi);
+            if (!gap_hi && (frac_bits == 64 || gap < (UINT64_C(1) << frac_bits))) {
+                uint64_t gap_frac = gap << (64 - frac_bits);
+                for (const char *digit = rest; digit < ptr; digit++) {
+                    uint64_t gap_digit;
+                    gap_frac = fix64_impl_mul_u64_u128(gap_frac, 10, &gap_digit);
+                    if ((uint64_t)(*digit - '0') != gap_digit) {
+                        inc += ((uint64_t)(*digit - '0') > gap_digit);
+                        break;
+                    }
+                    if (!gap_frac) {
+                        inc++;
+                        break;
+                    }
+                }
+            }
+        }
+        fpart += inc;
+        // Only possible with 64 fractional bits, where the result is at most 2^64
+        carry = (fpart < inc);
+    }
+
+    if (frac_bits < 64) {
+        carry = fpart >> frac_bits;
+        fpart &= (UINT64_C(1) << frac_bits) - 1;
+    }
+    ipart += carry;
+    ipart = FIX64_UNLIKELY(ipart > ipart_max) ? ipart_max : ipart;
+
+    *negative_out = negative;
+    *ipart_out = ipart;
+    *fpart_out = fpart;
+    return ptr - str;
+}
+
+// Parses a decimal number with frac_bits fractional bits, saturating the magnitude at max_pos or
+// max_neg depending on the sign. The magnitude is written to mag and the sign to negative
+static inline size_t from_str(
+    const char *str, size_t size, unsigned frac_bits, uint64_t max_pos, uint64_t max_neg,
+    uint64_t *mag, int *negative) {
+    uint64_t ipart, fpart;
+    size_t len = parse_decimal(str, size, frac_bits, (max_pos >> frac_bits) + 1,
+        (max_neg >> frac_bits) + 1, negative, &ipart, &fpart);
+    if (FIX64_UNLIKELY(!len)) {
+        return 0;
+    }
+
+    uint64_t repr_max = *negative ? max_neg : max_pos;
+    uint64_t repr = repr_max;
+    if (FIX64_LIKELY(ipart <= (repr_max >> frac_bits))) {
+        // ipart << frac_bits <= repr_max, so only the addition can overflow
+        uint64_t ipart_shifted = ipart << frac_bits;
+        repr = FIX64_UNLIKELY(fpart > repr_max - ipart_shifted) ? repr_max : ipart_shifted + fpart;
+    }
+
+    *mag = repr;
+    return len;
+}
+
+size_t fix64_from_str(const char *str, size_t size, fix64_t *value) {
+    uint64_t repr;
+    int negative;
+    // INT64_MIN has a magnitude of 2^63, one more than INT64_MAX
+    size_t len = from_str(
+        str, size, FIX64_FRAC_BITS, INT64_MAX, (uint64_t)INT64_MAX + 1, &repr, &negative);
+    if (FIX64_UNLIKELY(!len)) {
+        return 0;
+    }
+
+    // Negate as unsigned to avoid UB for INT64_MIN
+    repr = negative ? UINT64_C(0) - repr : repr;
+    value->repr = (repr > INT64_MAX) ? (int64_t)(repr - INT64_MIN) + INT64_MIN : (int64_t)repr;
+
+    return len;
+}
+
+size_t fix64_impl_from_str_q(
+    const char *str, size_t size, unsigned frac_bits, uint64_t max_pos, uint64_t max_neg,
+    uint64_t *mag, int *negative) {
+    return from_str(str, size, frac_bits, max_pos, max_neg, mag, negative);
+}
+
+size_t fix128_from_str(const char *str, size_t size, fix128_t *value) {
+    // The magnitude of FIX128_MIN is exactly 2^63, so any larger ipart saturates
+    const uint64_t ipart_limit = UINT64_C(1) << 63;
+    int negative;
+    uint64_t ipart, fpart;
+    size_t len =
+        parse_decimal(str, size, 64, ipart_limit, ipart_limit + 1, &negative, &ipart, &fpart);
+    if (FIX64_UNLIKELY(!len)) {
+        return 0;
+    }
+
+    if (negative) {
+        if (FIX64_UNLIKELY(ipart > ipart_limit || (ipart == ipart_limit && fpart))) {
+            *value = FIX128_MIN;
+        } else {
+            // Negate as unsigned, the result is at least -2^63 so the conversion is well defined
+            fpart = fix64_impl_sub_u128(0, 0, ipart, fpart, &ipart);
+            value->hi = (ipart > INT64_MAX) ? (int64_t)(ipart - INT64_MIN) + INT64_MIN
+                                            : (int64_t)ipart;
+            value->lo = fpart;
+        }
+    } else if (FIX64_UNLIKELY(ipart >= ipart_limit)) {
+        *value = FIX128_MAX;
+    } else {
+        value->hi = (int64_t)ipart;
+        value->lo = fpart;
+    }
+
+    return len;
+}
+
+size_t fix64_str_next_line(const char *buf, size_t size, size_t offset) {
+    if (offset >= size) {
+        return size;
+    }
+    // memchr is vectorised by most C libraries, which makes this faster than a simple loop
+    const char *newline = memchr(buf + offset, '\n', size - offset);
+    return newline ? (size_t)(newline - buf) + 1 : size;
+}
+
+// Parses a single row, where buf points to the start of the line and size excludes the terminator
+static unsigned char parse_column_row(
+    fix64_t *value, const char *buf, size_t size, char delim, size_t column) {
+    *value = FIX64_ZERO;
+
+    const char *end = buf + size;
+    for (; column; column--) {
+        const char *next = memchr(buf, delim, end - buf);
+        if (!next) {
+            return FIX64_PARSE_EMPTY;
+        }
+        buf = next + 1;
+    }
+
+    const char *field_end = memchr(buf, delim, end - buf);
+    size_t field_size = (field_end ? field_end : end) - buf;
+    if (!field_size) {
+        return FIX64_PARSE_EMPTY;
+    }
+
+    fix64_t result;
+    if (fix64_from_str(buf, field_size, &result) != field_size) {
+        return FIX64_PARSE_INVALID;
+    }
+    *value = result;
+    return FIX64_PARSE_OK;
+}
+
+size_t fix64_from_str_column(
+    fix64_t *values, unsigned char *status, size_t count, const char *buf, size_t size, char delim,
+    size_t column, size_t *consumed) {
+    size_t offset = 0;
+    size_t rows = 0;
+    while (rows < count && offset < size) {
+        size_t next = fix64_str_next_line(buf, size, offset);
+
+        // Strip the line terminator
+        size_t line_end = next;
+        if (line_end > offset && buf[line_end - 1] == '\n') {
+            line_end--;
+        }
+        if (line_end > offset && buf[line_end - 1] == '\r') {
+            line_end--;
+        }
+
+        unsigned char row_status =
+            parse_column_row(&values[rows], buf + offset, line_end - offset, delim, column);
+        if (status) {
+            status[rows] = row_status;
+        }
+        rows++;
+        offset = next;
+    }
+
+    if (consumed) {
+        *consumed = offset;
+    }
+    return rows;
+}
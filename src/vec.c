@@ -0,0 +1,218 @@
+#include "fix64.h"
+#include "fix64/impl.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Linear minimax approximation of 1 / sqrt(x) for x in [1/4, 1) with a relative error below 0.086,
+// i.e. RSQRT_A - RSQRT_B * x, both as UQ2.62
+#define RSQRT_A UINT64_C(0x887f5868ae3f8800)
+#define RSQRT_B UINT64_C(0x4dffa03bd148e000)
+
+// The error after each Newton iteration is about 1.5 * error^2, so 4 iterations of the initial
+// approximation leave an error below 2^-47, which is far smaller than 1 epsilon of the results
+#define RSQRT_ITERATIONS 4
+
+// Reciprocal square root of x as a UQ0.64 in [1/4, 1), as a UQ2.62 which is slightly too small
+static uint64_t rsqrt(uint64_t x) {
+    uint64_t hi, lo;
+    fix64_impl_mul_u64_u128(RSQRT_B, x, &hi);
+    uint64_t y = RSQRT_A - hi;
+
+    for (int i = 0; i < RSQRT_ITERATIONS; i++) {
+        // y = y * (3 - x * y^2) / 2, which never overshoots the true value
+        uint64_t xy, xyy;
+        fix64_impl_mul_u64_u128(x, y, &xy);
+        lo = fix64_impl_mul_u64_u128(xy, y, &hi);
+        xyy = (hi << 2) | (lo >> 62);
+        lo = fix64_impl_mul_u64_u128(y, (UINT64_C(3) << 62) - xyy, &hi);
+        y = (hi << 1) | (lo >> 63);
+    }
+    return y;
+}
+
+// Calculates the length of a vector with n components, like fix64c_abs
+static fix64_t length(const fix64_t *arg, unsigned n) {
+    uint64_t norm_hi = 0, norm_lo = 0;
+    for (unsigned i = 0; i < n; i++) {
+        // Negate as unsigned to avoid UB for INT64_MIN
+        uint64_t mag = (arg[i].repr < 0) ? UINT64_C(0) - arg[i].repr : (uint64_t)arg[i].repr;
+        uint64_t sq_hi, prev_hi = norm_hi;
+        uint64_t sq_lo = fix64_impl_mul_u64_u128(mag, mag, &sq_hi);
+        norm_lo = fix64_impl_add_u128(norm_hi, norm_lo, sq_hi, sq_lo, &norm_hi);
+        // Only possible if there are 4 components which are all FIX64_MIN
+        if (FIX64_UNLIKELY(norm_hi < prev_hi)) {
+            return FIX64_MAX;
+        }
+    }
+    uint64_t root = fix64_impl_sqrt_u128(norm_hi, norm_lo);
+    if (FIX64_UNLIKELY(root > INT64_MAX)) {
+        return FIX64_MAX;
+    }
+
+    // Round up if norm > (root + 0.5)^2, see fix64c_abs
+    uint64_t sq_hi, rem_hi;
+    uint64_t sq_lo = fix64_impl_mul_u64_u128(root, root, &sq_hi);
+    uint64_t rem_lo = fix64_impl_sub_u128(norm_hi, norm_lo, sq_hi, sq_lo, &rem_hi);
+    root += (rem_hi || rem_lo > root);
+
+    if (FIX64_UNLIKELY(root > INT64_MAX)) {
+        return FIX64_MAX;
+    }
+    return (fix64_t){ (int64_t)root };
+}
+
+// Normalises a vector with n components, writing the result to result
+static void normalize(const fix64_t *arg, fix64_t *result, unsigned n) {
+    int64_t comp[4];
+    int has_min = 0;
+    for (unsigned i = 0; i < n; i++) {
+        comp[i] = arg[i].repr;
+        has_min |= (comp[i] == INT64_MIN);
+    }
+    // Halve the components if any is FIX64_MIN so that the squared length can't overflow. This
+    // doesn't change the direction significantly
+    if (FIX64_UNLIKELY(has_min)) {
+        for (unsigned i = 0; i < n; i++) {
+            comp[i] >>= 1;
+        }
+    }
+
+    int64_t sq_hi;
+    uint64_t norm_hi = 0, norm_lo = 0;
+    for (unsigned i = 0; i < n; i++) {
+        uint64_t sq_lo = fix64_impl_mul_i64_i128(comp[i], comp[i], &sq_hi);
+        norm_lo = fix64_impl_add_u128(norm_hi, norm_lo, (uint64_t)sq_hi, sq_lo, &norm_hi);
+    }
+    if (FIX64_UNLIKELY(norm_hi == 0 && norm_lo == 0)) {
+        for (unsigned i = 0; i < n; i++) {
+            result[i] = arg[i];
+        }
+        return;
+    }
+
+    // Scale the norm by an even power of 2 into [2^126, 2^128) so that its top 64 bits are a UQ0.64
+    // in [1/4, 1), then 1 / sqrt(norm) = rsqrt(x) * 2^(shift / 2 - 64)
+    unsigned shift = (norm_hi ? fix64_impl_clz64(norm_hi) : 64 + fix64_impl_clz64(norm_lo)) & ~1u;
+    uint64_t x;
+    if (shift >= 64) {
+        x = norm_lo << (shift - 64);
+    } else if (shift) {
+        x = (norm_hi << shift) | (norm_lo >> (64 - shift));
+    } else {
+        x = norm_hi;
+    }
+    uint64_t y = rsqrt(x);
+
+    // Each component is comp * 2^32 / sqrt(norm) = comp * y * 2^(shift / 2 - 94), since y is a
+    // UQ2.62. The shift is between 31 and 94
+    unsigned res_shift = 94 - shift / 2;
+    int64_t round_hi = (res_shift > 64) ? INT64_C(1) << (res_shift - 65) : 0;
+    uint64_t round_lo = (res_shift > 64) ? 0 : UINT64_C(1) << (res_shift - 1);
+    for (unsigned i = 0; i < n; i++) {
+        int64_t hi;
+        uint64_t lo = fix64_impl_mul_i64_u64_i128(comp[i], y, &hi);
+        lo = fix64_impl_add_i128(hi, lo, round_hi, round_lo, &hi); // For rounding
+        int64_t value = (res_shift >= 64) ? hi >> (res_shift - 64) :
+                                            (int64_t)(((uint64_t)hi << (64 - res_shift)) |
+                                                (lo >> res_shift));
+        result[i] = (fix64_t){ value };
+    }
+}
+
+fix64_t fix64_vec2_length(fix64_vec2_t arg) {
+    fix64_t comp[2] = { arg.x, arg.y };
+    return length(comp, 2);
+}
+
+fix64_t fix64_vec3_length(fix64_vec3_t arg) {
+    fix64_t comp[3] = { arg.x, arg.y, arg.z };
+    return length(comp, 3);
+}
+
+fix64_t fix64_vec4_length(fix64_vec4_t arg) {
+    fix64_t comp[4] = { arg.x, arg.y, arg.z, arg.w };
+    return length(comp, 4);
+}
+
+fix64_vec2_t fix64_vec2_normalize(fix64_vec2_t arg) {
+    fix64_t comp[2] = { arg.x, arg.y };
+    normalize(comp, comp, 2);
+    return fix64_vec2_make(comp[0], comp[1]);
+}
+
+fix64_vec3_t fix64_vec3_normalize(fix64_vec3_t arg) {
+    fix64_t comp[3] = { arg.x, arg.y, arg.z };
+    normalize(comp, comp, 3);
+    return fix64_vec3_make(comp[0], comp[1], comp[2]);
+}
+
+fix64_vec4_t fix64_vec4_normalize(fix64_vec4_t arg) {
+    fix64_t comp[4] = { arg.x, arg.y, arg.z, arg.w };
+    normalize(comp, comp, 4);
+    return fix64_vec4_make(comp[0], comp[1], comp[2], comp[3]);
+}
+
+fix64_quat_t fix64_quat_normalize(fix64_quat_t arg) {
+    fix64_t comp[4] = { arg.w, arg.x, arg.y, arg.z };
+    normalize(comp, comp, 4);
+    return fix64_quat_make(comp[0], comp[1], comp[2], comp[3]);
+}
+
+// Calculates init + 2 * (a * b + c * d), or init - 2 * (a * b + c * d) if negate is set, with a
+// single rounding. Each element of a rotation matrix has this form
+static fix64_t rotation_elem(fix64_t init, int negate, fix64_t a, fix64_t b, fix64_t c, fix64_t d) {
+    fix64_vec_impl_acc_t acc = fix64_vec_impl_acc(init);
+    for (int i = 0; i < 2; i++) {
+        if (negate) {
+            fix64_vec_impl_msub(&acc, a, b);
+            fix64_vec_impl_msub(&acc, c, d);
+        } else {
+            fix64_vec_impl_mac(&acc, a, b);
+            fix64_vec_impl_mac(&acc, c, d);
+        }
+    }
+    return fix64_vec_impl_round(acc);
+}
+
+fix64_mat3_t fix64_quat_to_mat3(fix64_quat_t arg) {
+    const fix64_t w = arg.w, x = arg.x, y = arg.y, z = arg.z;
+    // Negating the second term of the off-diagonal elements would saturate at FIX64_MIN, but that
+    // isn't a concern since the quaternion should have unit length
+    fix64_mat3_t result;
+    result.m[0][0] = rotation_elem(FIX64_ONE, 1, y, y, z, z);
+    result.m[0][1] = rotation_elem(FIX64_ZERO, 0, x, y, fix64_neg(w), z);
+    result.m[0][2] = rotation_elem(FIX64_ZERO, 0, x, z, w, y);
+    result.m[1][0] = rotation_elem(FIX64_ZERO, 0, x, y, w, z);
+    result.m[1][1] = rotation_elem(FIX64_ONE, 1, x, x, z, z);
+    result.m[1][2] = rotation_elem(FIX64_ZERO, 0, y, z, fix64_neg(w), x);
+    result.m[2][0] = rotation_elem(FIX64_ZERO, 0, x, z, fix64_neg(w), y);
+    result.m[2][1] = rotation_elem(FIX64_ZERO, 0, y, z, w, x);
+    result.m[2][2] = rotation_elem(FIX64_ONE, 1, x, x, y, y);
+    return result;
+}
+
+// There's no SIMD here: each product needs a 64x64->128-bit multiply, which no common vector
+// instruction set has. Copying the matrix means that it isn't reloaded after each store to the
+// arrays, which it could otherwise alias
+void fix64_mat3_transform_soa(
+    const fix64_mat3_t *mat, fix64_t *xs, fix64_t *ys, fix64_t *zs, size_t count) {
+    const fix64_mat3_t m = *mat;
+    for (size_t i = 0; i < count; i++) {
+        fix64_vec3_t v = fix64_mat3_mul_vec3(&m, fix64_vec3_make(xs[i], ys[i], zs[i]));
+        xs[i] = v.x;
+        ys[i] = v.y;
+        zs[i] = v.z;
+    }
+}
+
+void fix64_mat4_transform_soa(
+    const fix64_mat4_t *mat, fix64_t *xs, fix64_t *ys, fix64_t *zs, size_t count) {
+    const fix64_mat4_t m = *mat;
+    for (size_t i = 0; i < count; i++) {
+        fix64_vec3_t v = fix64_mat4_mul_point3(&m, fix64_vec3_make(xs[i], ys[i], zs[i]));
+        xs[i] = v.x;
+        ys[i] = v.y;
+        zs[i] = v.z;
+    }
+}
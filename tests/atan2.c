@@ -0,0 +1,60 @@
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N 1000000
+
+static const long double PI_L = 3.141592653589793238462643383279502884L;
+
+// Exact conversion to long double, since a double doesn't have enough precision
+static long double to_ldbl(fix64_t arg) {
+    return ldexpl((long double)arg.repr, -FIX64_FRAC_BITS);
+}
+
+static int check(const char *name, fix64_t y, fix64_t x, fix64_t result, long double expected) {
+    if (!approx_eq(result, fix64_from_ldbl(expected))) {
+        printf("%s(%.12Lf, %.12Lf) -> %.12Lf; expected %.12Lf\n", name, to_ldbl(y), to_ldbl(x),
+            to_ldbl(result), expected);
+        return 1;
+    }
+    return 0;
+}
+
+int main() {
+    fix64_t edges[] = { FIX64_ZERO, FIX64_EPSILON, fix64_neg(FIX64_EPSILON), FIX64_ONE,
+        fix64_neg(FIX64_ONE), FIX64_MAX, FIX64_MIN };
+    size_t n_edges = sizeof(edges) / sizeof(edges[0]);
+
+    for (int i = 0; i < N; i++) {
+        fix64_t y = rng_fix64(64);
+        fix64_t x = rng_fix64(64);
+        if ((size_t)i < n_edges * n_edges) {
+            y = edges[i / n_edges];
+            x = edges[i % n_edges];
+        } else if (i % 4 == 0) {
+            // Close to the diagonals, where the reduction switches
+            x = (i & 8) ? fix64_neg(y) : y;
+            x.repr += (int64_t)(rng() % 5) - 2;
+        }
+
+        // atan2l(+0, -x) is pi like fix64_atan2
+        long double expected = atan2l(to_ldbl(y), to_ldbl(x));
+        if (check("atan2", y, x, fix64_atan2(y, x), expected) ||
+            check("atan2_turns", y, x, fix64_atan2_turns(y, x), expected / (2 * PI_L)) ||
+            check("atan2_deg", y, x, fix64_atan2_deg(y, x), expected * 180 / PI_L)) {
+            return 1;
+        }
+    }
+
+    for (int i = 0; i < N; i++) {
+        fix64_t arg = rng_fix64(64);
+        if (check("atan", arg, FIX64_ONE, fix64_atan(arg), atanl(to_ldbl(arg)))) {
+            return 1;
+        }
+    }
+    return 0;
+}
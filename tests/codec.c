@@ -0,0 +1,136 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N 100000
+
+static int round_trip(const fix64_t *values, size_t count, size_t *encoded_size) {
+    static uint8_t buf[N * 9];
+    static fix64_t decoded[N];
+
+    size_t size = fix64_encode(buf, sizeof(buf), values, count);
+    if (size > fix64_encode_bound(count) || (count && !size)) {
+        printf("fix64_encode(..., %zu) -> %zu; expected <= %zu\n",
+            count, size, fix64_encode_bound(count));
+        return 0;
+    }
+
+    size_t consumed;
+    size_t n = fix64_decode(decoded, N, buf, size, &consumed);
+    if (n != count || consumed != size) {
+        printf("fix64_decode(...) -> %zu, %zu consumed; expected %zu, %zu\n", n, consumed, count, size);
+        return 0;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!fix64_eq(decoded[i], values[i])) {
+            printf("decoded[%zu] -> 0x%016" PRIx64 "; expected 0x%016" PRIx64 "\n",
+                i, (uint64_t)decoded[i].repr, (uint64_t)values[i].repr);
+            return 0;
+        }
+    }
+
+    // Check the block headers
+    size_t offset = 0;
+    size_t index = 0;
+    fix64_block_info_t info;
+    while (fix64_decode_block_info(&info, buf + offset, size - offset)) {
+        fix64_t min = values[index];
+        fix64_t max = values[index];
+        for (size_t i = index; i < index + info.count; i++) {
+            min = fix64_min(min, values[i]);
+            max = fix64_max(max, values[i]);
+        }
+        if (!fix64_eq(info.min, min) || !fix64_eq(info.max, max)) {
+            printf("block at %zu: min %f, max %f; expected %f, %f\n", index,
+                fix64_to_dbl(info.min), fix64_to_dbl(info.max), fix64_to_dbl(min), fix64_to_dbl(max));
+            return 0;
+        }
+        index += info.count;
+        offset += info.size;
+    }
+    if (index != count) {
+        printf("block headers contain %zu values; expected %zu\n", index, count);
+        return 0;
+    }
+
+    if (encoded_size) {
+        *encoded_size = size;
+    }
+    return 1;
+}
+
+int main() {
+    static fix64_t values[N];
+
+    // Sensor-like data: slowly drifting signal with a little noise, sampled at 16 bits resolution
+    fix64_t signal = FIX64_C(20.0);
+    fix64_t drift = FIX64_ZERO;
+    for (size_t i = 0; i < N; i++) {
+        drift = fix64_add(drift, (fix64_t){ (int64_t)(rng() % 33) - 16 });
+        drift = fix64_mul(drift, FIX64_C(0.99));
+        signal = fix64_add(signal, drift);
+        fix64_t noise = { ((int64_t)(rng() % 9) - 4) << 16 };
+        values[i].repr = (fix64_add(signal, noise).repr >> 16) << 16;
+    }
+    size_t size;
+    if (!round_trip(values, N, &size)) {
+        return 1;
+    }
+    double ratio = (double)(N * sizeof(fix64_t)) / size;
+    if (ratio < 3.0) {
+        printf("compression ratio for sensor data -> %.2f; expected >= 3\n", ratio);
+        return 1;
+    }
+
+    // Random data doesn't compress, but still has to round trip
+    for (size_t i = 0; i < N; i++) {
+        values[i].repr = (int64_t)rng();
+    }
+    values[1] = FIX64_MIN;
+    values[2] = FIX64_MAX;
+    if (!round_trip(values, N, NULL)) {
+        return 1;
+    }
+
+    // Block boundaries and constant values
+    size_t counts[] = { 0, 1, 2, 127, 128, 129, 255, 256, 257 };
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        for (size_t j = 0; j < counts[i]; j++) {
+            values[j] = (i & 1) ? FIX64_PI : (fix64_t){ (int64_t)(j * j) };
+        }
+        if (!round_trip(values, counts[i], NULL)) {
+            return 1;
+        }
+    }
+
+    // Truncated data decodes whole blocks only
+    uint8_t buf[fix64_encode_bound(300)];
+    for (size_t j = 0; j < 300; j++) {
+        values[j].repr = (int64_t)(rng() >> 40);
+    }
+    size = fix64_encode(buf, sizeof(buf), values, 300);
+    fix64_t decoded[300];
+    size_t n = fix64_decode(decoded, 300, buf, size - 1, NULL);
+    if (n != 256) {
+        printf("fix64_decode(truncated) -> %zu; expected 256\n", n);
+        return 1;
+    }
+    n = fix64_decode(decoded, 200, buf, size, NULL);
+    if (n != 128) {
+        printf("fix64_decode(count = 200) -> %zu; expected 128\n", n);
+        return 1;
+    }
+
+    // Buffer too small for encoding
+    if (fix64_encode(buf, 100, values, 300) != 0) {
+        printf("fix64_encode(size = 100) -> nonzero; expected 0\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -18,6 +18,32 @@ static inline int approx_eq(fix64_t x, fix64_t y) {
         (diff <= abs_tol));
 }
 
+// xorshift64, which is plenty for test inputs. Every test starts from the same seed
+static inline uint64_t rng(void) {
+    static uint64_t state = UINT64_C(0x9e3779b97f4a7c15);
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// Random values with a random magnitude, so that small values are tested as often as large ones.
+// The calls to rng() are separate statements so that the order doesn't depend on the compiler
+static inline uint64_t rng_bits(void) {
+    uint64_t bits = rng();
+    unsigned shift = rng() % 64;
+    return bits >> shift;
+}
+
+// Signed random values with a random magnitude of up to max_bits bits, e.g. rng_fix64(64) for the
+// whole range
+static inline fix64_t rng_fix64(unsigned max_bits) {
+    int64_t bits = (int64_t)rng();
+    unsigned shift = 64 - max_bits + rng() % max_bits;
+    fix64_t result = { bits >> shift };
+    return result;
+}
+
 static inline double range_step(double start, double stop, double n_steps) {
     return (stop - start) / n_steps;
 }
@@ -0,0 +1,95 @@
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <fix64.h>
+#include <fix64/constexpr.hpp>
+
+#include "common.h"
+
+#define N 200000
+
+namespace ce = fix64::ce;
+
+// Compile time tables
+template <size_t Size>
+struct table {
+    fix64_t values[Size];
+};
+
+template <size_t Size>
+constexpr table<Size> make_sin_table() {
+    table<Size> result = {};
+    // sin(2 * pi * i / Size)
+    fix64_t step = ce::div(ce::mul(ce::const_two, ce::const_pi), ce::from_int((int)Size));
+    for (size_t i = 0; i < Size; i++) {
+        result.values[i] = ce::sin(ce::mul(ce::from_int((int)i), step));
+    }
+    return result;
+}
+
+constexpr table<256> sin_table = make_sin_table<256>();
+static_assert(sin_table.values[0].repr == 0, "sin(0) == 0");
+static_assert(sin_table.values[64].repr == ce::const_one.repr, "sin(pi/2) == 1");
+
+constexpr fix64_t exp_one = ce::exp(ce::const_one);
+static_assert(exp_one.repr == ce::const_e.repr, "exp(1) == e");
+static_assert(ce::log2(ce::from_int(1024)).repr == ce::from_int(10).repr, "log2(1024) == 10");
+static_assert(ce::from_dbl(2.5).repr == INT64_C(0x280000000), "from_dbl(2.5) == 2.5");
+
+static int check(const char *name, fix64_t arg, fix64_t result, fix64_t expected) {
+    if (result.repr != expected.repr) {
+        printf("ce::%s(0x%016" PRIx64 ") -> 0x%016" PRIx64 "; expected 0x%016" PRIx64 "\n", name,
+            (uint64_t)arg.repr, (uint64_t)result.repr, (uint64_t)expected.repr);
+        return 0;
+    }
+    return 1;
+}
+
+int main() {
+    for (size_t i = 0; i < sizeof(sin_table.values) / sizeof(sin_table.values[0]); i++) {
+        fix64_t step = fix64_div(fix64_mul(FIX64_TWO, FIX64_PI), fix64_from_int(256));
+        fix64_t angle = fix64_mul(fix64_from_int((int)i), step);
+        if (!check("sin (table)", angle, sin_table.values[i], fix64_sin(angle))) {
+            return 1;
+        }
+    }
+
+    static const fix64_t edges[] = { FIX64_ZERO, FIX64_EPSILON, FIX64_ONE, FIX64_MAX, FIX64_MIN,
+        { -1 }, FIX64_PI, FIX64_PI_2, FIX64_PI_4, { INT64_C(0x1fffffffff) },
+        { INT64_C(-0x1fffffffff) }, { INT64_C(0x1f00000000) } };
+    size_t n_edges = sizeof(edges) / sizeof(edges[0]);
+
+    for (size_t i = 0; i < N + n_edges; i++) {
+        fix64_t x = (i < n_edges) ? edges[i] : rng_fix64(64);
+        fix64_t y = rng_fix64(64);
+
+        int ok = check("neg", x, ce::neg(x), fix64_neg(x)) &&
+            check("add", x, ce::add(x, y), fix64_add(x, y)) &&
+            check("add_sat", x, ce::add_sat(x, y), fix64_add_sat(x, y)) &&
+            check("sub", x, ce::sub(x, y), fix64_sub(x, y)) &&
+            check("sub_sat", x, ce::sub_sat(x, y), fix64_sub_sat(x, y)) &&
+            check("mul", x, ce::mul(x, y), fix64_mul(x, y)) &&
+            check("mul_sat", x, ce::mul_sat(x, y), fix64_mul_sat(x, y)) &&
+            check("exp", x, ce::exp(x), fix64_exp(x)) &&
+            check("exp2", x, ce::exp2(x), fix64_exp2(x)) &&
+            check("log", x, ce::log(x), fix64_log(x)) &&
+            check("log2", x, ce::log2(x), fix64_log2(x)) &&
+            check("log10", x, ce::log10(x), fix64_log10(x)) &&
+            check("sqrt", x, ce::sqrt(x), fix64_sqrt(x)) &&
+            check("sin", x, ce::sin(x), fix64_sin(x)) &&
+            check("cos", x, ce::cos(x), fix64_cos(x)) &&
+            check("tan", x, ce::tan(x), fix64_tan(x)) &&
+            check("from_int", x, ce::from_int(fix64_to_int(x)), fix64_from_int(fix64_to_int(x))) &&
+            check("from_dbl", x, ce::from_dbl(fix64_to_dbl(x) * 1.5),
+                fix64_from_dbl(fix64_to_dbl(x) * 1.5));
+        if (y.repr != 0) {
+            ok = ok && check("div", x, ce::div(x, y), fix64_div(x, y)) &&
+                check("div_sat", x, ce::div_sat(x, y), fix64_div_sat(x, y));
+        }
+        if (!ok) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N 64
+
+static const int64_t reprs[] = {
+    0,
+    1,
+    -1,
+    INT64_C(0x0000000100000000),
+    INT64_C(-0x0000000100000000),
+    INT64_C(0x0000007f80000000),
+    INT64_C(0x0000008000000000),
+    INT64_C(-0x0000008000000000),
+    INT64_C(-0x0000008100000000),
+    INT64_C(0x000000ffffffffff),
+    INT64_C(0x0000010000000000),
+    INT64_C(0x00007fff00000000),
+    INT64_C(0x0000800000000000),
+    INT64_C(0x0000ffffffffffff),
+    INT64_C(0x0001000000000000),
+    INT64_C(0x123456789abcdef0),
+    INT64_C(-0x123456789abcdef0),
+    INT64_MAX,
+    INT64_MIN,
+};
+
+#define CHECK_TO(type, short, fmt)                                                        \
+    do {                                                                                 \
+        type out[N];                                                                     \
+        fix64_to_##short##_n(out, in, n);                                                \
+        for (size_t i = 0; i < n; i++) {                                                 \
+            type expected = fix64_to_##short(in[i]);                                     \
+            if (out[i] != expected) {                                                    \
+                printf("fix64_to_" #short "_n()[%zu] -> %" fmt "; expected %" fmt "\n", i, \
+                    out[i], expected);                                                   \
+                return 1;                                                                \
+            }                                                                            \
+        }                                                                                \
+    } while (0)
+
+#define CHECK_FROM(type, short, vals)                                                    \
+    do {                                                                                 \
+        fix64_t out[N];                                                                  \
+        size_t count = sizeof(vals) / sizeof(vals[0]);                                   \
+        fix64_from_##short##_n(out, vals, count);                                        \
+        for (size_t i = 0; i < count; i++) {                                             \
+            fix64_t expected = fix64_from_##short(vals[i]);                              \
+            if (!fix64_eq(out[i], expected)) {                                           \
+                printf("fix64_from_" #short "_n()[%zu] -> 0x%016" PRIx64                 \
+                       "; expected 0x%016" PRIx64 "\n",                                  \
+                    i, (uint64_t)out[i].repr, (uint64_t)expected.repr);                  \
+                return 1;                                                                \
+            }                                                                            \
+        }                                                                                \
+    } while (0)
+
+static int expect_int(const char *name, int64_t value, int64_t expected) {
+    if (value != expected) {
+        printf("%s -> %" PRId64 "; expected %" PRId64 "\n", name, value, expected);
+        return 1;
+    }
+    return 0;
+}
+
+static int expect_repr(const char *name, fix64_t value, int64_t expected) {
+    if (value.repr != expected) {
+        printf("%s -> 0x%016" PRIx64 "; expected 0x%016" PRIx64 "\n", name, (uint64_t)value.repr,
+            (uint64_t)expected);
+        return 1;
+    }
+    return 0;
+}
+
+int main() {
+    fix64_t in[N];
+    size_t n = sizeof(reprs) / sizeof(reprs[0]);
+    for (size_t i = 0; i < n; i++) {
+        in[i].repr = reprs[i];
+    }
+
+    CHECK_TO(int8_t, i8, PRId8);
+    CHECK_TO(int16_t, i16, PRId16);
+    CHECK_TO(int32_t, i32, PRId32);
+    CHECK_TO(int64_t, i64, PRId64);
+    CHECK_TO(uint8_t, u8, PRIu8);
+    CHECK_TO(uint16_t, u16, PRIu16);
+    CHECK_TO(uint32_t, u32, PRIu32);
+    CHECK_TO(uint64_t, u64, PRIu64);
+
+    static const int8_t i8s[] = { 0, 1, -1, INT8_MAX, INT8_MIN };
+    static const int16_t i16s[] = { 0, 1, -1, INT16_MAX, INT16_MIN };
+    static const int32_t i32s[] = { 0, 1, -1, INT32_MAX, INT32_MIN };
+    static const int64_t i64s[] = { 0, 1, -1, INT32_MAX, INT32_MIN, INT32_MAX + INT64_C(1),
+        INT32_MIN - INT64_C(1), INT64_MAX, INT64_MIN };
+    static const uint8_t u8s[] = { 0, 1, UINT8_MAX };
+    static const uint16_t u16s[] = { 0, 1, UINT16_MAX };
+    static const uint32_t u32s[] = { 0, 1, INT32_MAX, INT32_MAX + UINT32_C(1), UINT32_MAX };
+    static const uint64_t u64s[] = { 0, 1, INT32_MAX, INT32_MAX + UINT64_C(1), UINT64_MAX };
+    CHECK_FROM(int8_t, i8, i8s);
+    CHECK_FROM(int16_t, i16, i16s);
+    CHECK_FROM(int32_t, i32, i32s);
+    CHECK_FROM(int64_t, i64, i64s);
+    CHECK_FROM(uint8_t, u8, u8s);
+    CHECK_FROM(uint16_t, u16, u16s);
+    CHECK_FROM(uint32_t, u32, u32s);
+    CHECK_FROM(uint64_t, u64, u64s);
+
+    int fail = 0;
+    fail |= expect_int("fix64_to_i8(200)", fix64_to_i8(FIX64_C(200)), INT8_MAX);
+    fail |= expect_int("fix64_to_i8(-200)", fix64_to_i8(FIX64_C(-200)), INT8_MIN);
+    fail |= expect_int("fix64_to_i16(-40000)", fix64_to_i16(FIX64_C(-40000)), INT16_MIN);
+    fail |= expect_int("fix64_to_i32(FIX64_MAX)", fix64_to_i32(FIX64_MAX), INT32_MAX);
+    fail |= expect_int("fix64_to_i64(-2.5)", fix64_to_i64(FIX64_C(-2.5)), -3);
+    fail |= expect_int("fix64_to_u8(300)", fix64_to_u8(FIX64_C(300)), UINT8_MAX);
+    fail |= expect_int("fix64_to_u16(-1)", fix64_to_u16(FIX64_C(-1)), 0);
+    fail |= expect_int("fix64_to_u32(FIX64_MIN)", fix64_to_u32(FIX64_MIN), 0);
+    fail |= expect_int("fix64_to_u64(FIX64_MAX)", (int64_t)fix64_to_u64(FIX64_MAX), INT32_MAX);
+    fail |= expect_repr(
+        "fix64_from_i8(INT8_MIN)", fix64_from_i8(INT8_MIN), INT64_C(-128) * (INT64_C(1) << 32));
+    fail |= expect_repr("fix64_from_i32(INT32_MIN)", fix64_from_i32(INT32_MIN), INT64_MIN);
+    fail |= expect_repr("fix64_from_i64(2^31)", fix64_from_i64(INT64_C(1) << 31), INT64_MAX);
+    fail |= expect_repr(
+        "fix64_from_i64(-2^31-1)", fix64_from_i64(INT32_MIN - INT64_C(1)), INT64_MIN);
+    fail |= expect_repr("fix64_from_u32(2^31)", fix64_from_u32(UINT32_C(1) << 31), INT64_MAX);
+    fail |= expect_repr("fix64_from_u64(UINT64_MAX)", fix64_from_u64(UINT64_MAX), INT64_MAX);
+    fail |= expect_repr(
+        "fix64_from_u16(UINT16_MAX)", fix64_from_u16(UINT16_MAX), INT64_C(0xffff) << 32);
+    if (fail) {
+        return 1;
+    }
+
+    // Floats, including values that saturate
+    static const float flts[] = {
+        0.0f, -0.0f, 1.5f, -1.5f, 0x1p-33f, 0x1p-32f, 3e9f, -3e9f, 1e-20f
+    };
+    static const double dbls[] = {
+        0.0, 2.5, -2.5, 0x1p-33, 0x1.8p-32, 0x1p31, -0x1p31, 1e300, -1e300, 0x1.fffffffffffffp30
+    };
+    static const long double ldbls[] = { 0.0L, 1.25L, -1.25L, 0x1p-33L, 0x1p31L, -0x1p31L };
+    CHECK_FROM(float, flt, flts);
+    CHECK_FROM(double, dbl, dbls);
+    CHECK_FROM(long double, ldbl, ldbls);
+
+    float fout[N];
+    double dout[N];
+    long double ldout[N];
+    fix64_to_flt_n(fout, in, n);
+    fix64_to_dbl_n(dout, in, n);
+    fix64_to_ldbl_n(ldout, in, n);
+    for (size_t i = 0; i < n; i++) {
+        if (memcmp(&fout[i], &(float){ fix64_to_flt(in[i]) }, sizeof(float)) != 0 ||
+            memcmp(&dout[i], &(double){ fix64_to_dbl(in[i]) }, sizeof(double)) != 0 ||
+            ldout[i] != fix64_to_ldbl(in[i])) {
+            printf("fix64_to_*_n()[%zu] doesn't match scalar conversion\n", i);
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,204 @@
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N          100000
+#define MAX_SIZE   1024
+#define PI         3.14159265358979323846264338327950288L
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 i128_t;
+__extension__ typedef unsigned __int128 u128_t;
+#endif
+
+#ifdef __SIZEOF_INT128__
+static int test_sqrt(void) {
+    for (int i = 0; i < N; i++) {
+        uint64_t hi = rng_bits();
+        uint64_t lo = rng();
+        if (i < 64) {
+            // Perfect squares and their neighbours
+            uint64_t r = rng() >> 32;
+            hi = 0;
+            lo = r * r - (i & 1);
+        }
+        u128_t n = ((u128_t)hi << 64) | lo;
+        u128_t root = fix64_impl_sqrt_u128(hi, lo);
+        if (root * root > n || (root + 1) * (root + 1) <= n) {
+            printf("fix64_impl_sqrt_u128(0x%016" PRIx64 "%016" PRIx64 ") -> 0x%016" PRIx64 "\n",
+                hi, lo, (uint64_t)root);
+            return 1;
+        }
+    }
+    if (fix64_impl_sqrt_u128(UINT64_MAX, UINT64_MAX) != UINT64_MAX) {
+        printf("fix64_impl_sqrt_u128(2^128 - 1) failed\n");
+        return 1;
+    }
+    return 0;
+}
+
+static fix64_t ref_round(i128_t x) {
+    // Floor division, with halfway values rounded up
+    x += (i128_t)1 << (FIX64_FRAC_BITS - 1);
+    return (fix64_t){ (int64_t)(x >> FIX64_FRAC_BITS) };
+}
+
+static int test_complex(void) {
+    for (int i = 0; i < N; i++) {
+        fix64_t parts[4];
+        for (int j = 0; j < 4; j++) {
+            parts[j] = rng_fix64(64);
+        }
+        fix64c_t x = fix64c_make(parts[0], parts[1]);
+        fix64c_t y = fix64c_make(parts[2], parts[3]);
+        i128_t rr = (i128_t)x.re.repr * y.re.repr;
+        i128_t ii = (i128_t)x.im.repr * y.im.repr;
+        i128_t ri = (i128_t)x.re.repr * y.im.repr;
+        i128_t ir = (i128_t)x.im.repr * y.re.repr;
+
+        fix64c_t prod = fix64c_mul(x, y);
+        fix64c_t prod_conj = fix64c_mul_conj(x, y);
+        int fail = 0;
+        fail |= (prod.re.repr != ref_round(rr - ii).repr) ||
+            (prod.im.repr != ref_round(ri + ir).repr);
+        fail |= (prod_conj.re.repr != ref_round(rr + ii).repr) ||
+            (prod_conj.im.repr != ref_round(ir - ri).repr);
+
+        // Check the magnitude is correctly rounded, i.e. (r - 0.5)^2 < norm <= (r + 0.5)^2 which is
+        // r^2 - r < norm <= r^2 + r since norm is an integer
+        u128_t norm =
+            (u128_t)((i128_t)x.re.repr * x.re.repr) + (u128_t)((i128_t)x.im.repr * x.im.repr);
+        fix64_t abs = fix64c_abs(x);
+        if (abs.repr != INT64_MAX) {
+            u128_t r = (u128_t)abs.repr;
+            fail |= !((r == 0 || r * r - r < norm) && norm <= r * r + r);
+        } else {
+            fail |= (norm < ((u128_t)INT64_MAX * INT64_MAX));
+        }
+
+        i128_t norm_round =
+            (i128_t)(norm >> FIX64_FRAC_BITS) + ((norm >> (FIX64_FRAC_BITS - 1)) & 1);
+        fix64_t norm_sat = fix64c_norm(x);
+        fail |= (norm_round > INT64_MAX) ? (norm_sat.repr != INT64_MAX)
+                                         : (norm_sat.repr != (int64_t)norm_round);
+
+        if (fail) {
+            printf("fix64c failed for (%" PRId64 ", %" PRId64 "), (%" PRId64 ", %" PRId64 ")\n",
+                x.re.repr, x.im.repr, y.re.repr, y.im.repr);
+            return 1;
+        }
+    }
+    return 0;
+}
+#endif
+
+// Naive DFT in long double
+static void ref_dft(const fix64c_t *in, long double *out_re, long double *out_im, size_t size,
+    int inverse) {
+    for (size_t k = 0; k < size; k++) {
+        long double re = 0, im = 0;
+        for (size_t n = 0; n < size; n++) {
+            long double angle = (inverse ? 2 : -2) * PI * (long double)((k * n) % size) / size;
+            long double x_re = fix64_to_dbl(in[n].re);
+            long double x_im = fix64_to_dbl(in[n].im);
+            re += x_re * cosl(angle) - x_im * sinl(angle);
+            im += x_re * sinl(angle) + x_im * cosl(angle);
+        }
+        out_re[k] = re;
+        out_im[k] = im;
+    }
+}
+
+// Compares data * 2^exponent to the reference, allowing for an error of a few epsilon per stage
+// relative to the largest output
+static int check_fft(const char *name, const fix64c_t *data, int exponent, const long double *re,
+    const long double *im, size_t size, unsigned log2_size) {
+    long double max = 0;
+    for (size_t i = 0; i < size; i++) {
+        max = fmaxl(max, fmaxl(fabsl(re[i]), fabsl(im[i])));
+    }
+    long double eps = ldexpl(1, -FIX64_FRAC_BITS);
+    long double tol = (log2_size + 1) * (4 * ldexpl(eps, exponent) + 4 * eps * max);
+    for (size_t i = 0; i < size; i++) {
+        long double err_re = ldexpl(fix64_to_dbl(data[i].re), exponent) - re[i];
+        long double err_im = ldexpl(fix64_to_dbl(data[i].im), exponent) - im[i];
+        if (fabsl(err_re) > tol || fabsl(err_im) > tol) {
+            printf("%s size %zu: element %zu = (%Lg, %Lg) * 2^%d; expected (%Lg, %Lg)\n", name,
+                size, i, (long double)fix64_to_dbl(data[i].re),
+                (long double)fix64_to_dbl(data[i].im), exponent, re[i], im[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int test_fft(void) {
+    static fix64c_t twiddles[FIX64_FFT_TWIDDLES(MAX_SIZE)];
+    static fix64c_t input[MAX_SIZE];
+    static fix64c_t data[MAX_SIZE];
+    static long double ref_re[MAX_SIZE];
+    static long double ref_im[MAX_SIZE];
+
+    fix64_fft_plan_t plan;
+    if (fix64_fft_plan_init(&plan, twiddles, 0) != -1 ||
+        fix64_fft_plan_init(&plan, twiddles, 12) != -1) {
+        printf("fix64_fft_plan_init accepted an invalid size\n");
+        return 1;
+    }
+
+    for (unsigned log2_size = 0; (1u << log2_size) <= MAX_SIZE; log2_size++) {
+        size_t size = (size_t)1 << log2_size;
+        if (fix64_fft_plan_init(&plan, twiddles, size) != 0 || plan.log2_size != log2_size) {
+            printf("fix64_fft_plan_init failed for size %zu\n", size);
+            return 1;
+        }
+
+        // Small inputs which aren't scaled, then full range inputs which have to be
+        for (int large = 0; large < 2; large++) {
+            for (size_t i = 0; i < size; i++) {
+                int64_t re = large ? (int64_t)rng() : (int64_t)rng() >> 20;
+                int64_t im = large ? (int64_t)rng() : (int64_t)rng() >> 20;
+                input[i] = fix64c_make((fix64_t){ re }, (fix64_t){ im });
+                data[i] = input[i];
+            }
+            if (large) {
+                input[0] = data[0] = fix64c_make(FIX64_MIN, FIX64_MIN);
+            }
+
+            ref_dft(input, ref_re, ref_im, size, 0);
+            int exponent = fix64_fft(&plan, data);
+            if ((!large && exponent != 0) || exponent < 0 ||
+                check_fft("fix64_fft", data, exponent, ref_re, ref_im, size, log2_size)) {
+                printf("fix64_fft failed for size %zu, exponent %d\n", size, exponent);
+                return 1;
+            }
+
+            // The inverse of the forward transform should give back the input
+            int inv_exponent = fix64_ifft(&plan, data) + exponent - (int)log2_size;
+            for (size_t i = 0; i < size; i++) {
+                ref_re[i] = fix64_to_dbl(input[i].re);
+                ref_im[i] = fix64_to_dbl(input[i].im);
+            }
+            if (check_fft("fix64_ifft", data, inv_exponent, ref_re, ref_im, size, 2 * log2_size)) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int main() {
+#ifdef __SIZEOF_INT128__
+    if (test_sqrt() || test_complex()) {
+        return 1;
+    }
+#endif
+    if (test_fft()) {
+        return 1;
+    }
+    return 0;
+}
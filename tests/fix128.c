@@ -0,0 +1,402 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N 100000
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 i128_t;
+__extension__ typedef unsigned __int128 u128_t;
+#endif
+
+// Random values with a random magnitude, so that small values are tested as often as large ones
+static fix128_t rng_fix128(void) {
+    unsigned shift = rng() % 128;
+    uint64_t hi = rng();
+    uint64_t lo = rng();
+    if (shift >= 64) {
+        lo = hi >> 1 >> (shift - 64);
+        hi = 0;
+    } else if (shift) {
+        lo = (lo >> shift) | (hi << (64 - shift));
+        hi >>= shift;
+    }
+    if (rng() & 1) {
+        lo = fix64_impl_sub_u128(0, 0, hi, lo, &hi);
+    }
+    fix128_t result = { (int64_t)hi, lo };
+    return result;
+}
+
+static int expect_fix128(const char *name, fix128_t x, fix128_t y, fix128_t value,
+    fix128_t expected) {
+    if (!fix128_eq(value, expected)) {
+        printf("%s(0x%016" PRIx64 "%016" PRIx64 ", 0x%016" PRIx64 "%016" PRIx64 ") -> 0x%016" PRIx64
+               "%016" PRIx64 "; expected 0x%016" PRIx64 "%016" PRIx64 "\n",
+            name, (uint64_t)x.hi, x.lo, (uint64_t)y.hi, y.lo, (uint64_t)value.hi, value.lo,
+            (uint64_t)expected.hi, expected.lo);
+        return 1;
+    }
+    return 0;
+}
+
+static int expect_str(const char *name, const char *value, const char *expected) {
+    if (strcmp(value, expected) != 0) {
+        printf("%s -> \"%s\"; expected \"%s\"\n", name, value, expected);
+        return 1;
+    }
+    return 0;
+}
+
+#ifdef __SIZEOF_INT128__
+static i128_t to_i128(fix128_t x) {
+    return (i128_t)(((u128_t)(uint64_t)x.hi << 64) | x.lo);
+}
+
+static fix128_t from_i128(i128_t x) {
+    fix128_t result = { (int64_t)(x >> 64), (uint64_t)x };
+    return result;
+}
+
+// Reference multiplication with the full 256 bit product in four 64 bit limbs (little endian).
+// Returns non-zero if the rounded result doesn't fit in 128 bits
+static int ref_mul(fix128_t x, fix128_t y, fix128_t *result) {
+    int negative = (x.hi < 0) != (y.hi < 0);
+    u128_t a = (x.hi < 0) ? -(u128_t)to_i128(x) : (u128_t)to_i128(x);
+    u128_t b = (y.hi < 0) ? -(u128_t)to_i128(y) : (u128_t)to_i128(y);
+
+    uint64_t a_limbs[2] = { (uint64_t)a, (uint64_t)(a >> 64) };
+    uint64_t b_limbs[2] = { (uint64_t)b, (uint64_t)(b >> 64) };
+    uint64_t p[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 2; i++) {
+        u128_t carry = 0;
+        for (int j = 0; j < 2; j++) {
+            u128_t t = (u128_t)a_limbs[i] * b_limbs[j] + p[i + j] + carry;
+            p[i + j] = (uint64_t)t;
+            carry = t >> 64;
+        }
+        p[i + 2] = (uint64_t)carry;
+    }
+
+    // Negate the product, then round half up and shift right by 64 bits
+    if (negative) {
+        u128_t carry = 1;
+        for (int i = 0; i < 4; i++) {
+            u128_t t = (u128_t)(uint64_t)~p[i] + carry;
+            p[i] = (uint64_t)t;
+            carry = t >> 64;
+        }
+    }
+    u128_t carry = UINT64_C(1) << 63;
+    for (int i = 0; i < 4; i++) {
+        u128_t t = (u128_t)p[i] + carry;
+        p[i] = (uint64_t)t;
+        carry = t >> 64;
+    }
+
+    result->hi = (int64_t)p[2];
+    result->lo = p[1];
+    uint64_t sign = (p[2] >> 63) ? UINT64_MAX : 0;
+    return p[3] != sign;
+}
+
+// Reference division using bitwise long division of the magnitudes. Returns non-zero if the
+// rounded quotient doesn't fit in 128 bits, in which case result is not written
+static int ref_div(fix128_t x, fix128_t y, fix128_t *result) {
+    int negative = (x.hi < 0) != (y.hi < 0);
+    u128_t a = (x.hi < 0) ? -(u128_t)to_i128(x) : (u128_t)to_i128(x);
+    u128_t b = (y.hi < 0) ? -(u128_t)to_i128(y) : (u128_t)to_i128(y);
+
+    // Dividend is a << 64, i.e. 192 bits
+    u128_t q = 0;
+    u128_t r = 0;
+    int overflow = 0;
+    for (int i = 191; i >= 0; i--) {
+        uint64_t bit = (i >= 64) ? (uint64_t)(a >> (i - 64)) & 1 : 0;
+        // r < b <= 2^127, so the shift can't overflow
+        r = (r << 1) | bit;
+        overflow |= (int)(q >> 127);
+        q <<= 1;
+        if (r >= b) {
+            r -= b;
+            q |= 1;
+        }
+    }
+    // Round half away from zero
+    if (r >= b - r) {
+        q++;
+        overflow |= (q == 0);
+    }
+
+    u128_t limit = ((u128_t)1 << 127) - !negative;
+    if (overflow || q > limit) {
+        return 1;
+    }
+    *result = from_i128(negative ? -(i128_t)(q - 1) - 1 : (i128_t)q);
+    return 0;
+}
+
+static int test_arith(void) {
+    for (int i = 0; i < N; i++) {
+        fix128_t x = rng_fix128();
+        fix128_t y = rng_fix128();
+        i128_t xi = to_i128(x);
+        i128_t yi = to_i128(y);
+
+        int fail = 0;
+        u128_t sum = (u128_t)xi + (u128_t)yi;
+        u128_t diff = (u128_t)xi - (u128_t)yi;
+        fail |= expect_fix128("fix128_add", x, y, fix128_add(x, y), from_i128((i128_t)sum));
+        fail |= expect_fix128("fix128_sub", x, y, fix128_sub(x, y), from_i128((i128_t)diff));
+
+        // Saturate if the result's sign is wrong
+        fix128_t sum_sat = from_i128((i128_t)sum);
+        if (((xi < 0) == (yi < 0)) && (((i128_t)sum < 0) != (xi < 0))) {
+            sum_sat = (xi < 0) ? FIX128_MIN : FIX128_MAX;
+        }
+        fix128_t diff_sat = from_i128((i128_t)diff);
+        if (((xi < 0) != (yi < 0)) && (((i128_t)diff < 0) != (xi < 0))) {
+            diff_sat = (xi < 0) ? FIX128_MIN : FIX128_MAX;
+        }
+        fail |= expect_fix128("fix128_add_sat", x, y, fix128_add_sat(x, y), sum_sat);
+        fail |= expect_fix128("fix128_sub_sat", x, y, fix128_sub_sat(x, y), diff_sat);
+
+        fix128_t prod;
+        int overflow = ref_mul(x, y, &prod);
+        fail |= expect_fix128("fix128_mul", x, y, fix128_mul(x, y), prod);
+        if (overflow) {
+            prod = ((x.hi < 0) != (y.hi < 0)) ? FIX128_MIN : FIX128_MAX;
+        }
+        fail |= expect_fix128("fix128_mul_sat", x, y, fix128_mul_sat(x, y), prod);
+
+        if (!fix128_eq(y, FIX128_ZERO)) {
+            fix128_t quot;
+            if (!ref_div(x, y, &quot)) {
+                fail |= expect_fix128("fix128_div", x, y, fix128_div(x, y), quot);
+            } else {
+                quot = ((x.hi < 0) != (y.hi < 0)) ? FIX128_MIN : FIX128_MAX;
+            }
+            fail |= expect_fix128("fix128_div_sat", x, y, fix128_div_sat(x, y), quot);
+        }
+
+        fail |= (fix128_lt(x, y) != (xi < yi)) || (fix128_gt(x, y) != (xi > yi));
+        fail |= (fix128_lte(x, y) != (xi <= yi)) || (fix128_gte(x, y) != (xi >= yi));
+        fail |= (fix128_eq(x, x) != 1) || (fix128_neq(x, y) != (xi != yi));
+        if (fail) {
+            printf("failed for 0x%016" PRIx64 "%016" PRIx64 ", 0x%016" PRIx64 "%016" PRIx64 "\n",
+                (uint64_t)x.hi, x.lo, (uint64_t)y.hi, y.lo);
+            return 1;
+        }
+    }
+    return 0;
+}
+#endif
+
+static int test_edge_cases(void) {
+    int fail = 0;
+    fix128_t two = fix128_from_i64(2);
+    fix128_t three = fix128_from_i64(3);
+    fix128_t m_three = fix128_from_i64(-3);
+
+    fail |= expect_fix128("fix128_neg", FIX128_MIN, FIX128_ZERO, fix128_neg(FIX128_MIN),
+        FIX128_MAX);
+    fail |= expect_fix128("fix128_abs", FIX128_EPSILON, FIX128_ZERO,
+        fix128_abs(fix128_neg(FIX128_EPSILON)), FIX128_EPSILON);
+    fail |= expect_fix128("fix128_mul", FIX128_HALF, FIX128_HALF,
+        fix128_mul(FIX128_HALF, FIX128_HALF), (fix128_t){ 0, UINT64_C(1) << 62 });
+    // 2^-64 * 2^-1 rounds half up
+    fail |= expect_fix128("fix128_mul", FIX128_EPSILON, FIX128_HALF,
+        fix128_mul(FIX128_EPSILON, FIX128_HALF), FIX128_EPSILON);
+    fail |= expect_fix128("fix128_mul", fix128_neg(FIX128_EPSILON), FIX128_HALF,
+        fix128_mul(fix128_neg(FIX128_EPSILON), FIX128_HALF), FIX128_ZERO);
+    fail |= expect_fix128("fix128_mul_sat", FIX128_MAX, two, fix128_mul_sat(FIX128_MAX, two),
+        FIX128_MAX);
+    fail |= expect_fix128("fix128_mul_sat", FIX128_MIN, two, fix128_mul_sat(FIX128_MIN, two),
+        FIX128_MIN);
+    fail |= expect_fix128("fix128_mul_sat", FIX128_MIN, FIX128_ONE,
+        fix128_mul_sat(FIX128_MIN, FIX128_ONE), FIX128_MIN);
+
+    // 1/3 = 0x0.5555..., and 2/3 = 0x0.aaaa... rounds up
+    fail |= expect_fix128("fix128_div", FIX128_ONE, three, fix128_div(FIX128_ONE, three),
+        (fix128_t){ 0, UINT64_C(0x5555555555555555) });
+    fail |= expect_fix128("fix128_div", two, three, fix128_div(two, three),
+        (fix128_t){ 0, UINT64_C(0xaaaaaaaaaaaaaaab) });
+    fail |= expect_fix128("fix128_div", two, m_three, fix128_div(two, m_three),
+        fix128_neg((fix128_t){ 0, UINT64_C(0xaaaaaaaaaaaaaaab) }));
+    fail |= expect_fix128("fix128_div_sat", FIX128_MAX, FIX128_HALF,
+        fix128_div_sat(FIX128_MAX, FIX128_HALF), FIX128_MAX);
+    fail |= expect_fix128("fix128_div_sat", FIX128_MIN, FIX128_ONE,
+        fix128_div_sat(FIX128_MIN, FIX128_ONE), FIX128_MIN);
+    fail |= expect_fix128("fix128_div_sat", FIX128_MIN, fix128_neg(FIX128_ONE),
+        fix128_div_sat(FIX128_MIN, fix128_neg(FIX128_ONE)), FIX128_MAX);
+    fail |= expect_fix128("fix128_div_sat", m_three, FIX128_ZERO,
+        fix128_div_sat(m_three, FIX128_ZERO), FIX128_MIN);
+    fail |= expect_fix128("fix128_div_sat", FIX128_ZERO, FIX128_ZERO,
+        fix128_div_sat(FIX128_ZERO, FIX128_ZERO), FIX128_MAX);
+
+    fail |= expect_fix128("fix128_add_sat", FIX128_MAX, FIX128_EPSILON,
+        fix128_add_sat(FIX128_MAX, FIX128_EPSILON), FIX128_MAX);
+    fail |= expect_fix128("fix128_sub_sat", FIX128_MIN, FIX128_EPSILON,
+        fix128_sub_sat(FIX128_MIN, FIX128_EPSILON), FIX128_MIN);
+    fail |= expect_fix128("fix128_sub_sat", FIX128_ZERO, FIX128_MIN,
+        fix128_sub_sat(FIX128_ZERO, FIX128_MIN), FIX128_MAX);
+    return fail;
+}
+
+static int test_convert(void) {
+    int fail = 0;
+    const fix64_t values[] = {
+        FIX64_C(0), FIX64_C(1.5), FIX64_C(-1.5), FIX64_C(-0.0000001), FIX64_C(12345.6789),
+        FIX64_MAX, FIX64_MIN, FIX64_EPSILON,
+    };
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        fix128_t wide = fix128_from_fix64(values[i]);
+        if (fix128_to_fix64(wide).repr != values[i].repr ||
+            fix128_to_dbl(wide) != fix64_to_dbl(values[i])) {
+            printf("fix128_from_fix64(%" PRId64 ") didn't round trip\n", values[i].repr);
+            fail = 1;
+        }
+    }
+
+    // Rounding and saturation when narrowing
+    fix128_t half_eps = { 0, UINT64_C(1) << 31 };
+    fail |= (fix128_to_fix64(half_eps).repr != 1);
+    fail |= (fix128_to_fix64(fix128_neg(half_eps)).repr != 0);
+    fail |= (fix128_to_fix64(fix128_from_i64(INT64_C(1) << 31)).repr != INT64_MAX);
+    fail |= (fix128_to_fix64(fix128_from_i64(-(INT64_C(1) << 31))).repr != INT64_MIN);
+    fail |= (fix128_to_fix64(fix128_from_i64(-(INT64_C(1) << 31) - 1)).repr != INT64_MIN);
+    fail |= (fix128_to_fix64(FIX128_MAX).repr != INT64_MAX);
+
+    fail |= (fix128_to_i64(fix128_neg(FIX128_EPSILON)) != -1);
+    fail |= (fix128_to_i64(fix128_from_i64(INT64_MIN)) != INT64_MIN);
+
+    fail |= !fix128_eq(fix128_from_dbl(-0.25), (fix128_t){ -1, UINT64_C(3) << 62 });
+    fail |= !fix128_eq(fix128_from_dbl(1e-30), FIX128_ZERO);
+    fail |= !fix128_eq(fix128_from_dbl(-1e-30), FIX128_ZERO);
+    fail |= !fix128_eq(fix128_from_dbl(6e-20), FIX128_EPSILON);
+    fail |= !fix128_eq(fix128_from_dbl(-6e-20), fix128_neg(FIX128_EPSILON));
+    fail |= !fix128_eq(fix128_from_dbl(1e300), FIX128_MAX);
+    fail |= !fix128_eq(fix128_from_dbl(-9223372036854775808.0), FIX128_MIN);
+    fail |= !fix128_eq(fix128_from_dbl(-1e300), FIX128_MIN);
+    fail |= (fix128_to_dbl(fix128_from_dbl(-1234.5678)) != -1234.5678);
+
+    if (fail) {
+        printf("fix128 conversion failed\n");
+    }
+    return fail;
+}
+
+static int test_str(void) {
+    int fail = 0;
+    char buf[160];
+    char expected[160];
+
+    // Anything converted from a fix64_t formats the same as the fix64_t
+    const fix64_t values[] = {
+        FIX64_C(0), FIX64_C(1.5), FIX64_C(-1.5), FIX64_C(-0.0000001), FIX64_C(12345.6789),
+        FIX64_MAX, FIX64_MIN, FIX64_EPSILON, FIX64_C(0.99999999999),
+    };
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        for (int base = FIX64_BASE_DECIMAL; base <= FIX64_BASE_HEXADECIMAL; base++) {
+            static const int decimals[] = { 0, 3, 8, 19, -19 };
+            for (size_t j = 0; j < sizeof(decimals) / sizeof(decimals[0]); j++) {
+                fix64_fmt_param_t fmt = { .decimals = decimals[j], .base = base, .width = 30 };
+                if (base != FIX64_BASE_DECIMAL && decimals[j] > 8) {
+                    continue; // fix64_t stops at its last digit, fix128_t doesn't
+                }
+                fix64_to_str_fmt(expected, values[i], sizeof(expected), fmt);
+                fix128_to_str_fmt(buf, fix128_from_fix64(values[i]), sizeof(buf), fmt);
+                fail |= expect_str("fix128_to_str_fmt", buf, expected);
+            }
+        }
+    }
+
+    fix128_to_str(buf, FIX128_MIN, sizeof(buf));
+    fail |= expect_str("fix128_to_str", buf, "-9223372036854775808.00000");
+    fix128_to_str(buf, FIX128_MAX, sizeof(buf));
+    fail |= expect_str("fix128_to_str", buf, "9223372036854775808.00000");
+    fix128_to_hex(buf, FIX128_MAX, sizeof(buf));
+    fail |= expect_str("fix128_to_hex", buf, "7fffffffffffffff.ffffffffffffffff");
+    fix128_to_hex(buf, fix128_neg(FIX128_EPSILON), sizeof(buf));
+    fail |= expect_str("fix128_to_hex", buf, "-0.0000000000000001");
+    fix64_fmt_param_t fmt = { .decimals = 20 };
+    fix128_to_str_fmt(buf, FIX128_EPSILON, sizeof(buf), fmt);
+    fail |= expect_str("fix128_to_str_fmt", buf, "0.00000000000000000005");
+    fix128_to_str_fmt(buf, fix128_sub(FIX128_ONE, FIX128_EPSILON), sizeof(buf), fmt);
+    fail |= expect_str("fix128_to_str_fmt", buf, "0.99999999999999999995");
+    fix128_to_str_fmt(buf, FIX128_MAX, sizeof(buf), fmt);
+    fail |= expect_str("fix128_to_str_fmt", buf, "9223372036854775807.99999999999999999995");
+    fix128_to_str_fmt(buf, (fix128_t){ 0, UINT64_C(0x800000000000095e) }, sizeof(buf), fmt);
+    fail |= expect_str("fix128_to_str_fmt", buf, "0.50000000000000013000");
+    fix128_to_str_fmt(buf, (fix128_t){ 0, UINT64_C(3) << 62 }, sizeof(buf), fmt);
+    fail |= expect_str("fix128_to_str_fmt", buf, "0.75000000000000000000");
+    // More decimals than the fractional bits need are clamped to 20, unlike fix64_t's 19
+    fmt.decimals = 100;
+    fix128_to_str_fmt(buf, FIX128_EPSILON, sizeof(buf), fmt);
+    fail |= expect_str("fix128_to_str_fmt", buf, "0.00000000000000000005");
+    fmt.decimals = -100;
+    fix128_to_str_fmt(buf, fix128_neg(FIX128_ONE), sizeof(buf), fmt);
+    fail |= expect_str("fix128_to_str_fmt", buf, "-1");
+
+    const struct {
+        const char *str;
+        fix128_t expected;
+    } cases[] = {
+        { "0.5", FIX128_HALF },
+        { "-0.25", { -1, UINT64_C(3) << 62 } },
+        { "0.0000000000000000000542101086242752217", FIX128_EPSILON },
+        { "-0.0000000000000000000542101086242752217", { -1, UINT64_MAX } },
+        { "0.99999999999999999999999", FIX128_ONE },
+        { "0.9999999999999999999", { 0, UINT64_C(0xfffffffffffffffe) } },
+        { "9223372036854775807.99999999999999999999999", FIX128_MAX },
+        { "9223372036854775808", FIX128_MAX },
+        { "-9223372036854775808", FIX128_MIN },
+        { "-9223372036854775808.00000000000000000001", FIX128_MIN },
+        { "-99999999999999999999999", FIX128_MIN },
+        // Halfway between 0 and FIX128_EPSILON, which needs all 65 digits to round correctly
+        { "0.00000000000000000002710505431213761085018632002174854278564453125", FIX128_EPSILON },
+        { "0.000000000000000000027105054312137610850186320021748542785644531249999", FIX128_ZERO },
+        { "0.0000000000000000000271050543121376108501863200217485427856445312500001",
+            FIX128_EPSILON },
+        { "0.00000000000000000002710505431213761085018632002174854278564453124", FIX128_ZERO },
+        { "0.00000000000000000002710505431213761085018632002174854278564453126", FIX128_EPSILON },
+        { "0.000000000000000000027105054312137610850186320021748", FIX128_ZERO },
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        fix128_t value = FIX128_ZERO;
+        if (fix128_from_str(cases[i].str, strlen(cases[i].str), &value) != strlen(cases[i].str)) {
+            printf("fix128_from_str(\"%s\") didn't parse the whole string\n", cases[i].str);
+            fail = 1;
+        }
+        fail |= expect_fix128(cases[i].str, value, FIX128_ZERO, value, cases[i].expected);
+    }
+
+    // Formatting with 20 decimals and parsing gives back the original value
+    for (int i = 0; i < N; i++) {
+        fix128_t x = rng_fix128();
+        fix128_t y = FIX128_ZERO;
+        size_t len = fix128_to_str_fmt(buf, x, sizeof(buf), fmt);
+        fail |= (fix128_from_str(buf, len, &y) != len);
+        fail |= expect_fix128(buf, x, FIX128_ZERO, y, x);
+        if (fail) {
+            return 1;
+        }
+    }
+    return fail;
+}
+
+int main() {
+#ifdef __SIZEOF_INT128__
+    if (test_arith()) {
+        return 1;
+    }
+#endif
+    if (test_edge_cases() || test_convert() || test_str()) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N 200000
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 i128_t;
+#endif
+
+#ifdef __SIZEOF_INT128__
+static int test_fmod_remainder(void) {
+    static fix64_t xs[N], ys[N];
+    for (int i = 0; i < N; i++) {
+        fix64_t x = rng_fix64(64);
+        fix64_t y = rng_fix64(64);
+        if (i < 12) {
+            // Overflowing quotients and exact halfway values
+            fix64_t edge[] = { FIX64_MIN, fix64_neg(FIX64_EPSILON), FIX64_MIN, FIX64_MIN,
+                FIX64_MAX, FIX64_ONE, { 3 }, { -3 }, { 5 }, { -5 }, FIX64_MAX, FIX64_MIN };
+            fix64_t edge_y[] = { fix64_neg(FIX64_EPSILON), FIX64_MIN, FIX64_MIN, FIX64_MAX,
+                FIX64_MIN, FIX64_EPSILON, { 2 }, { 2 }, { -2 }, { 2 }, FIX64_ZERO, FIX64_ZERO };
+            x = edge[i];
+            y = edge_y[i];
+        }
+
+        i128_t expected_fmod = 0, expected_rem = 0;
+        if (y.repr != 0) {
+            i128_t quot = (i128_t)x.repr / y.repr;
+            expected_fmod = (i128_t)x.repr - quot * y.repr;
+
+            // Round the quotient to the nearest, halfway values to even
+            i128_t twice = 2 * (expected_fmod < 0 ? -expected_fmod : expected_fmod);
+            i128_t abs_y = (y.repr < 0) ? -(i128_t)y.repr : y.repr;
+            int same_sign = (x.repr < 0) == (y.repr < 0);
+            if (twice > abs_y || (twice == abs_y && (quot & 1))) {
+                quot += same_sign ? 1 : -1;
+            }
+            expected_rem = (i128_t)x.repr - quot * y.repr;
+        }
+
+        fix64_t result_fmod = fix64_fmod(x, y);
+        fix64_t result_rem = fix64_remainder(x, y);
+        if (result_fmod.repr != expected_fmod || result_rem.repr != expected_rem) {
+            printf("fmod(%" PRId64 ", %" PRId64 ") -> %" PRId64 "; expected %" PRId64 "\n", x.repr,
+                y.repr, result_fmod.repr, (int64_t)expected_fmod);
+            printf("remainder(%" PRId64 ", %" PRId64 ") -> %" PRId64 "; expected %" PRId64 "\n",
+                x.repr, y.repr, result_rem.repr, (int64_t)expected_rem);
+            return 1;
+        }
+        ys[i] = x;
+    }
+
+    fix64_t y = FIX64_C(2.5);
+    for (int i = 0; i < N; i++) {
+        xs[i] = ys[i];
+    }
+    fix64_fmod_batch(ys, y, ys, N);
+    for (int i = 0; i < N; i++) {
+        if (ys[i].repr != fix64_fmod(xs[i], y).repr) {
+            printf("fmod_batch(%" PRId64 ", 2.5) -> %" PRId64 "\n", xs[i].repr, ys[i].repr);
+            return 1;
+        }
+    }
+    return 0;
+}
+#endif
+
+static int test_modf_frexp(void) {
+    for (int i = 0; i < N; i++) {
+        fix64_t x = rng_fix64(64);
+        if (i < 6) {
+            fix64_t edge[] = { FIX64_MIN, FIX64_MAX, FIX64_ZERO, FIX64_EPSILON,
+                fix64_neg(FIX64_EPSILON), fix64_neg(FIX64_ONE) };
+            x = edge[i];
+        }
+
+        fix64_t int_part;
+        fix64_t frac = fix64_modf(x, &int_part);
+        if (int_part.repr != fix64_trunc(x).repr || fix64_add(int_part, frac).repr != x.repr) {
+            printf("modf(%" PRId64 ") -> %" PRId64 ", %" PRId64 "\n", x.repr, frac.repr,
+                int_part.repr);
+            return 1;
+        }
+
+        int exp;
+        fix64_t mant = fix64_frexp(x, &exp);
+        fix64_t abs_mant = fix64_abs(mant);
+        int in_range = (x.repr == 0) ?
+            (mant.repr == 0 && exp == 0) :
+            (fix64_gte(abs_mant, FIX64_HALF) && fix64_lt(abs_mant, FIX64_ONE));
+        // Large values lose their lowest bits, which are truncated towards zero
+        int64_t scale = INT64_C(1) << (exp > 0 ? exp : 0);
+        int64_t truncated = (x.repr / scale) * scale;
+        if (!in_range || fix64_ldexp(mant, exp).repr != truncated) {
+            printf("frexp(%" PRId64 ") -> %" PRId64 ", %d\n", x.repr, mant.repr, exp);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+#ifdef __SIZEOF_INT128__
+static int test_ldexp(void) {
+    for (int i = 0; i < N; i++) {
+        fix64_t x = rng_fix64(64);
+        int exp = (int)(rng() % 160) - 80;
+        if (i < 4) {
+            fix64_t edge[] = { FIX64_MIN, FIX64_MAX, fix64_neg(FIX64_EPSILON), FIX64_EPSILON };
+            x = edge[i];
+        }
+
+        fix64_t expected;
+        if (exp >= 0) {
+            expected.repr = (exp < 64) ? (int64_t)((uint64_t)x.repr << exp) : 0; // Wraps
+        } else {
+            // Halfway values are rounded up like fix64_mul
+            i128_t half = (i128_t)1 << (-exp - 1);
+            expected.repr = (int64_t)(((i128_t)x.repr + half) >> -exp);
+        }
+        fix64_t result = fix64_ldexp(x, exp);
+        if (result.repr != expected.repr) {
+            printf("ldexp(%" PRId64 ", %d) -> %" PRId64 "; expected %" PRId64 "\n", x.repr, exp,
+                result.repr, expected.repr);
+            return 1;
+        }
+
+        // Saturates if shifting back doesn't give the same number
+        fix64_t sat = fix64_ldexp_sat(x, exp);
+        if (exp > 0 && fix64_ldexp(result, -exp).repr != x.repr) {
+            expected = (x.repr < 0) ? FIX64_MIN : FIX64_MAX;
+        }
+        if (sat.repr != expected.repr) {
+            printf("ldexp_sat(%" PRId64 ", %d) -> %" PRId64 "; expected %" PRId64 "\n", x.repr,
+                exp, sat.repr, expected.repr);
+            return 1;
+        }
+    }
+    return 0;
+}
+#endif
+
+int main() {
+#ifdef __SIZEOF_INT128__
+    if (test_fmod_remainder() || test_ldexp()) {
+        return 1;
+    }
+#endif
+    if (test_modf_frexp()) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N 1000000
+
+// Reference conversion. Scaling by 2**32, floor and subtracting the floor are all exact
+static int64_t reference(double value) {
+    if (isnan(value)) {
+        return 0;
+    }
+    double scaled = ldexp(fabs(value), FIX64_FRAC_BITS);
+    if (scaled >= 0x1p63) {
+        return signbit(value) ? INT64_MIN : INT64_MAX;
+    }
+    double integral = floor(scaled);
+    int64_t mag = (int64_t)integral + (scaled - integral >= 0.5);
+    return signbit(value) ? -mag : mag;
+}
+
+static int check_dbl(double value) {
+    fix64_t result = fix64_from_dbl_soft(value);
+    int64_t expected = reference(value);
+    if (result.repr != expected) {
+        printf("fix64_from_dbl_soft(%a) -> 0x%016" PRIx64 "; expected 0x%016" PRIx64 "\n", value,
+            (uint64_t)result.repr, (uint64_t)expected);
+        return 0;
+    }
+    return 1;
+}
+
+static int check_flt(float value) {
+    fix64_t result = fix64_from_flt_soft(value);
+    int64_t expected = reference(value);
+    if (result.repr != expected) {
+        printf("fix64_from_flt_soft(%a) -> 0x%016" PRIx64 "; expected 0x%016" PRIx64 "\n",
+            (double)value, (uint64_t)result.repr, (uint64_t)expected);
+        return 0;
+    }
+    return 1;
+}
+
+int main() {
+    static const double dbls[] = {
+        0.0,
+        -0.0,
+        1.0,
+        -1.0,
+        0x1p-33, // halfway, rounds away from zero
+        -0x1p-33,
+        0x1.fffffffffffffp-34,
+        0x1.8p-32,
+        -0x1.8p-32,
+        0x1.0000000000001p20, // fix64_from_dbl double rounds this one
+        0x1.fffffffffffffp30,
+        0x1p31,
+        -0x1p31,
+        -0x1.0000000000001p31,
+        0x1p-1074,
+        0x1p-1022,
+        0x1p-64,
+        1e300,
+        -1e300,
+        INFINITY,
+        -INFINITY,
+        NAN,
+        -NAN,
+    };
+    for (size_t i = 0; i < sizeof(dbls) / sizeof(dbls[0]); i++) {
+        if (!check_dbl(dbls[i]) || !check_flt((float)dbls[i])) {
+            return 1;
+        }
+    }
+
+    // Random bit patterns, with exponents concentrated around fix64_t's range
+    for (size_t i = 0; i < N; i++) {
+        uint64_t bits = rng();
+        uint64_t exp = 1023 - 40 + (bits >> 52) % 80;
+        bits = (bits & UINT64_C(0x800fffffffffffff)) | (exp << 52);
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+
+        uint32_t fbits = (uint32_t)rng();
+        uint32_t fexp = 127 - 40 + (fbits >> 23) % 80;
+        fbits = (fbits & UINT32_C(0x807fffff)) | (fexp << 23);
+        float f;
+        memcpy(&f, &fbits, sizeof(f));
+
+        if (!check_dbl(d) || !check_flt(f)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+struct test {
+    const char *str;
+    size_t exp_len;
+    fix64_t exp;
+};
+
+int main() {
+    struct test tests[] = {
+        {"0", 1, FIX64_ZERO},
+        {"-0", 2, FIX64_ZERO},
+        {"+5", 2, FIX64_C(5)},
+        {"-5", 2, FIX64_C(-5)},
+        {"3.14159265358979323846", 22, FIX64_PI},
+        {"-3.14159265358979323846", 23, FIX64_C(-3.14159265358979323846)},
+        {"0.5", 3, FIX64_HALF},
+        {".5", 2, FIX64_HALF},
+        {"5.", 2, FIX64_C(5)},
+        {"12.375xyz", 6, FIX64_C(12.375)},
+        {"1234567890.123456789", 20, FIX64_C(1234567890.123456789)},
+        {"0.00000000023283064365386962890625", 34, FIX64_EPSILON},
+        {"0.000000000116415321826934814453125", 35, FIX64_EPSILON}, // exactly half, rounds up
+        {"0.000000000116415321826934814453124", 35, FIX64_ZERO},
+        {"0.0000000001164153218269348144531249999999999", 45, FIX64_ZERO},
+        {"-0.000000000116415321826934814453125", 36, { -1 }}, // rounds away from zero
+        {"0.99999999999", 13, FIX64_ONE}, // rounding carries into the integral part
+        {"0.0000000001164153218269348144531250000000000000001", 51, FIX64_EPSILON},
+        {"0.116415321943350136280059814453125", 35, { INT64_C(0x1dcd6501) }},
+        {"0.1164153219433501362800598144531249999999999", 45, { INT64_C(0x1dcd6500) }},
+        {"-0.1164153219433501362800598144531249999999999", 46, { -INT64_C(0x1dcd6500) }},
+        {"2147483647.99999999976716935634613037109375", 43, FIX64_MAX},
+        {"2147483647.9999999999", 21, FIX64_MAX},
+        {"2147483648", 10, FIX64_MAX},
+        {"99999999999999999999999", 23, FIX64_MAX},
+        {"-2147483648", 11, FIX64_MIN},
+        {"-2147483648.5", 13, FIX64_MIN},
+        {"-99999999999999999999999", 24, FIX64_MIN},
+        {"", 0, FIX64_ZERO},
+        {"-", 0, FIX64_ZERO},
+        {".", 0, FIX64_ZERO},
+        {"+.", 0, FIX64_ZERO},
+        {" 1", 0, FIX64_ZERO},
+        {"x1", 0, FIX64_ZERO},
+    };
+
+    const size_t num_test = sizeof(tests) / sizeof(tests[0]);
+    for (size_t i = 0; i < num_test; i++) {
+        fix64_t result = FIX64_ZERO;
+        size_t len = fix64_from_str(tests[i].str, strlen(tests[i].str), &result);
+
+        if (len != tests[i].exp_len || !fix64_eq(result, tests[i].exp)) {
+            printf("fix64_from_str(\"%s\") -> %zu, 0x%016" PRIx64 "; expected %zu, 0x%016" PRIx64 "\n",
+                tests[i].str, len, (uint64_t)result.repr, tests[i].exp_len, (uint64_t)tests[i].exp.repr);
+            return 1;
+        }
+    }
+
+    // size limits the number of characters read
+    fix64_t result;
+    size_t len = fix64_from_str("123.456", 5, &result);
+    if (len != 5 || !fix64_eq(result, FIX64_C(123.4))) {
+        printf("fix64_from_str(\"123.456\", 5) -> %zu, %.10f; expected 5, 123.4\n",
+            len, fix64_to_dbl(result));
+        return 1;
+    }
+
+    // Formatting with >= 10 decimals and parsing again must round trip exactly
+    char buf[64];
+    fix64_fmt_param_t fmt = { .decimals = 10 };
+    for (int i = 0; i < 1000000; i++) {
+        fix64_t value = { (int64_t)rng() >> (i & 31) };
+
+        size_t str_len = fix64_to_str_fmt(buf, value, sizeof(buf), fmt);
+        len = fix64_from_str(buf, sizeof(buf), &result);
+
+        if (len != str_len || !fix64_eq(result, value)) {
+            printf("fix64_from_str(\"%s\") -> %zu, 0x%016" PRIx64 "; expected %zu, 0x%016" PRIx64 "\n",
+                buf, len, (uint64_t)result.repr, str_len, (uint64_t)value.repr);
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <fix64.hpp>
+
+#include "common.h"
+
+#define N 100000
+
+using fix64::fixed;
+
+static int check(const char *name, size_t i, fixed result, fix64_t expected) {
+    if (result.repr() != expected.repr) {
+        printf("%s [%zu] -> 0x%016" PRIx64 "; expected 0x%016" PRIx64 "\n", name, i,
+            (uint64_t)result.repr(), (uint64_t)expected.repr);
+        return 0;
+    }
+    return 1;
+}
+
+int main() {
+    for (size_t i = 0; i < N; i++) {
+        fixed a = rng_fix64(64);
+        fixed b = rng_fix64(64);
+        fixed c = rng_fix64(64);
+        fixed d = rng_fix64(64);
+
+        // Single operations are identical to the C functions, except that negation wraps
+        int ok = check("a + b", i, a + b, fix64_add(a, b)) &&
+            check("a - b", i, a - b, fix64_sub(a, b)) && check("-a", i, -a, fix64_neg(a)) &&
+            check("a * b", i, a * b, fix64_mul(a, b)) &&
+            check("a * b * c", i, a * b * c, fix64_mul(fix64_mul(a, b), c));
+        if (b != fixed()) {
+            ok = ok && check("a / b", i, a / b, fix64_div(a, b));
+        }
+
+        // Fused sums of products are rounded once
+        int64_t hi;
+        uint64_t lo = fix64_impl_mul_i64_i128(a.repr(), b.repr(), &hi);
+        int64_t cd_hi;
+        uint64_t cd_lo = fix64_impl_mul_i64_i128(c.repr(), d.repr(), &cd_hi);
+        lo = fix64_impl_sub_i128(hi, lo, cd_hi, cd_lo, &hi);
+        lo = fix64_impl_add_i128(hi, lo, d.repr() >> 32, (uint64_t)d.repr() << 32, &hi);
+        lo = fix64_impl_add_i128(hi, lo, 0, UINT64_C(1) << 31, &hi);
+        fix64_t expected = { (int64_t)(((uint64_t)hi << 32) | (lo >> 32)) };
+        ok = ok && check("a * b - c * d + d", i, a * b - c * d + d, expected);
+
+        fixed acc = a;
+        acc += b * c;
+        acc -= d;
+        ok = ok && check("compound", i, acc, fix64_sub(fix64_add(a, fix64_mul(b, c)), d));
+
+        ok = ok && ((a < b) == fix64_lt(a, b)) && ((a >= b) == fix64_gte(a, b)) &&
+            ((a * b == c) == fix64_eq(fix64_mul(a, b), c));
+        if (!ok) {
+            return 1;
+        }
+    }
+
+    // Two products of half an ulp each: rounding each gives 2 ulps, the exact sum is 1 ulp
+    fixed eps = fixed(FIX64_EPSILON);
+    fixed half = fixed(FIX64_HALF);
+    if (!check("eps * half + eps * half", 0, eps * half + eps * half, FIX64_EPSILON)) {
+        return 1;
+    }
+
+    // Negating FIX64_MIN wraps like the other operators, whether or not it's part of an expression
+    fixed min = fixed(FIX64_MIN);
+    if (!check("-min", 0, -min, FIX64_MIN) ||
+        !check("-(min + 0)", 0, -(min + fixed()), FIX64_MIN)) {
+        return 1;
+    }
+
+    fixed x = fixed::from_dbl(1.5) * fixed::from_int(3) - fixed::from_int(1);
+    if (x.to_dbl() != 3.5 || x.to_int() != 3) {
+        printf("1.5 * 3 - 1 -> %f; expected 3.5\n", x.to_dbl());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include "fix64/impl.h"
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N 1000000
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 u128_t;
+#endif
+
+typedef uint64_t (*div_fn_t)(uint64_t, uint64_t, uint64_t);
+
+static uint64_t div_runtime(uint64_t u_hi, uint64_t u_lo, uint64_t v) {
+    return fix64_impl_div_u128_u64_runtime(u_hi, u_lo, v);
+}
+
+static const struct {
+    const char *name;
+    div_fn_t fn;
+} engines[] = {
+#if FIX64_IMPL_USE_NATIVE_DIVQ
+    { "divq", fix64_impl_div_u128_u64_divq },
+#endif
+    { "soft", fix64_impl_div_u128_u64_soft },
+    { "recip", fix64_impl_div_u128_u64_recip },
+    { "runtime", div_runtime },
+};
+
+// The engines which fix64_select_div_engine can choose for div_runtime
+static const int runtime_engines[] = {
+#if FIX64_IMPL_USE_NATIVE_DIVQ
+    FIX64_DIV_ENGINE_DIVQ,
+#endif
+    FIX64_DIV_ENGINE_SOFT,
+    FIX64_DIV_ENGINE_RECIP,
+};
+
+// Checks every engine gives the same result as the reference, including when the quotient wraps
+static int check(uint64_t u_hi, uint64_t u_lo, uint64_t v, uint64_t expected) {
+    for (size_t i = 0; i < sizeof(engines) / sizeof(engines[0]); i++) {
+        uint64_t q = engines[i].fn(u_hi, u_lo, v);
+        if (q != expected) {
+            printf("div_u128_u64_%s(0x%016" PRIx64 "%016" PRIx64 ", 0x%016" PRIx64
+                   ") -> 0x%016" PRIx64 "; expected 0x%016" PRIx64 "\n",
+                engines[i].name, u_hi, u_lo, v, q, expected);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int check_all(void) {
+    // Quotients close to a multiple of the divisor, where the correction steps are needed
+    for (unsigned shift = 0; shift < 64; shift++) {
+        for (int i = 0; i < 1000; i++) {
+            uint64_t v = (rng() | (UINT64_C(1) << 63)) >> shift;
+            uint64_t q = rng();
+            uint64_t rem = (i & 1) ? v - 1 - (rng() & 3) % v : (rng() & 3) % v;
+            uint64_t u_hi;
+            uint64_t u_lo = fix64_impl_mul_u64_u128(q, v, &u_hi);
+            u_lo = fix64_impl_add_u128(u_hi, u_lo, 0, rem, &u_hi);
+            if (check(u_hi, u_lo, v, q)) {
+                return 1;
+            }
+        }
+    }
+
+#ifdef __SIZEOF_INT128__
+    // Random dividends and divisors with random magnitudes, so the quotient often wraps
+    for (int i = 0; i < N; i++) {
+        uint64_t u_hi = rng_bits();
+        uint64_t u_lo = rng();
+        uint64_t v = rng_bits();
+        if (v == 0) {
+            continue;
+        }
+        uint64_t expected = (uint64_t)((((u128_t)u_hi << 64) | u_lo) / v);
+        if (check(u_hi, u_lo, v, expected)) {
+            return 1;
+        }
+    }
+#endif
+
+    // The extremes
+    if (check(UINT64_MAX - 1, UINT64_MAX, UINT64_MAX, UINT64_MAX) ||
+        check(0, UINT64_MAX, 1, UINT64_MAX) || check(0, 0, 1, 0) ||
+        check(INT64_MAX, UINT64_MAX, UINT64_C(1) << 63, UINT64_MAX)) {
+        return 1;
+    }
+    return 0;
+}
+
+// Checks fix64_recip, which is fix64_div_sat with divq and uses a table otherwise, including when
+// the engine is chosen at runtime
+static int check_recip(void) {
+    for (int i = 0; i < N; i++) {
+        fix64_t x = rng_fix64(64);
+        fix64_t result = fix64_recip(x);
+        fix64_t expected = fix64_div_sat(FIX64_ONE, x);
+        if (result.repr != expected.repr) {
+            printf("fix64_recip(%" PRId64 ") -> %" PRId64 "; expected %" PRId64 "\n", x.repr,
+                result.repr, expected.repr);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main() {
+    for (size_t i = 0; i < sizeof(runtime_engines) / sizeof(runtime_engines[0]); i++) {
+        if (!fix64_select_div_engine(runtime_engines[i]) ||
+            fix64_impl_div_engine_runtime != runtime_engines[i]) {
+            printf("fix64_select_div_engine(%d) didn't select the engine\n", runtime_engines[i]);
+            return 1;
+        }
+        if (check_all() || check_recip()) {
+            return 1;
+        }
+    }
+
+    // Unknown engines leave the current one in place
+    if (fix64_select_div_engine(0) || fix64_select_div_engine(FIX64_DIV_ENGINE_RUNTIME)) {
+        printf("fix64_select_div_engine accepted an unknown engine\n");
+        return 1;
+    }
+#if !FIX64_IMPL_USE_NATIVE_DIVQ
+    if (fix64_select_div_engine(FIX64_DIV_ENGINE_DIVQ)) {
+        printf("fix64_select_div_engine accepted divq without x86-64\n");
+        return 1;
+    }
+#endif
+    return check_all();
+}
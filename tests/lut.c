@@ -0,0 +1,83 @@
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N 100000
+
+// Generated from tests/lut_tables.c.jinja
+extern const fix64_lut_t test_sigmoid;
+extern const fix64_lut_t test_gamma;
+extern const fix64_lut_t test_exp;
+
+// Exact conversion to long double, since a double doesn't have enough precision
+static long double to_ldbl(fix64_t arg) {
+    return ldexpl((long double)arg.repr, -FIX64_FRAC_BITS);
+}
+
+static long double sigmoid(long double x) {
+    return 1 / (1 + expl(-x));
+}
+
+static long double gamma_ramp(long double x) {
+    return powl(x, 1 / 2.2L);
+}
+
+// Checks a table against func in [lo, hi] with random points, allowing an error of
+// abs_tol + rel_tol * |func(x)|, and checks the table is clamped outside its range
+static int test_table(const char *name, const fix64_lut_t *lut, long double (*func)(long double),
+    long double lo, long double hi, long double abs_tol, long double rel_tol) {
+    static fix64_t xs[N], ys[N];
+    for (int i = 0; i < N; i++) {
+        long double frac = (long double)(rng() >> 11) / (1ull << 53);
+        xs[i] = fix64_from_ldbl(lo + frac * (hi - lo));
+    }
+    xs[0] = fix64_from_ldbl(lo);
+    xs[1] = fix64_from_ldbl(hi);
+    fix64_lut_eval_batch(lut, xs, ys, N);
+
+    for (int i = 0; i < N; i++) {
+        fix64_t value = fix64_lut_eval(lut, xs[i]);
+        long double expected = func(to_ldbl(xs[i]));
+        long double err = fabsl(to_ldbl(value) - expected);
+        if (err > abs_tol + rel_tol * fabsl(expected) || value.repr != ys[i].repr) {
+            printf("%s(%.10Lf) -> %.10Lf; expected %.10Lf\n", name, to_ldbl(xs[i]),
+                to_ldbl(value), expected);
+            return 1;
+        }
+    }
+
+    fix64_t first = fix64_lut_eval(lut, lut->lo);
+    fix64_t last = fix64_lut_eval(lut,
+        (fix64_t){ lut->lo.repr + (int64_t)(((uint64_t)lut->size << lut->shift) - 1) });
+    if (fix64_lut_eval(lut, FIX64_MIN).repr != first.repr ||
+        fix64_lut_eval(lut, FIX64_MAX).repr != last.repr) {
+        printf("%s isn't clamped outside of the table\n", name);
+        return 1;
+    }
+    return 0;
+}
+
+int main() {
+    // The tolerances are slightly above the maximum errors reported by the generator
+    if (test_table("test_sigmoid", &test_sigmoid, sigmoid, -8, 8, 6e-9L, 0) ||
+        test_table("test_gamma", &test_gamma, gamma_ramp, 0, 1, 0.013L, 0) ||
+        test_table("test_exp", &test_exp, expl, -4, 20, 1e-9L, 5e-9L)) {
+        return 1;
+    }
+
+    // Linear interpolation is exact (up to rounding) at the ends of each interval
+    for (size_t i = 0; i < test_gamma.size; i++) {
+        fix64_t x = { test_gamma.lo.repr + (int64_t)(i << test_gamma.shift) };
+        fix64_t expected = fix64_from_ldbl(gamma_ramp(to_ldbl(x)));
+        if (llabs(fix64_lut_eval(&test_gamma, x).repr - expected.repr) > 1) {
+            printf("test_gamma isn't exact at %.10Lf\n", to_ldbl(x));
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N        20000
+#define MAX_COEF 12
+
+// Exact conversion to long double, since a double doesn't have enough precision
+static long double to_ldbl(fix64_t arg) {
+    return ldexpl((long double)arg.repr, -FIX64_FRAC_BITS);
+}
+
+static int test_init(void) {
+    fix64_poly_t poly;
+    fix64_t coefs[2] = { FIX64_ONE, FIX64_MAX };
+    if (fix64_poly_init(&poly, coefs, 0, FIX64_ZERO, FIX64_ONE, FIX64_POLY_HORNER) != -1 ||
+        fix64_poly_init(&poly, coefs, 1, FIX64_ONE, FIX64_ONE, FIX64_POLY_HORNER) != -1 ||
+        fix64_poly_init(&poly, coefs, 1, FIX64_ONE, FIX64_ZERO, FIX64_POLY_HORNER) != -1) {
+        printf("fix64_poly_init accepted invalid arguments\n");
+        return 1;
+    }
+    if (fix64_poly_init(&poly, coefs, 2, FIX64_MIN, FIX64_MAX, FIX64_POLY_ESTRIN) != 0) {
+        printf("fix64_poly_init failed for large coefficients\n");
+        return 1;
+    }
+    // 1 + MAX * t saturates once t is large enough
+    if (fix64_poly_eval(&poly, FIX64_MAX).repr != INT64_MAX ||
+        fix64_poly_eval(&poly, FIX64_MIN).repr != FIX64_ONE.repr) {
+        printf("fix64_poly_eval failed for large coefficients\n");
+        return 1;
+    }
+    return 0;
+}
+
+static int test_eval(void) {
+    fix64_t coefs[MAX_COEF];
+    fix64_t xs[64], ys_horner[64], ys_estrin[64];
+    for (int i = 0; i < N; i++) {
+        size_t n = 1 + rng() % MAX_COEF;
+        // Coefficients up to 2^8, or sometimes up to 2^31 which reduces the internal precision
+        unsigned coef_bits = (i % 8 == 0) ? 64 : 40;
+        long double sum_abs = 0;
+        for (size_t j = 0; j < n; j++) {
+            coefs[j] = rng_fix64(coef_bits);
+            sum_abs += fabsl(to_ldbl(coefs[j]));
+        }
+        fix64_t lo = rng_fix64(64);
+        fix64_t hi = rng_fix64(64);
+        if (lo.repr == hi.repr) {
+            continue;
+        } else if (lo.repr > hi.repr) {
+            fix64_t tmp = lo;
+            lo = hi;
+            hi = tmp;
+        }
+
+        fix64_poly_t horner, estrin;
+        if (fix64_poly_init(&horner, coefs, n, lo, hi, FIX64_POLY_HORNER) != 0 ||
+            fix64_poly_init(&estrin, coefs, n, lo, hi, FIX64_POLY_ESTRIN) != 0) {
+            printf("fix64_poly_init failed (iteration %d)\n", i);
+            return 1;
+        }
+
+        // Points spread over the interval, including the end points and points outside it
+        long double width = (long double)hi.repr - (long double)lo.repr;
+        for (int j = 0; j < 64; j++) {
+            long double frac = (long double)(rng() >> 11) / (1ull << 53);
+            frac = (j == 0) ? 0 : (j == 1) ? 1 : frac;
+            xs[j].repr = lo.repr + (int64_t)(frac * width);
+            xs[j].repr = (xs[j].repr > hi.repr) ? hi.repr : xs[j].repr;
+        }
+        xs[2] = FIX64_MIN;
+        xs[3] = FIX64_MAX;
+        fix64_poly_eval_batch(&horner, xs, ys_horner, 64);
+        fix64_poly_eval_batch(&estrin, xs, ys_estrin, 64);
+
+        for (int j = 0; j < 64; j++) {
+            fix64_t x = xs[j];
+            x = (x.repr < lo.repr) ? lo : (x.repr > hi.repr) ? hi : x;
+            long double t = ((long double)x.repr - (long double)lo.repr) / width;
+
+            long double expected = 0, deriv = 0;
+            for (size_t k = n; k-- > 0;) {
+                deriv = deriv * t + expected;
+                expected = expected * t + to_ldbl(coefs[k]);
+            }
+
+            // Rounding of the result, plus an error of a few units in the last place for each step
+            // of the evaluation, plus the error in t
+            long double eps = ldexpl(1, -FIX64_FRAC_BITS);
+            long double tol = eps / 2 + (n + 2) * ldexpl(1, -(int)horner.frac_bits) +
+                fabsl(deriv) * ldexpl(1, -60) + sum_abs * ldexpl(1, -62);
+            fix64_t results[2] = { fix64_poly_eval(&horner, xs[j]),
+                fix64_poly_eval(&estrin, xs[j]) };
+            long double limit = ldexpl(1, FIX64_INT_BITS);
+            int sat = (expected >= limit) || (expected <= -limit);
+            for (int k = 0; k < 2; k++) {
+                long double err = fabsl(to_ldbl(results[k]) - expected);
+                if ((!sat && err > tol) ||
+                    (sat && results[k].repr != ((expected > 0) ? INT64_MAX : INT64_MIN))) {
+                    printf("fix64_poly_eval (%s, iteration %d, n = %zu) at %.10Lf -> %.10Lf; "
+                           "expected %.10Lf\n",
+                        k ? "estrin" : "horner", i, n, to_ldbl(xs[j]), to_ldbl(results[k]),
+                        expected);
+                    return 1;
+                }
+            }
+            if (results[0].repr != ys_horner[j].repr || results[1].repr != ys_estrin[j].repr) {
+                printf("fix64_poly_eval_batch differs (iteration %d)\n", i);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int main() {
+    if (test_init() || test_eval()) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define MAX_POINTS 300
+#define N          20000
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 i128_t;
+#endif
+
+// Exact conversion to long double, since a double doesn't have enough precision
+static long double to_ldbl(fix64_t arg) {
+    return ldexpl((long double)arg.repr, -FIX64_FRAC_BITS);
+}
+
+static int cmp_fix64(const void *lhs, const void *rhs) {
+    int64_t x = ((const fix64_t *)lhs)->repr, y = ((const fix64_t *)rhs)->repr;
+    return (x > y) - (x < y);
+}
+
+// Sorts xs and removes duplicates, returning the new count
+static size_t sort_unique(fix64_t *xs, size_t n) {
+    qsort(xs, n, sizeof(fix64_t), cmp_fix64);
+    size_t count = 1;
+    for (size_t i = 1; i < n; i++) {
+        if (xs[i].repr != xs[count - 1].repr) {
+            xs[count++] = xs[i];
+        }
+    }
+    return count;
+}
+
+// Checks the interpolation at x against the exact value, which is rounded to nearest (with halfway
+// values rounded up) if the values are small enough
+static int check(const fix64_t *xs, const fix64_t *ys, size_t n, fix64_t x, fix64_t result) {
+    size_t i = 0;
+    while (i + 1 < n && xs[i + 1].repr <= x.repr) {
+        i++;
+    }
+    int64_t expected;
+    uint64_t tol = 0;
+    if (x.repr <= xs[0].repr) {
+        expected = ys[0].repr;
+    } else if (i == n - 1) {
+        expected = ys[n - 1].repr;
+    } else {
+        long double t = (to_ldbl(x) - to_ldbl(xs[i])) / (to_ldbl(xs[i + 1]) - to_ldbl(xs[i]));
+        long double dy = (long double)ys[i + 1].repr - (long double)ys[i].repr;
+        expected = (int64_t)floorl((long double)ys[i].repr + t * dy + 0.5L);
+        tol = (fabsl(dy) < 0x1p61L) ? 1 : 5;
+#ifdef __SIZEOF_INT128__
+        i128_t exact_dy = (i128_t)ys[i + 1].repr - ys[i].repr;
+        if (exact_dy < ((i128_t)1 << 62) && exact_dy > -((i128_t)1 << 62)) {
+            // floor(y0 + (x - x0) * dy / width + 1/2)
+            i128_t width = (i128_t)xs[i + 1].repr - xs[i].repr;
+            i128_t num = ((i128_t)x.repr - xs[i].repr) * exact_dy * 2 + width;
+            i128_t quot = num / (2 * width);
+            quot -= (quot * 2 * width > num);
+            expected = (int64_t)(ys[i].repr + quot);
+            tol = 1;
+        }
+#endif
+    }
+    uint64_t err = (result.repr > expected) ? (uint64_t)result.repr - (uint64_t)expected :
+                                              (uint64_t)expected - (uint64_t)result.repr;
+    if (err > tol) {
+        printf("fix64_pwl_eval(%.10Lf) -> %" PRId64 "; expected %" PRId64 "\n", to_ldbl(x),
+            result.repr, expected);
+        return 1;
+    }
+    return 0;
+}
+
+int main() {
+    static fix64_t xs[MAX_POINTS], ys[MAX_POINTS], queries[N], results[N];
+    static fix64_pwl_segment_t segments[FIX64_PWL_SEGMENTS(MAX_POINTS)];
+
+    for (int test = 0; test < 40; test++) {
+        size_t n = 1 + rng() % MAX_POINTS;
+        unsigned x_bits = 16 + (unsigned)(rng() % 49), y_bits = 16 + (unsigned)(rng() % 49);
+        for (size_t i = 0; i < n; i++) {
+            xs[i] = rng_fix64(x_bits);
+            ys[i] = rng_fix64(y_bits);
+        }
+        if (test % 4 == 0) {
+            xs[0] = FIX64_MIN;
+            xs[1 % n] = FIX64_MAX;
+            ys[0] = FIX64_MAX;
+            ys[1 % n] = FIX64_MIN;
+        }
+        n = sort_unique(xs, n);
+
+        fix64_pwl_t pwl;
+        if (fix64_pwl_init(&pwl, segments, xs, ys, n)) {
+            printf("fix64_pwl_init failed\n");
+            return 1;
+        }
+
+        // Random queries, including the breakpoints (which are exact) and values outside them,
+        // and then sorted queries for the batch search
+        for (size_t i = 0; i < N; i++) {
+            queries[i] = rng_fix64(x_bits + 1);
+            if (i < n) {
+                queries[i] = xs[i];
+            }
+        }
+        for (int sorted = 0; sorted < 2; sorted++) {
+            if (sorted) {
+                qsort(queries, N, sizeof(fix64_t), cmp_fix64);
+            }
+            fix64_pwl_eval_batch(&pwl, queries, results, N);
+            for (size_t i = 0; i < N; i++) {
+                fix64_t result = fix64_pwl_eval(&pwl, queries[i]);
+                if (result.repr != results[i].repr) {
+                    printf("fix64_pwl_eval_batch differs from fix64_pwl_eval\n");
+                    return 1;
+                }
+                if (!sorted && i < n && result.repr != ys[i].repr) {
+                    printf("fix64_pwl_eval isn't exact at breakpoint %zu\n", i);
+                    return 1;
+                }
+                if (i % 16 == 0 && check(xs, ys, n, queries[i], result)) {
+                    return 1;
+                }
+            }
+        }
+    }
+
+    fix64_pwl_t pwl;
+    xs[0] = xs[1] = FIX64_ONE;
+    if (fix64_pwl_init(&pwl, segments, xs, ys, 0) != -1 ||
+        fix64_pwl_init(&pwl, segments, xs, ys, 2) != -1) {
+        printf("fix64_pwl_init accepts invalid breakpoints\n");
+        return 1;
+    }
+    return 0;
+}
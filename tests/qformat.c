@@ -0,0 +1,352 @@
+#include <float.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N 100000
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 i128_t;
+__extension__ typedef unsigned __int128 u128_t;
+#endif
+
+static int expect_str(const char *name, const char *value, const char *expected) {
+    if (strcmp(value, expected) != 0) {
+        printf("%s -> \"%s\"; expected \"%s\"\n", name, value, expected);
+        return 1;
+    }
+    return 0;
+}
+
+static int expect_int(const char *name, int64_t value, int64_t expected) {
+    if (value != expected) {
+        printf("%s -> %" PRId64 " (0x%016" PRIx64 "); expected %" PRId64 " (0x%016" PRIx64 ")\n",
+            name, value, (uint64_t)value, expected, (uint64_t)expected);
+        return 1;
+    }
+    return 0;
+}
+
+// Reference for fix32_t arithmetic using plain 64-bit integers
+static int32_t sat32(int64_t x) {
+    return (x > INT32_MAX) ? INT32_MAX : (x < INT32_MIN) ? INT32_MIN : (int32_t)x;
+}
+
+static int64_t ref_mul32(int32_t x, int32_t y) {
+    int64_t p = (int64_t)x * y;
+    // floor((p + 2^15) / 2^16) without relying on arithmetic shifts
+    int64_t q = (p + 32768) / 65536;
+    return (q * 65536 > p + 32768) ? q - 1 : q;
+}
+
+static int64_t ref_div32(int32_t x, int32_t y) {
+    int64_t n = (int64_t)x * 65536;
+    int64_t q = n / y;
+    int64_t r = n % y;
+    if (2 * llabs(r) >= llabs((int64_t)y)) {
+        q += ((n < 0) != (y < 0)) ? -1 : 1;
+    }
+    return q;
+}
+
+static int test_fix32_arith(void) {
+    for (int i = 0; i < N; i++) {
+        fix32_t x = { (int32_t)rng_bits() };
+        fix32_t y = { (int32_t)rng_bits() };
+        int64_t sum = (int64_t)x.repr + y.repr;
+        int64_t diff = (int64_t)x.repr - y.repr;
+        int64_t prod = ref_mul32(x.repr, y.repr);
+
+        int fail = 0;
+        fail |= expect_int("fix32_add_sat()", fix32_add_sat(x, y).repr, sat32(sum));
+        fail |= expect_int("fix32_sub_sat()", fix32_sub_sat(x, y).repr, sat32(diff));
+        fail |= expect_int("fix32_mul_sat()", fix32_mul_sat(x, y).repr, sat32(prod));
+        if (prod == sat32(prod)) {
+            fail |= expect_int("fix32_mul()", fix32_mul(x, y).repr, prod);
+        }
+        if (y.repr) {
+            int64_t quot = ref_div32(x.repr, y.repr);
+            fail |= expect_int("fix32_div_sat()", fix32_div_sat(x, y).repr, sat32(quot));
+            if (quot == sat32(quot)) {
+                fail |= expect_int("fix32_div()", fix32_div(x, y).repr, quot);
+            }
+        }
+        if (fail) {
+            printf("    for x = 0x%08" PRIx32 ", y = 0x%08" PRIx32 "\n", (uint32_t)x.repr,
+                (uint32_t)y.repr);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+#ifdef __SIZEOF_INT128__
+static int test_wide_arith(void) {
+    for (int i = 0; i < N; i++) {
+        fix64q16_t x = { (int64_t)rng_bits() };
+        fix64q16_t y = { (int64_t)rng_bits() };
+        i128_t prod = ((i128_t)x.repr * y.repr + (1 << 15)) >> 16;
+        int64_t prod_sat = (prod > INT64_MAX) ? INT64_MAX
+            : (prod < INT64_MIN)              ? INT64_MIN
+                                              : (int64_t)prod;
+
+        ufix64_t ux = { rng_bits() };
+        ufix64_t uy = { rng_bits() };
+        u128_t uprod = ((u128_t)ux.repr * uy.repr + (UINT64_C(1) << 31)) >> 32;
+        uint64_t uprod_sat = (uprod > UINT64_MAX) ? UINT64_MAX : (uint64_t)uprod;
+
+        int fail = 0;
+        fail |= expect_int("fix64q16_mul_sat()", fix64q16_mul_sat(x, y).repr, prod_sat);
+        fail |= expect_int("fix64q16_mul()", fix64q16_mul(x, y).repr, (int64_t)(uint64_t)prod);
+        fail |= expect_int(
+            "ufix64_mul_sat()", (int64_t)ufix64_mul_sat(ux, uy).repr, (int64_t)uprod_sat);
+        fail |= expect_int(
+            "ufix64_mul()", (int64_t)ufix64_mul(ux, uy).repr, (int64_t)(uint64_t)uprod);
+
+        if (y.repr) {
+            i128_t n = (i128_t)x.repr * 65536;
+            i128_t quot = n / y.repr;
+            i128_t rem = n % y.repr;
+            if (2 * (rem < 0 ? -rem : rem) >= (y.repr < 0 ? -(i128_t)y.repr : y.repr)) {
+                quot += ((n < 0) != (y.repr < 0)) ? -1 : 1;
+            }
+            int64_t quot_sat = (quot > INT64_MAX) ? INT64_MAX
+                : (quot < INT64_MIN)              ? INT64_MIN
+                                                  : (int64_t)quot;
+            fail |= expect_int("fix64q16_div_sat()", fix64q16_div_sat(x, y).repr, quot_sat);
+            if (quot == quot_sat) {
+                fail |= expect_int("fix64q16_div()", fix64q16_div(x, y).repr, quot_sat);
+            }
+        }
+        if (uy.repr) {
+            u128_t n = (u128_t)ux.repr << 32;
+            u128_t quot = (n + uy.repr / 2) / uy.repr;
+            uint64_t quot_sat = (quot > UINT64_MAX) ? UINT64_MAX : (uint64_t)quot;
+            fail |= expect_int(
+                "ufix64_div_sat()", (int64_t)ufix64_div_sat(ux, uy).repr, (int64_t)quot_sat);
+            if (quot == quot_sat) {
+                fail |= expect_int(
+                    "ufix64_div()", (int64_t)ufix64_div(ux, uy).repr, (int64_t)quot_sat);
+            }
+        }
+        if (fail) {
+            printf("    for x = 0x%016" PRIx64 ", y = 0x%016" PRIx64 ", ux = 0x%016" PRIx64
+                   ", uy = 0x%016" PRIx64 "\n",
+                (uint64_t)x.repr, (uint64_t)y.repr, ux.repr, uy.repr);
+            return 1;
+        }
+    }
+    return 0;
+}
+#endif
+
+// Checks conversions between every pair of formats against a long double reference, which is
+// exact if long double has at least 64 bits of mantissa
+#define CHECK_CVT(dst, dst_bits, dst_min, dst_max, src, src_bits, src_repr_t)                  \
+    do {                                                                                       \
+        src##_t in = { (src_repr_t)rng_bits() };                                               \
+        long double ref = floorl(ldexpl((long double)in.repr, dst_bits - src_bits) + 0.5L);     \
+        ref = (ref > (long double)dst_max) ? (long double)dst_max : ref;                       \
+        ref = (ref < (long double)dst_min) ? (long double)dst_min : ref;                       \
+        dst##_t out = dst##_from_##src(in);                                                    \
+        if ((long double)out.repr != ref) {                                                    \
+            printf(#dst "_from_" #src "(0x%016" PRIx64 ") -> 0x%016" PRIx64 "; expected %Lf\n", \
+                (uint64_t)in.repr, (uint64_t)out.repr, ref);                                    \
+            return 1;                                                                          \
+        }                                                                                      \
+    } while (0)
+
+static int test_convert(void) {
+#if LDBL_MANT_DIG >= 64
+    for (int i = 0; i < N; i++) {
+        CHECK_CVT(fix32, 16, INT32_MIN, INT32_MAX, fix64, 32, int64_t);
+        CHECK_CVT(fix32, 16, INT32_MIN, INT32_MAX, ufix64, 32, uint64_t);
+        CHECK_CVT(fix32, 16, INT32_MIN, INT32_MAX, fix64q16, 16, int64_t);
+        CHECK_CVT(ufix64, 32, 0, UINT64_MAX, fix64, 32, int64_t);
+        CHECK_CVT(ufix64, 32, 0, UINT64_MAX, fix32, 16, int32_t);
+        CHECK_CVT(ufix64, 32, 0, UINT64_MAX, fix64q16, 16, int64_t);
+        CHECK_CVT(fix64q16, 16, INT64_MIN, INT64_MAX, fix64, 32, int64_t);
+        CHECK_CVT(fix64q16, 16, INT64_MIN, INT64_MAX, fix32, 16, int32_t);
+        CHECK_CVT(fix64q16, 16, INT64_MIN, INT64_MAX, ufix64, 32, uint64_t);
+        CHECK_CVT(fix64, 32, INT64_MIN, INT64_MAX, fix32, 16, int32_t);
+        CHECK_CVT(fix64, 32, INT64_MIN, INT64_MAX, ufix64, 32, uint64_t);
+        CHECK_CVT(fix64, 32, INT64_MIN, INT64_MAX, fix64q16, 16, int64_t);
+    }
+#endif
+
+    fix64_t src[4] = { FIX64_C(1.5), FIX64_C(-0.25), FIX64_MAX, FIX64_C(0x1p-17) };
+    fix32_t dst[4];
+    fix64_t back[4];
+    fix32_from_fix64_n(dst, src, 4);
+    fix64_from_fix32_n(back, dst, 4);
+    int fail = 0;
+    fail |= expect_int("fix32_from_fix64_n()[0]", dst[0].repr, 0x18000);
+    fail |= expect_int("fix32_from_fix64_n()[1]", dst[1].repr, -0x4000);
+    fail |= expect_int("fix32_from_fix64_n()[2]", dst[2].repr, INT32_MAX);
+    fail |= expect_int("fix32_from_fix64_n()[3]", dst[3].repr, 1); // halfway rounds up
+    fail |= expect_int("fix64_from_fix32_n()[0]", back[0].repr, src[0].repr);
+    fail |= expect_int("fix64_from_fix32_n()[1]", back[1].repr, src[1].repr);
+    return fail;
+}
+
+static int test_str(void) {
+    char buf[128];
+    int fail = 0;
+
+    fix32_to_str(buf, FIX32_C(-1.5), sizeof(buf));
+    fail |= expect_str("fix32_to_str(-1.5)", buf, "-1.50000");
+    fix32_to_hex(buf, FIX32_C(-1.5), sizeof(buf));
+    fail |= expect_str("fix32_to_hex(-1.5)", buf, "-1.8000");
+    fix32_to_str(buf, FIX32_MIN, sizeof(buf));
+    fail |= expect_str("fix32_to_str(FIX32_MIN)", buf, "-32768.00000");
+    ufix64_to_str(buf, UFIX64_MAX, sizeof(buf));
+    fail |= expect_str("ufix64_to_str(UFIX64_MAX)", buf, "4294967296.00000");
+    fix64q16_to_str(buf, FIX64Q16_MAX, sizeof(buf));
+    fail |= expect_str("fix64q16_to_str(FIX64Q16_MAX)", buf, "140737488355327.99998");
+    fix64q16_to_str(buf, FIX64Q16_MIN, sizeof(buf));
+    fail |= expect_str("fix64q16_to_str(FIX64Q16_MIN)", buf, "-140737488355328.00000");
+    fix64q16_to_str_fmt(buf, FIX64Q16_MAX, sizeof(buf),
+        (fix64_fmt_param_t){ .base = FIX64_BASE_BINARY, .decimals = -100 });
+    fail |= expect_str("fix64q16_to_str_fmt(FIX64Q16_MAX, binary)", buf,
+        "11111111111111111111111111111111111111111111111.1111111111111111");
+
+    fix32_t x32 = FIX32_ZERO;
+    ufix64_t xu = UFIX64_ZERO;
+    fix64q16_t x16 = FIX64Q16_ZERO;
+    fail |= expect_int("fix32_from_str(\"40000\")", fix32_from_str("40000", 5, &x32), 5);
+    fail |= expect_int("fix32_from_str(\"40000\") value", x32.repr, INT32_MAX);
+    fail |= expect_int("fix32_from_str(\"-32768\") value", (fix32_from_str("-32768", 6, &x32), x32.repr),
+        INT32_MIN);
+    fail |= expect_int("fix32_from_str(\"0.00001\") value", (fix32_from_str("0.00001", 7, &x32), x32.repr), 1);
+    fail |= expect_int("ufix64_from_str(\"-1\") value", (int64_t)(ufix64_from_str("-1", 2, &xu), xu.repr), 0);
+    fail |= expect_int("ufix64_from_str(\"4294967295.9999999999\") value",
+        (int64_t)(ufix64_from_str("4294967295.9999999999", 21, &xu), xu.repr), -1);
+    fail |= expect_int("fix64q16_from_str(\"-140737488355328\") value",
+        (fix64q16_from_str("-140737488355328", 16, &x16), x16.repr), INT64_MIN);
+    fail |= expect_int("fix64q16_from_str(\"100000000000000.5\") value",
+        (fix64q16_from_str("100000000000000.5", 17, &x16), x16.repr),
+        INT64_C(100000000000000) * 65536 + 32768);
+    fail |= expect_int("fix64q16_from_str(\"x\")", fix64q16_from_str("x", 1, &x16), 0);
+    if (fail) {
+        return 1;
+    }
+
+    // fix32_t values are exact in fix64_t, so should format identically in every base
+    static const struct {
+        unsigned base;
+        int decimals;
+    } fmts[] = {
+        { FIX64_BASE_DECIMAL, 5 },
+        { FIX64_BASE_DECIMAL, -19 },
+        { FIX64_BASE_HEXADECIMAL, -4 },
+        { FIX64_BASE_OCTAL, 5 },
+        { FIX64_BASE_BINARY, 16 },
+    };
+    for (int i = 0; i < N; i++) {
+        fix32_t x = { (int32_t)rng_bits() };
+        for (size_t j = 0; j < sizeof(fmts) / sizeof(fmts[0]); j++) {
+            fix64_fmt_param_t fmt = { .base = fmts[j].base, .decimals = fmts[j].decimals };
+            char expected[128];
+            fix32_to_str_fmt(buf, x, sizeof(buf), fmt);
+            fix64_to_str_fmt(expected, fix64_from_fix32(x), sizeof(expected), fmt);
+            if (expect_str("fix32_to_str_fmt()", buf, expected)) {
+                return 1;
+            }
+        }
+
+        // 19 decimals are enough for the strings to round trip
+        fix64_fmt_param_t fmt = { .decimals = 19 };
+        size_t len = fix32_to_str_fmt(buf, x, sizeof(buf), fmt);
+        fix32_from_str(buf, len, &x32);
+        fail |= expect_int("fix32 string round trip", x32.repr, x.repr);
+
+        ufix64_t u = { rng_bits() };
+        len = ufix64_to_str_fmt(buf, u, sizeof(buf), fmt);
+        ufix64_from_str(buf, len, &xu);
+        fail |= expect_int("ufix64 string round trip", (int64_t)xu.repr, (int64_t)u.repr);
+
+        fix64q16_t y = { (int64_t)rng_bits() };
+        len = fix64q16_to_str_fmt(buf, y, sizeof(buf), fmt);
+        fix64q16_from_str(buf, len, &x16);
+        fail |= expect_int("fix64q16 string round trip", x16.repr, y.repr);
+        if (fail) {
+            printf("    for \"%s\"\n", buf);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int test_misc(void) {
+    int fail = 0;
+    fail |= expect_int("fix32_from_dbl(1.5)", fix32_from_dbl(1.5).repr, 0x18000);
+    fail |= expect_int("fix32_from_dbl(-1e10)", fix32_from_dbl(-1e10).repr, INT32_MIN);
+    fail |= expect_int("fix32_from_flt(1e10)", fix32_from_flt(1e10f).repr, INT32_MAX);
+    fail |= expect_int("ufix64_from_dbl(-3.0)", (int64_t)ufix64_from_dbl(-3.0).repr, 0);
+    fail |= expect_int("ufix64_from_dbl(1e20)", (int64_t)ufix64_from_dbl(1e20).repr, -1);
+    fail |= expect_int("fix64q16_from_dbl(-0x1p40)", fix64q16_from_dbl(-0x1p40).repr,
+        -(INT64_C(1) << 56));
+    fail |= expect_int("fix64q16_to_dbl()", (int64_t)fix64q16_to_dbl(FIX64Q16_C(-12345678.5)),
+        -12345678);
+    fail |= expect_int("fix32_to_int(-2.5)", fix32_to_int(FIX32_C(-2.5)), -3);
+    fail |= expect_int("fix32_to_uint(-2.5)", fix32_to_uint(FIX32_C(-2.5)), 0);
+    fail |= expect_int("fix64q16_to_int(2^40)", fix64q16_to_int(FIX64Q16_C(0x1p40)), INT_MAX);
+    fail |= expect_int("ufix64_to_int(3.75)", ufix64_to_int(UFIX64_C(3.75)), 3);
+    fail |= expect_int("fix32_from_int(40000)", fix32_from_int(40000).repr, INT32_MAX);
+    fail |= expect_int("fix32_from_int(-7)", fix32_from_int(-7).repr, -7 * 65536);
+    fail |= expect_int("fix32_from_uint(UINT_MAX)", fix32_from_uint(UINT_MAX).repr, INT32_MAX);
+    fail |= expect_int("ufix64_from_int(-5)", (int64_t)ufix64_from_int(-5).repr, 0);
+    fail |= expect_int("fix64q16_from_int(INT_MIN)", fix64q16_from_int(INT_MIN).repr,
+        (int64_t)INT_MIN * 65536);
+
+    fail |= expect_int("fix32_neg(FIX32_MIN)", fix32_neg(FIX32_MIN).repr, INT32_MAX);
+    fail |= expect_int("fix32_add(FIX32_MAX, FIX32_EPSILON)",
+        fix32_add(FIX32_MAX, FIX32_EPSILON).repr, INT32_MIN);
+    fail |= expect_int("fix32_div_sat(-1, 0)", fix32_div_sat(FIX32_C(-1), FIX32_ZERO).repr,
+        INT32_MIN);
+    fail |= expect_int("ufix64_sub_sat(1, 2)",
+        (int64_t)ufix64_sub_sat(UFIX64_ONE, UFIX64_TWO).repr, 0);
+    fail |= expect_int("ufix64_div_sat(1, 0)",
+        (int64_t)ufix64_div_sat(UFIX64_ONE, UFIX64_ZERO).repr, -1);
+    fail |= expect_int("fix64q16_add_sat(MAX, 1)",
+        fix64q16_add_sat(FIX64Q16_MAX, FIX64Q16_ONE).repr, INT64_MAX);
+
+    fail |= expect_int("fix32_floor(-1.5)", fix32_floor(FIX32_C(-1.5)).repr, -2 * 65536);
+    fail |= expect_int("fix32_ceil(-1.5)", fix32_ceil(FIX32_C(-1.5)).repr, -1 * 65536);
+    fail |= expect_int("fix32_round(-1.5)", fix32_round(FIX32_C(-1.5)).repr, -2 * 65536);
+    fail |= expect_int("fix32_trunc(-1.5)", fix32_trunc(FIX32_C(-1.5)).repr, -1 * 65536);
+    fail |= expect_int("ufix64_round(2.5)", (int64_t)ufix64_round(UFIX64_C(2.5)).repr,
+        INT64_C(3) << 32);
+    fail |= expect_int("fix64q16_abs(-2^40)", fix64q16_abs(FIX64Q16_C(-0x1p40)).repr,
+        INT64_C(1) << 56);
+    fail |= expect_int("ufix64_dim(1, 2)", (int64_t)ufix64_dim(UFIX64_ONE, UFIX64_TWO).repr, 0);
+
+    // The math functions are calculated with fix64_t, so are correct to within rounding
+    fail |= expect_int("fix32_sin(pi/2)", fix32_sin(FIX32_PI_2).repr, FIX32_ONE.repr);
+    fail |= expect_int("fix32_exp(1)", fix32_exp(FIX32_ONE).repr, FIX32_E.repr);
+    fail |= expect_int("fix32_log(e)", fix32_log(FIX32_E).repr, FIX32_ONE.repr);
+    fail |= expect_int("fix32_sqrt(2)", fix32_sqrt(FIX32_TWO).repr, FIX32_SQRT2.repr);
+    fail |= expect_int("fix32_pow(2, 10)", fix32_pow(FIX32_TWO, FIX32_C(10)).repr, 1024 * 65536);
+    return fail;
+}
+
+int main() {
+    if (test_fix32_arith()) {
+        return 1;
+    }
+#ifdef __SIZEOF_INT128__
+    if (test_wide_arith()) {
+        return 1;
+    }
+#endif
+    if (test_convert() || test_str() || test_misc()) {
+        return 1;
+    }
+    return 0;
+}
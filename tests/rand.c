@@ -0,0 +1,183 @@
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N 1000000
+
+// Exact conversion to long double, since a double doesn't have enough precision
+static long double to_ldbl(fix64_t arg) {
+    return ldexpl((long double)arg.repr, -FIX64_FRAC_BITS);
+}
+
+static int test_reference(void) {
+    // Reference outputs of xoshiro256** and SplitMix64
+    fix64_rng_t rng = { { 1, 2, 3, 4 } };
+    uint64_t expected[] = { UINT64_C(0x2d00), 0, UINT64_C(0x5a007080),
+        UINT64_C(0x10e0000000009d80) };
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        uint64_t result = fix64_rng_next(&rng);
+        if (result != expected[i]) {
+            printf("rng_next -> 0x%016" PRIx64 "; expected 0x%016" PRIx64 "\n", result,
+                expected[i]);
+            return 1;
+        }
+    }
+
+    fix64_rng_seed(&rng, 0);
+    if (rng.state[0] != UINT64_C(0xe220a8397b1dcdaf)) {
+        printf("rng_seed(0) -> 0x%016" PRIx64 "\n", rng.state[0]);
+        return 1;
+    }
+    return 0;
+}
+
+static int test_streams(void) {
+    fix64_rng_t rng, copy, stream, other;
+    fix64_rng_seed(&rng, 42);
+    copy = rng;
+
+    // The stream continues the generator's sequence, and the generator jumps
+    fix64_rng_split(&rng, &stream);
+    fix64_rng_split(&rng, &other);
+    fix64_rng_jump(&copy);
+    fix64_rng_jump(&copy);
+    for (int i = 0; i < 4; i++) {
+        if (rng.state[i] != copy.state[i]) {
+            printf("rng_split didn't jump the generator\n");
+            return 1;
+        }
+    }
+
+    fix64_rng_seed(&copy, 42);
+    int same = 0;
+    for (int i = 0; i < 1000; i++) {
+        uint64_t x = fix64_rng_next(&stream);
+        same += (x == fix64_rng_next(&other));
+        if (x != fix64_rng_next(&copy)) {
+            printf("rng_split stream doesn't continue the sequence\n");
+            return 1;
+        }
+    }
+    if (same > 0) {
+        printf("rng_split streams aren't independent\n");
+        return 1;
+    }
+    return 0;
+}
+
+// Checks the sample mean and variance, and the empirical CDF at a few points against cdf
+static int test_distribution(const char *name, const fix64_t *xs, long double mean,
+    long double var, long double (*cdf)(long double)) {
+    long double sum = 0, sum_sq = 0;
+    for (int i = 0; i < N; i++) {
+        long double x = to_ldbl(xs[i]);
+        sum += x;
+        sum_sq += x * x;
+    }
+    long double sample_mean = sum / N;
+    long double sample_var = sum_sq / N - sample_mean * sample_mean;
+    // Several standard errors, which are about sqrt(var / N) and var * sqrt(2 / N)
+    if (fabsl(sample_mean - mean) > 0.006L || fabsl(sample_var - var) > 0.01L) {
+        printf("%s: mean %.5Lf, variance %.5Lf; expected %.5Lf, %.5Lf\n", name, sample_mean,
+            sample_var, mean, var);
+        return 1;
+    }
+
+    for (long double t = -4; t <= 8; t += 0.25L) {
+        int below = 0;
+        for (int i = 0; i < N; i++) {
+            below += (to_ldbl(xs[i]) < t);
+        }
+        long double expected = cdf(t);
+        // Dvoretzky–Kiefer–Wolfowitz bound with a failure probability of about 1e-9
+        if (fabsl((long double)below / N - expected) > 0.0033L) {
+            printf("%s: P(x < %.2Lf) = %.5Lf; expected %.5Lf\n", name, t,
+                (long double)below / N, expected);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static long double uniform_cdf(long double x) {
+    return (x < 0) ? 0 : (x > 1) ? 1 : x;
+}
+
+static long double normal_cdf(long double x) {
+    return erfcl(-x / sqrtl(2)) / 2;
+}
+
+static long double exponential_cdf(long double x) {
+    return (x < 0) ? 0 : 1 - expl(-x);
+}
+
+int main() {
+    if (test_reference() || test_streams()) {
+        return 1;
+    }
+
+    static fix64_t xs[N];
+    fix64_rng_t rng, copy;
+    fix64_rng_seed(&rng, 1);
+
+    // Uniform, and the batch version gives the same sequence
+    copy = rng;
+    fix64_rng_uniform_batch(&rng, xs, N);
+    for (int i = 0; i < N; i++) {
+        fix64_t x = fix64_rng_uniform(&copy);
+        if (x.repr != xs[i].repr || x.repr < 0 || x.repr >= FIX64_ONE.repr) {
+            printf("rng_uniform -> %.10Lf\n", to_ldbl(x));
+            return 1;
+        }
+    }
+    if (test_distribution("rng_uniform", xs, 0.5L, 1 / 12.0L, uniform_cdf)) {
+        return 1;
+    }
+
+    for (int i = 0; i < N; i++) {
+        fix64_t lo = { (int64_t)fix64_rng_next(&rng) >> (fix64_rng_next(&rng) % 64) };
+        fix64_t hi = { (int64_t)fix64_rng_next(&rng) >> (fix64_rng_next(&rng) % 64) };
+        if (i == 0) {
+            lo = FIX64_MIN;
+            hi = FIX64_MAX;
+        }
+        if (lo.repr >= hi.repr) {
+            continue;
+        }
+        fix64_t x = fix64_rng_uniform_range(&rng, lo, hi);
+        if (x.repr < lo.repr || x.repr >= hi.repr) {
+            printf("rng_uniform_range(%.10Lf, %.10Lf) -> %.10Lf\n", to_ldbl(lo), to_ldbl(hi),
+                to_ldbl(x));
+            return 1;
+        }
+    }
+
+    copy = rng;
+    fix64_rng_normal_batch(&rng, xs, N);
+    for (int i = 0; i < N; i++) {
+        if (fix64_rng_normal(&copy).repr != xs[i].repr) {
+            printf("rng_normal_batch differs from rng_normal\n");
+            return 1;
+        }
+    }
+    if (test_distribution("rng_normal", xs, 0, 1, normal_cdf)) {
+        return 1;
+    }
+
+    copy = rng;
+    fix64_rng_exponential_batch(&rng, xs, N);
+    for (int i = 0; i < N; i++) {
+        if (fix64_rng_exponential(&copy).repr != xs[i].repr || xs[i].repr < 0) {
+            printf("rng_exponential_batch differs from rng_exponential\n");
+            return 1;
+        }
+    }
+    if (test_distribution("rng_exponential", xs, 1, 1, exponential_cdf)) {
+        return 1;
+    }
+    return 0;
+}
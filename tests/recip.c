@@ -0,0 +1,90 @@
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <fix64.h>
+#include <fix64/impl.h>
+
+#include "common.h"
+
+#define N 1000000
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 u128_t;
+#endif
+
+#ifdef __SIZEOF_INT128__
+static int test_recip_u64(void) {
+    for (int i = 0; i < N; i++) {
+        uint64_t d = rng() | (UINT64_C(1) << 63);
+        d = (i == 0) ? (UINT64_C(1) << 63) : (i == 1) ? UINT64_MAX : d;
+        // Divisors near the boundaries of the seed table's intervals
+        d = (i >= 2 && i < 514) ? ((UINT64_C(256) + i / 2) << 55) - (i & 1) : d;
+        d = (d >> 63) ? d : UINT64_C(1) << 63;
+
+        // The reciprocal is exact, i.e. floor((2^128 - 1) / d) - 2^64
+        uint64_t expected = (uint64_t)(~(u128_t)0 / d);
+        uint64_t v = fix64_impl_recip_u64(d);
+        if (v != expected) {
+            printf("fix64_impl_recip_u64(0x%016" PRIx64 ") = 0x%016" PRIx64, d, v);
+            printf(", expected 0x%016" PRIx64 "\n", expected);
+            return 1;
+        }
+    }
+    return 0;
+}
+#endif
+
+static int check(fix64_t x, fix64_t result) {
+    fix64_t expected = fix64_div_sat(FIX64_ONE, x);
+    if (result.repr != expected.repr) {
+        printf("fix64_recip(%" PRId64 ") = %" PRId64 ", expected %" PRId64 "\n", x.repr,
+            result.repr, expected.repr);
+        return 1;
+    }
+    return 0;
+}
+
+static int test_recip(void) {
+    const fix64_t edges[] = { FIX64_ZERO, FIX64_MIN, FIX64_MAX, FIX64_ONE, { -1 }, { 1 },
+        { -2 }, { 2 }, { -3 }, { 3 }, { INT64_MIN + 1 } };
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+        if (check(edges[i], fix64_recip(edges[i]))) {
+            return 1;
+        }
+    }
+
+    // All small values, where the results are largest
+    for (int64_t x = -100000; x <= 100000; x++) {
+        if (check((fix64_t){ x }, fix64_recip((fix64_t){ x }))) {
+            return 1;
+        }
+    }
+
+    // Random values with a random magnitude
+    static fix64_t xs[N], ys[N];
+    for (int i = 0; i < N; i++) {
+        xs[i] = rng_fix64(64);
+    }
+    fix64_recip_batch(xs, ys, N);
+    for (int i = 0; i < N; i++) {
+        if (check(xs[i], fix64_recip(xs[i]))) {
+            return 1;
+        } else if (ys[i].repr != fix64_recip(xs[i]).repr) {
+            printf("fix64_recip_batch differs at %" PRId64 "\n", xs[i].repr);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main() {
+#ifdef __SIZEOF_INT128__
+    if (test_recip_u64()) {
+        return 1;
+    }
+#endif
+    if (test_recip()) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N          4000
+#define MAX_WINDOW 100
+
+// Random values with a random magnitude, with runs of equal and extreme values
+static void fill(fix64_t *xs, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        xs[i] = rng_fix64(64);
+        if (i > 0 && rng() % 8 == 0) {
+            xs[i] = xs[i - 1];
+        } else if (rng() % 64 == 0) {
+            xs[i] = (rng() % 2) ? FIX64_MAX : FIX64_MIN;
+        }
+    }
+}
+
+// Exact conversion to long double, since a double doesn't have enough precision
+static long double to_ldbl(fix64_t arg) {
+    return ldexpl((long double)arg.repr, -FIX64_FRAC_BITS);
+}
+
+// The rolling statistics match the reductions over the same window
+static int test_rolling(const fix64_t *xs, size_t window) {
+    static fix64_t values[MAX_WINDOW];
+    static fix64_rolling_entry_t entries[FIX64_ROLLING_MINMAX_ENTRIES(MAX_WINDOW)];
+    fix64_rolling_t roll;
+    fix64_rolling_minmax_t minmax;
+    if (fix64_rolling_init(&roll, values, window) ||
+        fix64_rolling_minmax_init(&minmax, entries, window)) {
+        printf("window %zu: init failed\n", window);
+        return 1;
+    }
+
+    for (size_t i = 0; i < N; i++) {
+        if (i % 3 == 0) {
+            fix64_rolling_push(&roll, xs[i]);
+            fix64_rolling_minmax_push(&minmax, xs[i]);
+        } else {
+            // Blocks of one or two values
+            size_t count = (i + 1 < N && rng() % 2) ? 2 : 1;
+            fix64_rolling_push_block(&roll, xs + i, count);
+            fix64_rolling_minmax_push_block(&minmax, xs + i, count);
+            i += count - 1;
+        }
+
+        size_t n = (i + 1 < window) ? i + 1 : window;
+        const fix64_t *win = xs + i + 1 - n;
+        if (fix64_rolling_sum(&roll).repr != fix64_array_sum(win, n).repr ||
+            fix64_rolling_mean(&roll).repr != fix64_array_mean(win, n).repr ||
+            fix64_rolling_variance(&roll).repr != fix64_array_variance(win, n).repr ||
+            fix64_rolling_min(&minmax).repr != fix64_array_min(win, n).repr ||
+            fix64_rolling_max(&minmax).repr != fix64_array_max(win, n).repr) {
+            printf("window %zu: wrong results after %zu values\n", window, i + 1);
+            printf("sum %" PRId64 " (%" PRId64 "), mean %" PRId64 " (%" PRId64
+                   "), variance %" PRId64 " (%" PRId64 "), min %" PRId64 " (%" PRId64
+                   "), max %" PRId64 " (%" PRId64 ")\n",
+                fix64_rolling_sum(&roll).repr, fix64_array_sum(win, n).repr,
+                fix64_rolling_mean(&roll).repr, fix64_array_mean(win, n).repr,
+                fix64_rolling_variance(&roll).repr, fix64_array_variance(win, n).repr,
+                fix64_rolling_min(&minmax).repr, fix64_array_min(win, n).repr,
+                fix64_rolling_max(&minmax).repr, fix64_array_max(win, n).repr);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int test_ema(const fix64_t *xs, fix64_t alpha) {
+    static fix64_t out[N];
+    fix64_ema_t ema, block;
+    if (fix64_ema_init(&ema, alpha) || fix64_ema_init(&block, alpha)) {
+        printf("fix64_ema_init(%.10Lf) failed\n", to_ldbl(alpha));
+        return 1;
+    }
+    fix64_ema_push_block(&block, xs, out, N);
+
+    long double a = to_ldbl(alpha), expected = to_ldbl(xs[0]);
+    for (size_t i = 0; i < N; i++) {
+        expected = (i == 0) ? expected : a * to_ldbl(xs[i]) + (1 - a) * expected;
+        fix64_t result = fix64_ema_push(&ema, xs[i]);
+        // The average is kept with 32 extra fractional bits, so the error is at most a few ulps
+        if (result.repr != out[i].repr ||
+            fabsl(to_ldbl(result) - expected) > 4 * to_ldbl(FIX64_EPSILON)) {
+            printf("ema(%.10Lf) -> %.10Lf after %zu values; expected %.10Lf\n", a,
+                to_ldbl(result), i + 1, expected);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main() {
+    static fix64_t xs[N];
+    fill(xs, N);
+    size_t windows[] = { 1, 2, 3, 7, 16, 64, MAX_WINDOW };
+    for (size_t i = 0; i < sizeof(windows) / sizeof(windows[0]); i++) {
+        if (test_rolling(xs, windows[i])) {
+            return 1;
+        }
+    }
+
+    // Smaller values for the moving averages, so that long doubles are precise enough
+    for (size_t i = 0; i < N; i++) {
+        xs[i] = rng_fix64(44);
+    }
+    fix64_t alphas[] = { FIX64_ONE, FIX64_HALF, FIX64_C(0.1), FIX64_C(0.001), { 1 } };
+    for (size_t i = 0; i < sizeof(alphas) / sizeof(alphas[0]); i++) {
+        if (test_ema(xs, alphas[i])) {
+            return 1;
+        }
+    }
+
+    // A small alpha still converges to a constant exactly, and the span gives alpha = 2 / (n + 1)
+    fix64_ema_t ema;
+    fix64_ema_init_span(&ema, 1023);
+    fix64_ema_push(&ema, FIX64_ZERO);
+    fix64_t result = FIX64_ZERO;
+    for (int i = 0; i < 100000; i++) {
+        result = fix64_ema_push(&ema, FIX64_PI);
+    }
+    if (result.repr != FIX64_PI.repr || ema.decay != UINT64_MAX - (UINT64_MAX >> 9)) {
+        printf("ema with a span of 1023 -> %.10Lf\n", to_ldbl(result));
+        return 1;
+    }
+
+    if (fix64_ema_init(&ema, FIX64_ZERO) != -1 || fix64_ema_init(&ema, FIX64_C(1.5)) != -1 ||
+        fix64_ema_init_span(&ema, 0) != -1) {
+        printf("fix64_ema_init accepts invalid parameters\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N 200000
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 i128_t;
+#endif
+
+typedef enum { NEAREST, TRUNC, FLOOR, CEIL } round_mode_t;
+
+static const char *const mode_names[] = { "", "_trunc", "_floor", "_ceil" };
+
+static fix64_t (*const mul_fns[][2])(fix64_t, fix64_t) = {
+    { fix64_mul, fix64_mul_sat },
+    { fix64_mul_trunc, fix64_mul_trunc_sat },
+    { fix64_mul_floor, fix64_mul_floor_sat },
+    { fix64_mul_ceil, fix64_mul_ceil_sat },
+};
+
+static fix64_t (*const div_fns[][2])(fix64_t, fix64_t) = {
+    { fix64_div, fix64_div_sat },
+    { fix64_div_trunc, fix64_div_trunc_sat },
+    { fix64_div_floor, fix64_div_floor_sat },
+    { fix64_div_ceil, fix64_div_ceil_sat },
+};
+
+#ifdef __SIZEOF_INT128__
+// Rounds the exact quotient num / den to an integer
+static i128_t round_quot(i128_t num, i128_t den, round_mode_t mode) {
+    i128_t quot = num / den; // Truncates
+    i128_t rem = num % den;
+    if (rem == 0) {
+        return quot;
+    }
+    int positive = (rem < 0) == (den < 0);
+    switch (mode) {
+        case NEAREST: {
+            // Halfway values are rounded away from zero like fix64_div
+            i128_t abs_rem = (rem < 0) ? -rem : rem;
+            i128_t abs_den = (den < 0) ? -den : den;
+            return (2 * abs_rem >= abs_den) ? quot + (positive ? 1 : -1) : quot;
+        }
+        case TRUNC:
+            return quot;
+        case FLOOR:
+            return positive ? quot : quot - 1;
+        case CEIL:
+        default:
+            return positive ? quot + 1 : quot;
+    }
+}
+
+static int check(const char *op, round_mode_t mode, int sat, fix64_t x, fix64_t y, fix64_t result,
+    i128_t expected) {
+    if (sat) {
+        expected = (expected > INT64_MAX) ? INT64_MAX : expected;
+        expected = (expected < INT64_MIN) ? INT64_MIN : expected;
+    } else {
+        expected = (int64_t)(uint64_t)expected; // Wraps
+    }
+    if (result.repr != (int64_t)expected) {
+        printf("fix64_%s%s%s(%" PRId64 ", %" PRId64 ") = %" PRId64 ", expected %" PRId64 "\n",
+            op, mode_names[mode], sat ? "_sat" : "", x.repr, y.repr, result.repr,
+            (int64_t)expected);
+        return 1;
+    }
+    return 0;
+}
+
+static int test_mul(void) {
+    for (int i = 0; i < N; i++) {
+        fix64_t x = rng_fix64(64);
+        fix64_t y = rng_fix64(64);
+        if (i < 16) {
+            // Exact halfway values and products which are close to overflowing
+            x.repr = (i & 1) ? -3 : 3;
+            y.repr = (i & 2) ? -(FIX64_ONE.repr / 2) : FIX64_ONE.repr / 2;
+            if (i & 4) {
+                x = (i & 8) ? FIX64_MIN : FIX64_MAX;
+            }
+        }
+        i128_t product = (i128_t)x.repr * y.repr;
+        for (int mode = NEAREST; mode <= CEIL; mode++) {
+            // Halfway values are rounded up by fix64_mul
+            i128_t expected = (mode == NEAREST) ? (product + (INT64_C(1) << 31)) >> 32 :
+                                                  round_quot(product, (i128_t)1 << 32, mode);
+            for (int sat = 0; sat < 2; sat++) {
+                fix64_t result = mul_fns[mode][sat](x, y);
+                if (check("mul", mode, sat, x, y, result, expected)) {
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static int test_div(void) {
+    for (int i = 0; i < N; i++) {
+        fix64_t x = rng_fix64(64);
+        fix64_t y = rng_fix64(64);
+        if (i < 8) {
+            // Exact halfway values and quotients which overflow
+            x.repr = (i & 1) ? -3 : 3;
+            y.repr = (i & 2) ? -(INT64_C(2) << 32) : (INT64_C(2) << 32);
+            if (i & 4) {
+                x = FIX64_MAX;
+                y.repr = (i & 2) ? -1 : 1;
+            }
+        }
+        if (y.repr == 0) {
+            continue;
+        }
+        i128_t num = (i128_t)x.repr * ((i128_t)1 << 32);
+        for (int mode = NEAREST; mode <= CEIL; mode++) {
+            i128_t expected = round_quot(num, y.repr, mode);
+            for (int sat = 0; sat < 2; sat++) {
+                // Overflow isn't defined without saturation
+                if (!sat && (expected > INT64_MAX || expected < INT64_MIN)) {
+                    continue;
+                }
+                fix64_t result = div_fns[mode][sat](x, y);
+                if (check("div", mode, sat, x, y, result, expected)) {
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+#endif
+
+static int test_div_zero(void) {
+    fix64_t values[] = { FIX64_ZERO, FIX64_EPSILON, FIX64_ONE, FIX64_MAX, FIX64_MIN,
+        fix64_neg(FIX64_EPSILON) };
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        fix64_t expected = (values[i].repr < 0) ? FIX64_MIN : FIX64_MAX;
+        for (int mode = NEAREST; mode <= CEIL; mode++) {
+            fix64_t result = div_fns[mode][1](values[i], FIX64_ZERO);
+            if (result.repr != expected.repr) {
+                printf("fix64_div%s_sat(%" PRId64 ", 0) = %" PRId64 ", expected %" PRId64 "\n",
+                    mode_names[mode], values[i].repr, result.repr, expected.repr);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int main() {
+#ifdef __SIZEOF_INT128__
+    if (test_mul() || test_div()) {
+        return 1;
+    }
+#endif
+    if (test_div_zero()) {
+        return 1;
+    }
+    return 0;
+}
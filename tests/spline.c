@@ -0,0 +1,252 @@
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define MAX_POINTS 200
+#define N          4000
+
+typedef enum { NATURAL, MONOTONE, HERMITE } kind_t;
+
+static const char *const kind_names[] = { "natural", "monotone", "hermite" };
+
+// Exact conversion to long double, since a double doesn't have enough precision
+static long double to_ldbl(fix64_t arg) {
+    return ldexpl((long double)arg.repr, -FIX64_FRAC_BITS);
+}
+
+static int cmp_fix64(const void *lhs, const void *rhs) {
+    int64_t x = ((const fix64_t *)lhs)->repr, y = ((const fix64_t *)rhs)->repr;
+    return (x > y) - (x < y);
+}
+
+// Sorts xs and removes duplicates, returning the new count
+static size_t sort_unique(fix64_t *xs, size_t n) {
+    qsort(xs, n, sizeof(fix64_t), cmp_fix64);
+    size_t count = 1;
+    for (size_t i = 1; i < n; i++) {
+        if (xs[i].repr != xs[count - 1].repr) {
+            xs[count++] = xs[i];
+        }
+    }
+    return count;
+}
+
+// The slopes of the reference splines
+static void ref_slopes(kind_t kind, const fix64_t *xs, const fix64_t *ys, const fix64_t *slopes,
+    size_t n, long double *k) {
+    static long double h[MAX_POINTS], d[MAX_POINTS], c[MAX_POINTS], r[MAX_POINTS];
+    for (size_t i = 0; i + 1 < n; i++) {
+        h[i] = to_ldbl(xs[i + 1]) - to_ldbl(xs[i]);
+        d[i] = (to_ldbl(ys[i + 1]) - to_ldbl(ys[i])) / h[i];
+    }
+    if (kind == HERMITE || n == 1) {
+        for (size_t i = 0; i < n; i++) {
+            k[i] = (kind == HERMITE) ? to_ldbl(slopes[i]) : 0;
+        }
+    } else if (kind == MONOTONE) {
+        k[0] = d[0];
+        k[n - 1] = d[n - 2];
+        for (size_t i = 1; i + 1 < n; i++) {
+            long double a = fabsl(d[i - 1]), b = fabsl(d[i]);
+            k[i] = 0;
+            if (d[i - 1] * d[i] > 0) {
+                k[i] = fminl((a + b) / 2, 3 * fminl(a, b));
+                k[i] = (d[i] < 0) ? -k[i] : k[i];
+            }
+        }
+    } else {
+        // Thomas algorithm with both ends natural
+        c[0] = 0.5L;
+        r[0] = 1.5L * d[0];
+        for (size_t i = 1; i < n; i++) {
+            long double mu = 1, lambda = 0, rhs = d[i - 1];
+            if (i + 1 < n) {
+                mu = h[i] / (h[i - 1] + h[i]);
+                lambda = 1 - mu;
+                rhs = mu * d[i - 1] + lambda * d[i];
+            }
+            long double denom = 2 - mu * c[i - 1];
+            c[i] = lambda / denom;
+            r[i] = (3 * rhs - mu * r[i - 1]) / denom;
+        }
+        k[n - 1] = r[n - 1];
+        for (size_t i = n - 1; i-- > 0;) {
+            k[i] = r[i] - c[i] * k[i + 1];
+        }
+    }
+}
+
+// Evaluates the reference spline at x, also returning the magnitude of the segment's coefficients
+static long double ref_eval(const fix64_t *xs, const fix64_t *ys, const long double *k, size_t n,
+    fix64_t x, long double *scale) {
+    if (x.repr <= xs[0].repr) {
+        x = xs[0];
+    }
+    if (x.repr >= xs[n - 1].repr) {
+        *scale = fabsl(to_ldbl(ys[n - 1]));
+        return to_ldbl(ys[n - 1]);
+    }
+    size_t i = 0;
+    while (xs[i + 1].repr <= x.repr) {
+        i++;
+    }
+    long double h = to_ldbl(xs[i + 1]) - to_ldbl(xs[i]);
+    long double t = (to_ldbl(x) - to_ldbl(xs[i])) / h;
+    long double y0 = to_ldbl(ys[i]), dy = to_ldbl(ys[i + 1]) - y0;
+    long double m0 = k[i] * h, m1 = k[i + 1] * h;
+    long double c2 = 3 * dy - 2 * m0 - m1, c3 = -2 * dy + m0 + m1;
+    *scale = fabsl(y0) + fabsl(m0) + fabsl(c2) + fabsl(c3);
+    return y0 + t * (m0 + t * (c2 + t * c3));
+}
+
+static int init(kind_t kind, fix64_spline_t *spline, fix64_spline_segment_t *segments,
+    const fix64_t *xs, const fix64_t *ys, const fix64_t *slopes, size_t n) {
+    switch (kind) {
+        case NATURAL:
+            return fix64_spline_init_natural(spline, segments, xs, ys, n);
+        case MONOTONE:
+            return fix64_spline_init_monotone(spline, segments, xs, ys, n);
+        case HERMITE:
+        default:
+            return fix64_spline_init_hermite(spline, segments, xs, ys, slopes, n);
+    }
+}
+
+// Random splines checked against the long double reference
+static int test_random(kind_t kind) {
+    static fix64_t xs[MAX_POINTS], ys[MAX_POINTS], slopes[MAX_POINTS], queries[N], results[N];
+    static fix64_spline_segment_t segments[FIX64_SPLINE_SEGMENTS(MAX_POINTS)];
+    static long double k[MAX_POINTS];
+
+    for (int test = 0; test < 60; test++) {
+        size_t n = 1 + rng() % MAX_POINTS;
+        unsigned x_bits = 24 + (unsigned)(rng() % 33), y_bits = 16 + (unsigned)(rng() % 41);
+        for (size_t i = 0; i < n; i++) {
+            xs[i] = rng_fix64(x_bits);
+            ys[i] = rng_fix64(y_bits);
+            slopes[i] = rng_fix64(32);
+        }
+        n = sort_unique(xs, n);
+        if (kind == MONOTONE && test % 2) {
+            // Monotonic data, where the spline mustn't overshoot
+            n = sort_unique(ys, n);
+        }
+
+        fix64_spline_t spline;
+        if (init(kind, &spline, segments, xs, ys, slopes, n)) {
+            printf("fix64_spline_init_%s failed\n", kind_names[kind]);
+            return 1;
+        }
+        ref_slopes(kind, xs, ys, slopes, n, k);
+
+        // Random queries, including the breakpoints and values outside them, and then sorted
+        // queries for the batch search
+        for (size_t i = 0; i < N; i++) {
+            queries[i] = rng_fix64(x_bits + 1);
+            if (i < n) {
+                queries[i] = xs[i];
+            }
+        }
+        for (int sorted = 0; sorted < 2; sorted++) {
+            if (sorted) {
+                qsort(queries, N, sizeof(fix64_t), cmp_fix64);
+            }
+            fix64_spline_eval_batch(&spline, queries, results, N);
+            for (size_t i = 0; i < N; i++) {
+                fix64_t result = fix64_spline_eval(&spline, queries[i]);
+                if (result.repr != results[i].repr) {
+                    printf("fix64_spline_eval_batch differs from fix64_spline_eval\n");
+                    return 1;
+                }
+                // The values are exact if the coefficients have enough fractional bits
+                if (!sorted && i < n && segments[i].frac_bits >= FIX64_FRAC_BITS &&
+                    result.repr != ys[i].repr) {
+                    printf("%s spline isn't exact at breakpoint %zu\n", kind_names[kind], i);
+                    return 1;
+                }
+                long double scale;
+                long double expected = ref_eval(xs, ys, k, n, queries[i], &scale);
+                // Overshoot can be out of range, where the result saturates
+                expected = fminl(fmaxl(expected, to_ldbl(FIX64_MIN)), to_ldbl(FIX64_MAX));
+                long double tol = ldexpl(1, -FIX64_FRAC_BITS) + scale * 0x1p-58L;
+                if (fabsl(to_ldbl(result) - expected) > tol) {
+                    printf("%s spline at %.10Lf -> %.12Lf, expected %.12Lf\n", kind_names[kind],
+                        to_ldbl(queries[i]), to_ldbl(result), expected);
+                    return 1;
+                }
+                if (kind == MONOTONE && test % 2 && sorted && i > 0 &&
+                    results[i].repr < results[i - 1].repr - 1) {
+                    printf("monotone spline isn't monotonic at %.10Lf\n", to_ldbl(queries[i]));
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// Every kind of spline reproduces a straight line
+static int test_linear(void) {
+    static fix64_t xs[MAX_POINTS], ys[MAX_POINTS], slopes[MAX_POINTS];
+    static fix64_spline_segment_t segments[FIX64_SPLINE_SEGMENTS(MAX_POINTS)];
+    fix64_t slope = fix64_from_dbl(-2.75), offset = fix64_from_dbl(1234.5);
+    for (size_t i = 0; i < MAX_POINTS; i++) {
+        xs[i] = fix64_from_int((int32_t)(i * i) - 1000);
+        ys[i] = fix64_add(fix64_mul(slope, xs[i]), offset);
+        slopes[i] = slope;
+    }
+    for (kind_t kind = NATURAL; kind <= HERMITE; kind++) {
+        fix64_spline_t spline;
+        if (init(kind, &spline, segments, xs, ys, slopes, MAX_POINTS)) {
+            printf("fix64_spline_init_%s failed\n", kind_names[kind]);
+            return 1;
+        }
+        for (int i = 0; i < N; i++) {
+            // Between the first and last breakpoints
+            uint64_t range = (uint64_t)xs[MAX_POINTS - 1].repr - (uint64_t)xs[0].repr;
+            fix64_t x = { xs[0].repr + (int64_t)(rng() % range) };
+            fix64_t expected = fix64_add(fix64_mul(slope, x), offset);
+            fix64_t result = fix64_spline_eval(&spline, x);
+            if (llabs(result.repr - expected.repr) > 2) {
+                printf("%s spline of a line at %.10Lf -> %.12Lf, expected %.12Lf\n",
+                    kind_names[kind], to_ldbl(x), to_ldbl(result), to_ldbl(expected));
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static int test_invalid(void) {
+    fix64_t xs[2] = { FIX64_ONE, FIX64_ONE }, ys[2] = { FIX64_ZERO, FIX64_ONE };
+    fix64_t slopes[2] = { FIX64_MAX, FIX64_MAX };
+    fix64_spline_segment_t segments[FIX64_SPLINE_SEGMENTS(2)];
+    fix64_spline_t spline;
+    for (kind_t kind = NATURAL; kind <= HERMITE; kind++) {
+        if (init(kind, &spline, segments, xs, ys, slopes, 0) != -1 ||
+            init(kind, &spline, segments, xs, ys, slopes, 2) != -1) {
+            printf("fix64_spline_init_%s accepts invalid breakpoints\n", kind_names[kind]);
+            return 1;
+        }
+    }
+    // The derivative with respect to t is about 2^63, which is too large for the coefficients
+    xs[0] = FIX64_MIN;
+    xs[1] = FIX64_MAX;
+    if (fix64_spline_init_hermite(&spline, segments, xs, ys, slopes, 2) != -1) {
+        printf("fix64_spline_init_hermite accepts coefficients which are too large\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main() {
+    if (test_random(NATURAL) || test_random(MONOTONE) || test_random(HERMITE) || test_linear() ||
+        test_invalid()) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,208 @@
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N     1000
+#define TESTS 2000
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 i128_t;
+#endif
+
+// Exact conversion to long double, since a double doesn't have enough precision
+static long double to_ldbl(fix64_t arg) {
+    return ldexpl((long double)arg.repr, -FIX64_FRAC_BITS);
+}
+
+// Fills xs with random values, which are all small (so sums of squares fit in 128 bits) or have
+// random magnitudes. Some arrays are all equal or only contain extreme values
+static void fill(fix64_t *xs, size_t count, int test) {
+    unsigned max_bits = (test % 2) ? 40 : 64;
+    fix64_t centre = rng_fix64(64);
+    for (size_t i = 0; i < count; i++) {
+        xs[i] = rng_fix64(max_bits);
+        if (test % 7 == 0) {
+            xs[i] = (rng() % 2) ? FIX64_MAX : FIX64_MIN;
+        } else if (test % 11 == 0) {
+            xs[i] = centre;
+        } else if (test % 13 == 0) {
+            // Small spread around a large mean
+            xs[i].repr = (centre.repr >> 1) + (int64_t)(rng() % 1000);
+        }
+    }
+}
+
+#ifdef __SIZEOF_INT128__
+static int check(const char *name, int test, fix64_t result, i128_t expected) {
+    expected = (expected > INT64_MAX) ? INT64_MAX : expected;
+    expected = (expected < INT64_MIN) ? INT64_MIN : expected;
+    if (result.repr != (int64_t)expected) {
+        printf("test %d: fix64_array_%s -> %" PRId64 "; expected %" PRId64 "\n", test, name,
+            result.repr, (int64_t)expected);
+        return 1;
+    }
+    return 0;
+}
+
+// floor(num / den) for den > 0
+static i128_t floor_div(i128_t num, i128_t den) {
+    i128_t quot = num / den;
+    return (quot * den > num) ? quot - 1 : quot;
+}
+
+static int test_exact(const fix64_t *xs, size_t n, int test) {
+    i128_t sum = 0, abs_sum = 0;
+    int64_t min = INT64_MAX, max = INT64_MIN;
+    size_t argmin = 0, argmax = 0;
+    for (size_t i = 0; i < n; i++) {
+        int64_t x = xs[i].repr;
+        sum += x;
+        abs_sum += (x < 0) ? -(i128_t)x : x;
+        if (x < min) {
+            min = x;
+            argmin = i;
+        }
+        if (x > max) {
+            max = x;
+            argmax = i;
+        }
+    }
+    // Halfway values are rounded away from zero
+    i128_t abs_mean = (((sum < 0) ? -sum : sum) * 2 + (i128_t)n) / (2 * (i128_t)n);
+    i128_t mean = (sum < 0) ? -abs_mean : abs_mean;
+
+    if (check("sum", test, fix64_array_sum(xs, n), sum) ||
+        check("mean", test, fix64_array_mean(xs, n), mean) ||
+        check("min", test, fix64_array_min(xs, n), min) ||
+        check("max", test, fix64_array_max(xs, n), max) ||
+        check("norm1", test, fix64_array_norm1(xs, n), abs_sum)) {
+        return 1;
+    }
+    if (fix64_array_argmin(xs, n) != argmin || fix64_array_argmax(xs, n) != argmax) {
+        printf("test %d: fix64_argmin or fix64_array_argmax is wrong\n", test);
+        return 1;
+    }
+
+    fix128_t wide = fix64_array_sum_fix128(xs, n);
+    if (wide.hi != (int64_t)(sum >> 32) || wide.lo != (uint64_t)sum << 32) {
+        printf("test %d: fix64_array_sum_fix128 is wrong\n", test);
+        return 1;
+    }
+
+    if ((i128_t)max - min >= ((i128_t)1 << 41)) {
+        return 0;
+    }
+    // The variance is (n * sum(x^2) - sum^2) / n^2, which fits in 128 bits relative to the minimum
+    i128_t sum_d = 0, sum_d2 = 0;
+    for (size_t i = 0; i < n; i++) {
+        i128_t d = (i128_t)xs[i].repr - min;
+        sum_d += d;
+        sum_d2 += d * d;
+    }
+    i128_t den = (i128_t)n * (i128_t)n << 32;
+    i128_t var = floor_div(sum_d2 * (i128_t)n - sum_d * sum_d + den / 2, den);
+    if (check("variance", test, fix64_array_variance(xs, n), var)) {
+        return 1;
+    }
+
+    if (max >= (INT64_C(1) << 41) || min <= -(INT64_C(1) << 41)) {
+        return 0;
+    }
+    i128_t sum_sq = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum_sq += (i128_t)xs[i].repr * xs[i].repr;
+    }
+    i128_t root = (i128_t)sqrtl((long double)sum_sq);
+    while (root * root > sum_sq) {
+        root--;
+    }
+    while ((root + 1) * (root + 1) <= sum_sq) {
+        root++;
+    }
+    root += (sum_sq - root * root > root);
+    return check("norm2", test, fix64_array_norm2(xs, n), root);
+}
+#endif
+
+// Checks the variance and L2 norm against long double, for values too large for test_exact
+static int test_approx(const fix64_t *xs, size_t n, int test) {
+    long double mean = 0, sum_sq = 0, var = 0;
+    for (size_t i = 0; i < n; i++) {
+        mean += to_ldbl(xs[i]);
+        sum_sq += to_ldbl(xs[i]) * to_ldbl(xs[i]);
+    }
+    mean /= n;
+    for (size_t i = 0; i < n; i++) {
+        var += (to_ldbl(xs[i]) - mean) * (to_ldbl(xs[i]) - mean);
+    }
+    var /= n;
+
+    fix64_t expected_var = fix64_from_ldbl(var);
+    fix64_t expected_norm = fix64_from_ldbl(sqrtl(sum_sq));
+    fix64_t result_var = fix64_array_variance(xs, n);
+    fix64_t result_norm = fix64_array_norm2(xs, n);
+    if (!approx_eq(result_var, expected_var) || !approx_eq(result_norm, expected_norm)) {
+        printf("test %d: fix64_array_variance -> %.10Lf, fix64_array_norm2 -> %.10Lf; "
+               "expected %.10Lf, %.10Lf\n",
+            test, to_ldbl(result_var), to_ldbl(result_norm), var, sqrtl(sum_sq));
+        return 1;
+    }
+    return 0;
+}
+
+// The results don't depend on the order of the elements, and partial sums can be combined
+static int test_order(fix64_t *xs, size_t n, int test) {
+    fix64_t sum = fix64_array_sum(xs, n), mean = fix64_array_mean(xs, n);
+    fix64_t var = fix64_array_variance(xs, n);
+    fix64_t norm1 = fix64_array_norm1(xs, n), norm2 = fix64_array_norm2(xs, n);
+    fix128_t wide = fix64_array_sum_fix128(xs, n);
+
+    for (size_t i = n - 1; i > 0; i--) {
+        size_t j = rng() % (i + 1);
+        fix64_t tmp = xs[i];
+        xs[i] = xs[j];
+        xs[j] = tmp;
+    }
+    size_t split = rng() % (n + 1);
+    fix128_t parts = fix128_add(
+        fix64_array_sum_fix128(xs, split), fix64_array_sum_fix128(xs + split, n - split));
+
+    if (fix64_array_sum(xs, n).repr != sum.repr || fix64_array_mean(xs, n).repr != mean.repr ||
+        fix64_array_variance(xs, n).repr != var.repr ||
+        fix64_array_norm1(xs, n).repr != norm1.repr ||
+        fix64_array_norm2(xs, n).repr != norm2.repr || fix128_neq(parts, wide)) {
+        printf("test %d: the results depend on the order of the elements\n", test);
+        return 1;
+    }
+    return 0;
+}
+
+int main() {
+    static fix64_t xs[N];
+    for (int test = 0; test < TESTS; test++) {
+        size_t n = 1 + rng() % N;
+        fill(xs, n, test);
+#ifdef __SIZEOF_INT128__
+        if (test_exact(xs, n, test)) {
+            return 1;
+        }
+#endif
+        if (test_approx(xs, n, test) || test_order(xs, n, test)) {
+            return 1;
+        }
+    }
+
+    // Empty arrays
+    if (fix64_array_sum(xs, 0).repr != 0 || fix64_array_mean(xs, 0).repr != 0 ||
+        fix64_array_variance(xs, 0).repr != 0 || fix64_array_norm1(xs, 0).repr != 0 ||
+        fix64_array_norm2(xs, 0).repr != 0 || fix64_array_min(xs, 0).repr != FIX64_MAX.repr ||
+        fix64_array_max(xs, 0).repr != FIX64_MIN.repr || fix64_array_argmin(xs, 0) != 0) {
+        printf("empty arrays give the wrong results\n");
+        return 1;
+    }
+    return 0;
+}
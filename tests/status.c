@@ -0,0 +1,124 @@
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N 100000
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 i128_t;
+#endif
+
+static int test_scalar(void) {
+    for (int i = 0; i < N; i++) {
+        fix64_t x = rng_fix64(64);
+        fix64_t y = rng_fix64(64);
+        if (i < 4) {
+            // Results which only just overflow
+            x = (i & 1) ? FIX64_MIN : FIX64_MAX;
+            y = (i & 2) ? FIX64_EPSILON : fix64_neg(FIX64_EPSILON);
+        }
+
+        // The overflow is checked against the saturating versions, which have their own tests
+        fix64_status_t status = 0;
+        fix64_t sum = fix64_add_ovf(x, y, &status);
+        int overflow = fix64_add_sat(x, y).repr != sum.repr;
+        if (sum.repr != fix64_add(x, y).repr || status != (overflow ? FIX64_STATUS_OVERFLOW : 0)) {
+            printf("fix64_add_ovf(%" PRId64 ", %" PRId64 ") = %" PRId64 ", status %u\n", x.repr,
+                y.repr, sum.repr, status);
+            return 1;
+        }
+
+        status = 0;
+        fix64_t diff = fix64_sub_ovf(x, y, &status);
+        overflow = fix64_sub_sat(x, y).repr != diff.repr;
+        if (diff.repr != fix64_sub(x, y).repr || status != (overflow ? FIX64_STATUS_OVERFLOW : 0)) {
+            printf("fix64_sub_ovf(%" PRId64 ", %" PRId64 ") = %" PRId64 ", status %u\n", x.repr,
+                y.repr, diff.repr, status);
+            return 1;
+        }
+
+#ifdef __SIZEOF_INT128__
+        status = 0;
+        fix64_t product = fix64_mul_ovf(x, y, &status);
+        i128_t exact = ((i128_t)x.repr * y.repr + (INT64_C(1) << 31)) >> 32;
+        overflow = exact > INT64_MAX || exact < INT64_MIN;
+        if (product.repr != fix64_mul(x, y).repr ||
+            status != (overflow ? FIX64_STATUS_OVERFLOW : 0)) {
+            printf("fix64_mul_ovf(%" PRId64 ", %" PRId64 ") = %" PRId64 ", status %u\n", x.repr,
+                y.repr, product.repr, status);
+            return 1;
+        }
+#endif
+    }
+    return 0;
+}
+
+static int test_sticky(void) {
+    fix64_status_t status = 0;
+    fix64_add_ovf(FIX64_MAX, FIX64_ONE, &status);
+    fix64_add_ovf(FIX64_ONE, FIX64_ONE, &status);
+    fix64_mul_ovf(FIX64_ONE, FIX64_ONE, &status);
+    if (status != FIX64_STATUS_OVERFLOW) {
+        printf("the status isn't sticky\n");
+        return 1;
+    }
+    return 0;
+}
+
+static int test_batch(void) {
+    static fix64_t xs[64], ys[64], out[64];
+    for (int i = 0; i < N / 64; i++) {
+        // Values below 2^-2 can't overflow, so only some of the batches overflow
+        unsigned shift = (i % 2) ? 0 : 34;
+        for (int j = 0; j < 64; j++) {
+            xs[j].repr = (int64_t)rng();
+            xs[j].repr >>= shift + rng() % 16;
+            ys[j].repr = (int64_t)rng();
+            ys[j].repr >>= shift + rng() % 16;
+        }
+
+        fix64_status_t expected[3] = { 0, 0, 0 };
+        for (int j = 0; j < 64; j++) {
+            fix64_add_ovf(xs[j], ys[j], &expected[0]);
+            fix64_sub_ovf(xs[j], ys[j], &expected[1]);
+            fix64_mul_ovf(xs[j], ys[j], &expected[2]);
+        }
+
+        static const char *const names[3] = { "add", "sub", "mul" };
+        for (int op = 0; op < 3; op++) {
+            fix64_status_t status = 0;
+            if (op == 0) {
+                fix64_add_ovf_batch(xs, ys, out, 64, &status);
+            } else if (op == 1) {
+                fix64_sub_ovf_batch(xs, ys, out, 64, &status);
+            } else {
+                fix64_mul_ovf_batch(xs, ys, out, 64, &status);
+            }
+            for (int j = 0; j < 64; j++) {
+                fix64_t value = (op == 0) ? fix64_add(xs[j], ys[j]) :
+                    (op == 1)             ? fix64_sub(xs[j], ys[j]) :
+                                            fix64_mul(xs[j], ys[j]);
+                if (out[j].repr != value.repr) {
+                    printf("fix64_%s_ovf_batch differs at %d (iteration %d)\n", names[op], j, i);
+                    return 1;
+                }
+            }
+            if (status != expected[op]) {
+                printf("fix64_%s_ovf_batch status %u, expected %u (iteration %d)\n", names[op],
+                    status, expected[op], i);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int main() {
+    if (test_scalar() || test_sticky() || test_batch()) {
+        return 1;
+    }
+    return 0;
+}
@@ -55,6 +55,15 @@ int main() {
         {"-5", FIX64_C(-5), { .base = FIX64_BASE_DECIMAL, .space_sign = 1, .plus_sign = 1 }},
         {"+0B01111111111111111111111111111111.11111111111111111111111111111111", FIX64_MAX, { .base = FIX64_BASE_BINARY, .decimals = -100, .width = 68, .pad_0 = 1, .base_pfx = 1, .plus_sign = 1, .uppercase = 1 }},
         {"-0b10000000000000000000000000000000.00000000000000000000000000000000", FIX64_MIN, { .base = FIX64_BASE_BINARY, .decimals = 100, .base_pfx = 1, .space_sign = 1 }},
+        {"2147483647.999999999767169356", FIX64_MAX, { .base = FIX64_BASE_DECIMAL, .decimals = 18 }},
+        {"2147483648.0000000", FIX64_MAX, { .base = FIX64_BASE_DECIMAL, .decimals = 7 }},
+        {"-2147483648.0000000000000000000", FIX64_MIN, { .base = FIX64_BASE_DECIMAL, .decimals = 100 }},
+        {"0.0000000002328306437", FIX64_EPSILON, { .base = FIX64_BASE_DECIMAL, .decimals = 19 }},
+        {"0.9999999899882823229", { INT64_C(4294967253) }, { .base = FIX64_BASE_DECIMAL, .decimals = 19 }},
+        {"1.0000000", { INT64_C(4294967253) }, { .base = FIX64_BASE_DECIMAL, .decimals = 7 }},
+        {"1234567890.12345679", FIX64_C(1234567890.123456789), { .base = FIX64_BASE_DECIMAL, .decimals = 8 }},
+        {"1234567890.1234567889478058", FIX64_C(1234567890.123456789), { .base = FIX64_BASE_DECIMAL, .decimals = 16 }},
+        {"1234567890.1", FIX64_C(1234567890.123456789), { .base = FIX64_BASE_DECIMAL, .decimals = -1 }},
     };
     const int len = 96;
     const int off = 16;
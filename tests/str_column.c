@@ -0,0 +1,84 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+int main() {
+    const char csv[] =
+        "time,value,label\n"
+        "0,1.5,a\n"
+        "1,-2.25,b\r\n"
+        "2,,c\n"
+        "3,abc,d\n"
+        "4\n"
+        "5,3.,e\n"
+        "\n"
+        "6,2147483648,f\n"
+        "7,-0.125";
+
+    fix64_t exp_values[] = {
+        FIX64_ZERO, FIX64_C(1.5), FIX64_C(-2.25), FIX64_ZERO, FIX64_ZERO, FIX64_ZERO, FIX64_C(3),
+        FIX64_ZERO, FIX64_MAX, FIX64_C(-0.125),
+    };
+    unsigned char exp_status[] = {
+        FIX64_PARSE_INVALID, FIX64_PARSE_OK, FIX64_PARSE_OK, FIX64_PARSE_EMPTY, FIX64_PARSE_INVALID,
+        FIX64_PARSE_EMPTY, FIX64_PARSE_OK, FIX64_PARSE_EMPTY, FIX64_PARSE_OK, FIX64_PARSE_OK,
+    };
+    const size_t exp_rows = sizeof(exp_values) / sizeof(exp_values[0]);
+    const size_t size = sizeof(csv) - 1;
+
+    fix64_t values[16];
+    unsigned char status[16];
+    size_t consumed;
+    size_t rows = fix64_from_str_column(values, status, 16, csv, size, ',', 1, &consumed);
+
+    if (rows != exp_rows || consumed != size) {
+        printf("fix64_from_str_column(...) -> %zu rows, %zu consumed; expected %zu, %zu\n",
+            rows, consumed, exp_rows, size);
+        return 1;
+    }
+    for (size_t i = 0; i < rows; i++) {
+        if (status[i] != exp_status[i] || !fix64_eq(values[i], exp_values[i])) {
+            printf("row %zu -> %d, %.10f; expected %d, %.10f\n", i, status[i],
+                fix64_to_dbl(values[i]), exp_status[i], fix64_to_dbl(exp_values[i]));
+            return 1;
+        }
+    }
+
+    // Parsing in chunks split at line boundaries must give the same results
+    fix64_t chunk_values[16];
+    unsigned char chunk_status[16];
+    for (size_t n_chunks = 1; n_chunks <= 8; n_chunks++) {
+        size_t total = 0;
+        size_t start = 0;
+        for (size_t i = 1; i <= n_chunks; i++) {
+            size_t stop = (i == n_chunks) ? size : fix64_str_next_line(csv, size, i * size / n_chunks);
+            if (stop < start) {
+                stop = start;
+            }
+            total += fix64_from_str_column(&chunk_values[total], &chunk_status[total], 16 - total,
+                csv + start, stop - start, ',', 1, NULL);
+            start = stop;
+        }
+
+        if (total != exp_rows || memcmp(chunk_status, status, rows) ||
+            memcmp(chunk_values, values, rows * sizeof(values[0]))) {
+            printf("parsing in %zu chunks gave %zu rows; expected %zu identical rows\n",
+                n_chunks, total, exp_rows);
+            return 1;
+        }
+    }
+
+    // Stops once count rows are written, and can continue from where it stopped
+    rows = fix64_from_str_column(values, NULL, 3, csv, size, ',', 1, &consumed);
+    if (rows != 3 || strncmp(csv + consumed, "2,,c\n", 5)) {
+        printf("fix64_from_str_column(..., count = 3, ...) -> %zu rows, %zu consumed; expected 3, %zu\n",
+            rows, consumed, (size_t)(strstr(csv, "2,,c") - csv));
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+static const long double PI_L = 3.141592653589793238462643383279502884L;
+
+// Exact conversion to long double, since a double doesn't have enough precision
+static long double to_ldbl(fix64_t arg) {
+    return ldexpl((long double)arg.repr, -FIX64_FRAC_BITS);
+}
+
+static int check(const char *name, fix64_t arg, fix64_t result, long double expected) {
+    if (!approx_eq(result, fix64_from_ldbl(expected))) {
+        printf("%s(%.12Lf) -> %.12Lf; expected %.12Lf\n", name, to_ldbl(arg), to_ldbl(result),
+            expected);
+        return 1;
+    }
+    return 0;
+}
+
+// Checks the functions of an angle in units where a full circle is full_circle
+static int test_range(const char *suffix, fix64_t (*sin_fn)(fix64_t), fix64_t (*cos_fn)(fix64_t),
+    void (*sincos_fn)(fix64_t, fix64_t *, fix64_t *), fix64_t (*tan_fn)(fix64_t),
+    long double full_circle) {
+    char names[3][16];
+    snprintf(names[0], sizeof(names[0]), "sin%s", suffix);
+    snprintf(names[1], sizeof(names[1]), "cos%s", suffix);
+    snprintf(names[2], sizeof(names[2]), "tan%s", suffix);
+
+    long double start = -2 * full_circle;
+    long double stop = 2 * full_circle;
+    long double step = (stop - start) / 1e6L;
+    for (long double fltarg = start; fltarg <= stop; fltarg += step) {
+        fix64_t arg = fix64_from_ldbl(fltarg);
+        long double radians = to_ldbl(arg) * 2 * PI_L / full_circle;
+
+        fix64_t sin_result, cos_result;
+        sincos_fn(arg, &sin_result, &cos_result);
+        if (sin_result.repr != sin_fn(arg).repr || cos_result.repr != cos_fn(arg).repr) {
+            printf("sincos%s(%.12Lf) differs from sin and cos\n", suffix, to_ldbl(arg));
+            return 1;
+        }
+        if (check(names[0], arg, sin_result, sinl(radians)) ||
+            check(names[1], arg, cos_result, cosl(radians))) {
+            return 1;
+        }
+
+        // Error increases near discontinuities
+        if (fabsl(cosl(radians)) > 1e-9L && check(names[2], arg, tan_fn(arg), tanl(radians))) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Checks that the functions repeat exactly every full circle
+static int test_periodic(const char *suffix, fix64_t (*sin_fn)(fix64_t),
+    fix64_t (*cos_fn)(fix64_t), fix64_t (*tan_fn)(fix64_t), int64_t full_circle) {
+    for (int i = 0; i < 100000; i++) {
+        fix64_t arg = { (int64_t)(rng() % (uint64_t)full_circle) };
+        int64_t max_circles = INT64_MAX / full_circle;
+        int64_t circles = (int64_t)(rng() % (uint64_t)(2 * max_circles)) - max_circles;
+        fix64_t shifted = { arg.repr + circles * full_circle };
+
+        if (sin_fn(arg).repr != sin_fn(shifted).repr || cos_fn(arg).repr != cos_fn(shifted).repr ||
+            tan_fn(arg).repr != tan_fn(shifted).repr) {
+            printf("%s functions of %.12Lf and %.12Lf differ\n", suffix, to_ldbl(arg),
+                to_ldbl(shifted));
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main() {
+    if (test_range("_turns", fix64_sin_turns, fix64_cos_turns, fix64_sincos_turns,
+            fix64_tan_turns, 1) ||
+        test_range("_deg", fix64_sin_deg, fix64_cos_deg, fix64_sincos_deg, fix64_tan_deg, 360) ||
+        test_periodic("_turns", fix64_sin_turns, fix64_cos_turns, fix64_tan_turns,
+            FIX64_ONE.repr) ||
+        test_periodic("_deg", fix64_sin_deg, fix64_cos_deg, fix64_tan_deg,
+            fix64_from_int(360).repr)) {
+        return 1;
+    }
+
+    // Exact values at multiples of 30 and 45 degrees
+    if (fix64_sin_deg(FIX64_C(30.0)).repr != FIX64_HALF.repr ||
+        fix64_cos_deg(FIX64_C(60.0)).repr != FIX64_HALF.repr ||
+        fix64_sin_turns(FIX64_C(0.25)).repr != FIX64_ONE.repr ||
+        fix64_cos_turns(FIX64_C(0.25)).repr != 0 ||
+        fix64_sin_turns(FIX64_C(-0.5)).repr != 0 ||
+        fix64_tan_deg(FIX64_C(45.0)).repr != FIX64_ONE.repr ||
+        fix64_tan_turns(FIX64_C(-0.125)).repr != -FIX64_ONE.repr) {
+        printf("inexact results at multiples of 30 or 45 degrees\n");
+        return 1;
+    }
+
+    // Angles on an octant boundary, where the polynomials are evaluated at exactly 1.0
+    for (int i = -16; i <= 16; i++) {
+        fix64_t turns = { (int64_t)i << (FIX64_FRAC_BITS - 3) };
+        long double radians = to_ldbl(turns) * 2 * PI_L;
+        if (check("sin_turns", turns, fix64_sin_turns(turns), sinl(radians)) ||
+            check("cos_turns", turns, fix64_cos_turns(turns), cosl(radians)) ||
+            (i % 4 != 0 && i % 2 == 0 &&
+                check("tan_turns", turns, fix64_tan_turns(turns), tanl(radians)))) {
+            return 1;
+        }
+    }
+
+    // tan saturates exactly on the singularities
+    if (fix64_tan_turns(FIX64_C(0.25)).repr != FIX64_MAX.repr ||
+        fix64_tan_turns(FIX64_C(-0.25)).repr != FIX64_MAX.repr ||
+        fix64_tan_deg(FIX64_C(90.0)).repr != FIX64_MAX.repr) {
+        printf("tan_turns doesn't saturate at its singularities\n");
+        return 1;
+    }
+
+    // sincos gives the same results as sin and cos in radians too
+    for (int i = 0; i < 100000; i++) {
+        fix64_t angle = rng_fix64(64);
+        fix64_t sin_result, cos_result;
+        fix64_sincos(angle, &sin_result, &cos_result);
+        if (sin_result.repr != fix64_sin(angle).repr || cos_result.repr != fix64_cos(angle).repr) {
+            printf("sincos(%.12Lf) differs from sin and cos\n", to_ldbl(angle));
+            return 1;
+        }
+    }
+    return 0;
+}
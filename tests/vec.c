@@ -0,0 +1,338 @@
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N 100000
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 i128_t;
+__extension__ typedef unsigned __int128 u128_t;
+#endif
+
+static fix64_vec4_t rng_vec4(void) {
+    fix64_t x = rng_fix64(64), y = rng_fix64(64), z = rng_fix64(64), w = rng_fix64(64);
+    return fix64_vec4_make(x, y, z, w);
+}
+
+static int expect_fix64(const char *name, int i, fix64_t value, fix64_t expected) {
+    if (value.repr != expected.repr) {
+        printf("%s (iteration %d) -> 0x%016" PRIx64 "; expected 0x%016" PRIx64 "\n", name, i,
+            (uint64_t)value.repr, (uint64_t)expected.repr);
+        return 1;
+    }
+    return 0;
+}
+
+#ifdef __SIZEOF_INT128__
+// Sum of the products lhs[i] * rhs[i] * sign[i] rounded like fix64_mul, wrapping on overflow
+static fix64_t ref_sum(const fix64_t *lhs, const fix64_t *rhs, const int *sign, int n) {
+    u128_t sum = (u128_t)1 << (FIX64_FRAC_BITS - 1);
+    for (int i = 0; i < n; i++) {
+        u128_t prod = (u128_t)((i128_t)lhs[i].repr * rhs[i].repr);
+        sum = (sign[i] < 0) ? sum - prod : sum + prod;
+    }
+    return (fix64_t){ (int64_t)(uint64_t)((i128_t)sum >> FIX64_FRAC_BITS) };
+}
+
+static int test_products(void) {
+    static const int plus[4] = { 1, 1, 1, 1 };
+    static const int cross[2] = { 1, -1 };
+    for (int i = 0; i < N; i++) {
+        fix64_vec4_t a = rng_vec4();
+        fix64_vec4_t b = rng_vec4();
+        fix64_t al[4] = { a.x, a.y, a.z, a.w };
+        fix64_t bl[4] = { b.x, b.y, b.z, b.w };
+        int fail = 0;
+
+        fail |= expect_fix64("fix64_vec2_dot", i,
+            fix64_vec2_dot(fix64_vec2_make(a.x, a.y), fix64_vec2_make(b.x, b.y)),
+            ref_sum(al, bl, plus, 2));
+        fail |= expect_fix64("fix64_vec3_dot", i,
+            fix64_vec3_dot(fix64_vec3_make(a.x, a.y, a.z), fix64_vec3_make(b.x, b.y, b.z)),
+            ref_sum(al, bl, plus, 3));
+        fail |= expect_fix64("fix64_vec4_dot", i, fix64_vec4_dot(a, b), ref_sum(al, bl, plus, 4));
+
+        fix64_vec3_t c = fix64_vec3_cross(
+            fix64_vec3_make(a.x, a.y, a.z), fix64_vec3_make(b.x, b.y, b.z));
+        fix64_t cx_l[2] = { a.y, a.z }, cx_r[2] = { b.z, b.y };
+        fix64_t cy_l[2] = { a.z, a.x }, cy_r[2] = { b.x, b.z };
+        fix64_t cz_l[2] = { a.x, a.y }, cz_r[2] = { b.y, b.x };
+        fail |= expect_fix64("fix64_vec3_cross.x", i, c.x, ref_sum(cx_l, cx_r, cross, 2));
+        fail |= expect_fix64("fix64_vec3_cross.y", i, c.y, ref_sum(cy_l, cy_r, cross, 2));
+        fail |= expect_fix64("fix64_vec3_cross.z", i, c.z, ref_sum(cz_l, cz_r, cross, 2));
+
+        fix64_quat_t q = fix64_quat_mul(
+            fix64_quat_make(a.w, a.x, a.y, a.z), fix64_quat_make(b.w, b.x, b.y, b.z));
+        fix64_t qw_l[4] = { a.w, a.x, a.y, a.z }, qw_r[4] = { b.w, b.x, b.y, b.z };
+        fix64_t qx_l[4] = { a.w, a.x, a.y, a.z }, qx_r[4] = { b.x, b.w, b.z, b.y };
+        fix64_t qy_l[4] = { a.w, a.x, a.y, a.z }, qy_r[4] = { b.y, b.z, b.w, b.x };
+        fix64_t qz_l[4] = { a.w, a.x, a.y, a.z }, qz_r[4] = { b.z, b.y, b.x, b.w };
+        const int qw_s[4] = { 1, -1, -1, -1 }, qx_s[4] = { 1, 1, 1, -1 };
+        const int qy_s[4] = { 1, -1, 1, 1 }, qz_s[4] = { 1, 1, -1, 1 };
+        fail |= expect_fix64("fix64_quat_mul.w", i, q.w, ref_sum(qw_l, qw_r, qw_s, 4));
+        fail |= expect_fix64("fix64_quat_mul.x", i, q.x, ref_sum(qx_l, qx_r, qx_s, 4));
+        fail |= expect_fix64("fix64_quat_mul.y", i, q.y, ref_sum(qy_l, qy_r, qy_s, 4));
+        fail |= expect_fix64("fix64_quat_mul.z", i, q.z, ref_sum(qz_l, qz_r, qz_s, 4));
+
+        if (fail) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int test_matrices(void) {
+    static const int plus[4] = { 1, 1, 1, 1 };
+    for (int i = 0; i < N / 10; i++) {
+        fix64_mat4_t a, b;
+        fix64_mat3_t a3, b3;
+        for (int r = 0; r < 4; r++) {
+            for (int c = 0; c < 4; c++) {
+                a.m[r][c] = rng_fix64(64);
+                b.m[r][c] = rng_fix64(64);
+                if (r < 3 && c < 3) {
+                    a3.m[r][c] = a.m[r][c];
+                    b3.m[r][c] = b.m[r][c];
+                }
+            }
+        }
+        fix64_vec4_t v = rng_vec4();
+        fix64_t vl[4] = { v.x, v.y, v.z, v.w };
+
+        fix64_mat4_t prod = fix64_mat4_mul(&a, &b);
+        fix64_mat3_t prod3 = fix64_mat3_mul(&a3, &b3);
+        fix64_mat4_t bt = fix64_mat4_transpose(b);
+        fix64_mat3_t bt3 = fix64_mat3_transpose(b3);
+        fix64_vec4_t av = fix64_mat4_mul_vec4(&a, v);
+        fix64_vec3_t av3 = fix64_mat3_mul_vec3(&a3, fix64_vec3_make(v.x, v.y, v.z));
+        fix64_vec3_t ap = fix64_mat4_mul_point3(&a, fix64_vec3_make(v.x, v.y, v.z));
+        fix64_t avl[4] = { av.x, av.y, av.z, av.w };
+        fix64_t av3l[3] = { av3.x, av3.y, av3.z };
+        fix64_t apl[3] = { ap.x, ap.y, ap.z };
+
+        int fail = 0;
+        for (int r = 0; r < 4; r++) {
+            for (int c = 0; c < 4; c++) {
+                fail |= expect_fix64(
+                    "fix64_mat4_mul", i, prod.m[r][c], ref_sum(a.m[r], bt.m[c], plus, 4));
+                if (r < 3 && c < 3) {
+                    fail |= expect_fix64(
+                        "fix64_mat3_mul", i, prod3.m[r][c], ref_sum(a3.m[r], bt3.m[c], plus, 3));
+                }
+            }
+            fail |= expect_fix64("fix64_mat4_mul_vec4", i, avl[r], ref_sum(a.m[r], vl, plus, 4));
+            if (r < 3) {
+                fix64_t pl[4] = { v.x, v.y, v.z, FIX64_ONE };
+                fail |= expect_fix64(
+                    "fix64_mat3_mul_vec3", i, av3l[r], ref_sum(a3.m[r], vl, plus, 3));
+                fail |= expect_fix64(
+                    "fix64_mat4_mul_point3", i, apl[r], ref_sum(a.m[r], pl, plus, 4));
+            }
+        }
+        if (fail) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Checks that the length is correctly rounded, see tests/fft.c
+static int check_length(const char *name, int i, const fix64_t *comp, int n, fix64_t length) {
+    u128_t norm = 0;
+    int overflow = 0;
+    for (int j = 0; j < n; j++) {
+        u128_t sq = (u128_t)((i128_t)comp[j].repr * comp[j].repr);
+        overflow |= (norm + sq < norm);
+        norm += sq;
+    }
+    int fail;
+    if (length.repr != INT64_MAX) {
+        u128_t r = (u128_t)length.repr;
+        fail = overflow || !((r == 0 || r * r - r < norm) && norm <= r * r + r);
+    } else {
+        fail = !overflow && (norm < ((u128_t)INT64_MAX * INT64_MAX));
+    }
+    if (fail) {
+        printf("%s (iteration %d) -> 0x%016" PRIx64 "\n", name, i, (uint64_t)length.repr);
+    }
+    return fail;
+}
+
+static int test_length(void) {
+    for (int i = 0; i < N; i++) {
+        fix64_vec4_t v = rng_vec4();
+        if (i == 0) {
+            v = fix64_vec4_make(FIX64_MIN, FIX64_MIN, FIX64_MIN, FIX64_MIN);
+        }
+        fix64_t comp[4] = { v.x, v.y, v.z, v.w };
+        if (check_length("fix64_vec2_length", i, comp, 2,
+                fix64_vec2_length(fix64_vec2_make(v.x, v.y))) ||
+            check_length("fix64_vec3_length", i, comp, 3,
+                fix64_vec3_length(fix64_vec3_make(v.x, v.y, v.z))) ||
+            check_length("fix64_vec4_length", i, comp, 4, fix64_vec4_length(v))) {
+            return 1;
+        }
+    }
+    return 0;
+}
+#endif
+
+// Checks that each component of result is within 1 epsilon of comp / |comp|
+static int check_normalize(const char *name, int i, const fix64_t *comp, const fix64_t *result,
+    int n) {
+    long double norm = 0;
+    for (int j = 0; j < n; j++) {
+        long double c = (long double)comp[j].repr;
+        norm += c * c;
+    }
+    for (int j = 0; j < n; j++) {
+        long double expected =
+            (norm == 0) ? comp[j].repr : ldexpl(comp[j].repr / sqrtl(norm), FIX64_FRAC_BITS);
+        if (fabsl((long double)result[j].repr - expected) > 1) {
+            printf("%s (iteration %d) component %d -> 0x%016" PRIx64 "; expected %.3Lf\n", name, i,
+                j, (uint64_t)result[j].repr, expected);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int test_normalize(void) {
+    for (int i = 0; i < N; i++) {
+        fix64_vec4_t v = rng_vec4();
+        if (i == 0) {
+            v = fix64_vec4_make(FIX64_ZERO, FIX64_ZERO, FIX64_ZERO, FIX64_ZERO);
+        } else if (i == 1) {
+            v = fix64_vec4_make(FIX64_MIN, FIX64_MIN, FIX64_MIN, FIX64_MIN);
+        } else if (i < 64) {
+            // Tiny vectors
+            fix64_t tiny[4];
+            for (int j = 0; j < 4; j++) {
+                tiny[j].repr = (int64_t)(rng() % 5) - 2;
+            }
+            v = fix64_vec4_make(tiny[0], tiny[1], tiny[2], tiny[3]);
+        }
+        fix64_t comp[4] = { v.x, v.y, v.z, v.w };
+
+        fix64_vec2_t n2 = fix64_vec2_normalize(fix64_vec2_make(v.x, v.y));
+        fix64_vec3_t n3 = fix64_vec3_normalize(fix64_vec3_make(v.x, v.y, v.z));
+        fix64_vec4_t n4 = fix64_vec4_normalize(v);
+        fix64_quat_t nq = fix64_quat_normalize(fix64_quat_make(v.x, v.y, v.z, v.w));
+        fix64_t r2[2] = { n2.x, n2.y };
+        fix64_t r3[3] = { n3.x, n3.y, n3.z };
+        fix64_t r4[4] = { n4.x, n4.y, n4.z, n4.w };
+        fix64_t rq[4] = { nq.w, nq.x, nq.y, nq.z };
+        if (check_normalize("fix64_vec2_normalize", i, comp, r2, 2) ||
+            check_normalize("fix64_vec3_normalize", i, comp, r3, 3) ||
+            check_normalize("fix64_vec4_normalize", i, comp, r4, 4) ||
+            check_normalize("fix64_quat_normalize", i, comp, rq, 4)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int test_rotation(void) {
+    fix64_mat3_t identity = fix64_quat_to_mat3(fix64_quat_identity());
+    fix64_mat3_t expected_identity = fix64_mat3_identity();
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 3; c++) {
+            if (expect_fix64("fix64_quat_to_mat3(identity)", 0, identity.m[r][c],
+                    expected_identity.m[r][c])) {
+                return 1;
+            }
+        }
+    }
+
+    static fix64_t xs[N / 10], ys[N / 10], zs[N / 10];
+    fix64_vec3_t points[N / 10];
+    for (int i = 0; i < N / 10; i++) {
+        // Vectors with components up to 2^20 in magnitude
+        fix64_t qc[4], vc[3];
+        for (int j = 0; j < 4; j++) {
+            qc[j].repr = (int64_t)rng() >> 32;
+        }
+        for (int j = 0; j < 3; j++) {
+            vc[j].repr = (int64_t)rng() >> 12;
+        }
+        fix64_quat_t q = fix64_quat_normalize(fix64_quat_make(qc[0], qc[1], qc[2], qc[3]));
+        fix64_vec3_t v = fix64_vec3_make(vc[0], vc[1], vc[2]);
+        fix64_vec3_t rotated = fix64_quat_rotate(q, v);
+
+        // q * v * conj(q) in long double
+        long double w = fix64_to_dbl(q.w), x = fix64_to_dbl(q.x), y = fix64_to_dbl(q.y),
+                    z = fix64_to_dbl(q.z);
+        long double vx = fix64_to_dbl(v.x), vy = fix64_to_dbl(v.y), vz = fix64_to_dbl(v.z);
+        long double ex = (1 - 2 * (y * y + z * z)) * vx + 2 * (x * y - w * z) * vy +
+            2 * (x * z + w * y) * vz;
+        long double ey = 2 * (x * y + w * z) * vx + (1 - 2 * (x * x + z * z)) * vy +
+            2 * (y * z - w * x) * vz;
+        long double ez = 2 * (x * z - w * y) * vx + 2 * (y * z + w * x) * vy +
+            (1 - 2 * (x * x + y * y)) * vz;
+
+        // The matrix elements are only accurate to about an epsilon, which is multiplied by the
+        // vector's components
+        long double tol = ldexpl(8 * (1 + 3 * ldexpl(1, 20)), -FIX64_FRAC_BITS);
+        if (fabsl(fix64_to_dbl(rotated.x) - ex) > tol ||
+            fabsl(fix64_to_dbl(rotated.y) - ey) > tol ||
+            fabsl(fix64_to_dbl(rotated.z) - ez) > tol) {
+            printf("fix64_quat_rotate (iteration %d) -> (%f, %f, %f); expected (%Lf, %Lf, %Lf)\n",
+                i, fix64_to_dbl(rotated.x), fix64_to_dbl(rotated.y), fix64_to_dbl(rotated.z), ex,
+                ey, ez);
+            return 1;
+        }
+
+        xs[i] = v.x;
+        ys[i] = v.y;
+        zs[i] = v.z;
+        points[i] = v;
+    }
+
+    // The batch transforms must give identical results to transforming each vector
+    fix64_mat4_t m;
+    for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 4; c++) {
+            m.m[r][c] = (fix64_t){ (int64_t)rng() >> 24 };
+        }
+    }
+    fix64_t qc[4];
+    for (int i = 0; i < 4; i++) {
+        qc[i] = rng_fix64(64);
+    }
+    fix64_mat3_t m3 =
+        fix64_quat_to_mat3(fix64_quat_normalize(fix64_quat_make(qc[0], qc[1], qc[2], qc[3])));
+    fix64_mat4_transform_soa(&m, xs, ys, zs, N / 10);
+    for (int i = 0; i < N / 10; i++) {
+        fix64_vec3_t expected = fix64_mat4_mul_point3(&m, points[i]);
+        if (!fix64_vec3_eq(expected, fix64_vec3_make(xs[i], ys[i], zs[i]))) {
+            printf("fix64_mat4_transform_soa differs at element %d\n", i);
+            return 1;
+        }
+        points[i] = fix64_vec3_make(xs[i], ys[i], zs[i]);
+    }
+    fix64_mat3_transform_soa(&m3, xs, ys, zs, N / 10);
+    for (int i = 0; i < N / 10; i++) {
+        fix64_vec3_t expected = fix64_mat3_mul_vec3(&m3, points[i]);
+        if (!fix64_vec3_eq(expected, fix64_vec3_make(xs[i], ys[i], zs[i]))) {
+            printf("fix64_mat3_transform_soa differs at element %d\n", i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main() {
+#ifdef __SIZEOF_INT128__
+    if (test_products() || test_matrices() || test_length()) {
+        return 1;
+    }
+#endif
+    if (test_normalize() || test_rotation()) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+
+#include <fix64.h>
+
+#include "common.h"
+
+#define N 200000
+
+// Maximum error in FIX64_EPSILON, from the rounding of the constants and the result
+#define MAX_ERROR 2
+
+static const long double PI_L = 3.141592653589793238462643383279502884L;
+
+// Exact conversion to long double, since a double doesn't have enough precision
+static long double to_ldbl(fix64_t arg) {
+    return ldexpl((long double)arg.repr, -FIX64_FRAC_BITS);
+}
+
+// Checks that result is in [lo, hi) and within MAX_ERROR of angle modulo 2pi, where [lo, hi) is
+// the rounded version of [lo_exact, lo_exact + 2pi)
+static int check(const char *name, fix64_t angle, fix64_t result, long double lo, fix64_t lo_fix,
+    fix64_t hi_fix) {
+    long double exact = fmodl(to_ldbl(angle) - lo, 2 * PI_L);
+    exact += (exact < 0) ? 2 * PI_L : 0;
+    long double diff = fabsl(to_ldbl(result) - lo - exact);
+    // The exact result may be on the other side of the wrap
+    diff = fminl(diff, 2 * PI_L - diff);
+
+    if (fix64_lt(result, lo_fix) || fix64_gte(result, hi_fix) ||
+        diff > ldexpl(MAX_ERROR, -FIX64_FRAC_BITS)) {
+        printf("%s(%.12Lf) -> %.12Lf; expected %.12Lf\n", name, to_ldbl(angle),
+            to_ldbl(result), exact + lo);
+        return 1;
+    }
+    return 0;
+}
+
+int main() {
+    static fix64_t angles[N], wrapped_pi[N], wrapped_2pi[N];
+    for (int i = 0; i < N; i++) {
+        // Random magnitudes, and every FIX64_EPSILON around multiples of pi
+        angles[i] = rng_fix64(64);
+        if (i < N / 4) {
+            int64_t multiple = (i / 64) - (N / 512);
+            angles[i] = fix64_add(fix64_mul(FIX64_PI, fix64_from_int(multiple)),
+                (fix64_t){ (i % 64) - 32 });
+        }
+    }
+    angles[0] = FIX64_MIN;
+    angles[1] = FIX64_MAX;
+    angles[2] = FIX64_ZERO;
+    angles[3] = FIX64_PI;
+    angles[4] = fix64_neg(FIX64_PI);
+
+    fix64_wrap_pi_batch(angles, wrapped_pi, N);
+    fix64_wrap_2pi_batch(angles, wrapped_2pi, N);
+
+    for (int i = 0; i < N; i++) {
+        fix64_t result_pi = fix64_wrap_pi(angles[i]);
+        fix64_t result_2pi = fix64_wrap_2pi(angles[i]);
+        if (check("wrap_pi", angles[i], result_pi, -PI_L, fix64_neg(FIX64_PI), FIX64_PI) ||
+            check("wrap_2pi", angles[i], result_2pi, 0, FIX64_ZERO, FIX64_C(6.283185307179586))) {
+            return 1;
+        }
+        if (result_pi.repr != wrapped_pi[i].repr || result_2pi.repr != wrapped_2pi[i].repr) {
+            printf("wrap_pi_batch or wrap_2pi_batch differ for %.12Lf\n", to_ldbl(angles[i]));
+            return 1;
+        }
+    }
+    return 0;
+}